@@ -0,0 +1,135 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Suite 500,
+ * Boston, MA 02110-1335, USA.
+ */
+
+/*
+ * Runtime instruction set detection for the SIMD kernels of every plugin.
+ *
+ * Kernels are compiled with per-function target attributes and selected at
+ * runtime from CPUID, so no special compiler flags are needed. Each plugin's
+ * kernel getters take a GstSimdLevel, elements passing gst_simd_get_level()
+ * and tests or benchmarks passing every level up to it.
+ */
+
+#ifndef _SIMD_LEVEL_H_
+#define _SIMD_LEVEL_H_
+
+#include <glib.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define HAVE_X86_SIMD 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+
+/* instruction sets from slowest to fastest, each implying the ones before */
+typedef enum
+{
+  GST_SIMD_NONE,
+  GST_SIMD_SSSE3,
+  GST_SIMD_SSE41,
+  GST_SIMD_AVX2
+} GstSimdLevel;
+
+#define GST_SIMD_N_LEVELS (GST_SIMD_AVX2 + 1)
+
+static inline GstSimdLevel
+gst_simd_detect_level (void)
+{
+#if defined(HAVE_X86_SIMD) && defined(_MSC_VER)
+  int info[4];
+  int max_leaf;
+  gboolean avx2 = FALSE;
+
+  __cpuid (info, 0);
+  max_leaf = info[0];
+
+  __cpuid (info, 1);
+
+  /* AVX needs OSXSAVE and the OS saving YMM state */
+  if (max_leaf >= 7 && (info[2] & (1 << 27)) && (info[2] & (1 << 28)) &&
+      (_xgetbv (0) & 0x6) == 0x6) {
+    int info7[4];
+    __cpuidex (info7, 7, 0);
+    avx2 = (info7[1] & (1 << 5)) != 0;
+  }
+
+  if (avx2)
+    return GST_SIMD_AVX2;
+  if (info[2] & (1 << 19))
+    return GST_SIMD_SSE41;
+  if (info[2] & (1 << 9))
+    return GST_SIMD_SSSE3;
+  return GST_SIMD_NONE;
+#elif defined(HAVE_X86_SIMD)
+  __builtin_cpu_init ();
+  if (__builtin_cpu_supports ("avx2"))
+    return GST_SIMD_AVX2;
+  if (__builtin_cpu_supports ("sse4.1"))
+    return GST_SIMD_SSE41;
+  if (__builtin_cpu_supports ("ssse3"))
+    return GST_SIMD_SSSE3;
+  return GST_SIMD_NONE;
+#else
+  return GST_SIMD_NONE;
+#endif
+}
+
+/* the fastest instruction set this CPU supports, detected once */
+static inline GstSimdLevel
+gst_simd_get_level (void)
+{
+  static gsize level = 0;
+
+  if (g_once_init_enter (&level)) {
+    /* g_once_init_leave doesn't accept zero */
+    g_once_init_leave (&level, gst_simd_detect_level () + 1);
+  }
+
+  return (GstSimdLevel) (level - 1);
+}
+
+/* name of an instruction set, for logging */
+static inline const gchar *
+gst_simd_get_name (GstSimdLevel level)
+{
+  switch (level) {
+    case GST_SIMD_AVX2:
+      return "AVX2";
+    case GST_SIMD_SSE41:
+      return "SSE4.1";
+    case GST_SIMD_SSSE3:
+      return "SSSE3";
+    default:
+      return "none";
+  }
+}
+
+#endif /* _SIMD_LEVEL_H_ */
@@ -0,0 +1,173 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Suite 500,
+ * Boston, MA 02110-1335, USA.
+ */
+
+/*
+ * Persistent worker pool for splitting a frame into horizontal stripes.
+ *
+ * The pool owns n_threads - 1 exclusive threads that live as long as the
+ * pool, so nothing is created per frame. gst_stripe_pool_run() hands stripe
+ * 0 to the calling (streaming) thread and the others to the workers, and
+ * returns once every stripe has finished.
+ */
+
+#ifndef _STRIPE_POOL_H_
+#define _STRIPE_POOL_H_
+
+#include <glib.h>
+
+typedef void (*GstStripeFunc) (gpointer user_data, guint stripe,
+    guint n_stripes);
+
+typedef struct
+{
+  GThreadPool *threads;
+  guint n_threads;
+  guint *stripes;
+
+  GMutex lock;
+  GCond cond;
+  guint pending;
+
+  GstStripeFunc func;
+  gpointer user_data;
+} GstStripePool;
+
+static inline void
+gst_stripe_pool_worker (gpointer data, gpointer pool_data)
+{
+  GstStripePool *pool = (GstStripePool *) pool_data;
+  guint stripe = *(guint *) data;
+
+  pool->func (pool->user_data, stripe, pool->n_threads);
+
+  g_mutex_lock (&pool->lock);
+  if (--pool->pending == 0)
+    g_cond_signal (&pool->cond);
+  g_mutex_unlock (&pool->lock);
+}
+
+/* n_threads of 0 uses one thread per processor */
+static inline GstStripePool *
+gst_stripe_pool_new (guint n_threads)
+{
+  GstStripePool *pool = g_new0 (GstStripePool, 1);
+  guint i;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  g_mutex_init (&pool->lock);
+  g_cond_init (&pool->cond);
+
+  if (n_threads > 1) {
+    GError *error = NULL;
+    pool->threads = g_thread_pool_new (gst_stripe_pool_worker, pool,
+        n_threads - 1, TRUE, &error);
+    if (!pool->threads) {
+      g_warning ("Failed to create stripe pool threads: %s", error->message);
+      g_clear_error (&error);
+      n_threads = 1;
+    }
+  }
+
+  pool->n_threads = n_threads;
+  pool->stripes = g_new (guint, n_threads);
+  for (i = 0; i < n_threads; ++i)
+    pool->stripes[i] = i;
+
+  return pool;
+}
+
+static inline void
+gst_stripe_pool_free (GstStripePool * pool)
+{
+  if (!pool)
+    return;
+
+  if (pool->threads)
+    g_thread_pool_free (pool->threads, FALSE, TRUE);
+  g_free (pool->stripes);
+  g_mutex_clear (&pool->lock);
+  g_cond_clear (&pool->cond);
+  g_free (pool);
+}
+
+/* (re)create *pool with n_threads (0 for one per processor) unless it already
+ * has that many, returning TRUE if a new pool was made; call on caps change
+ * rather than per frame */
+static inline gboolean
+gst_stripe_pool_ensure (GstStripePool ** pool, guint n_threads)
+{
+  guint wanted = n_threads ? n_threads : g_get_num_processors ();
+
+  if (*pool && (*pool)->n_threads == wanted)
+    return FALSE;
+
+  gst_stripe_pool_free (*pool);
+  *pool = gst_stripe_pool_new (n_threads);
+  return TRUE;
+}
+
+/* the "n-threads" property of every element processing through a pool, to
+ * be passed to gst_stripe_pool_ensure() */
+#define GST_STRIPE_POOL_PARAM_SPEC_N_THREADS(default_value) \
+    g_param_spec_uint ("n-threads", "Number of threads", \
+        "Number of threads processing horizontal stripes of each frame, " \
+        "takes effect on caps change (0 uses one per processor)", \
+        0, G_MAXINT, default_value, \
+        G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | \
+        GST_PARAM_MUTABLE_READY)
+
+/* call func for each stripe in parallel, blocking until all are done */
+static inline void
+gst_stripe_pool_run (GstStripePool * pool, GstStripeFunc func,
+    gpointer user_data)
+{
+  guint i;
+
+  if (pool->n_threads == 1) {
+    func (user_data, 0, 1);
+    return;
+  }
+
+  pool->func = func;
+  pool->user_data = user_data;
+  pool->pending = pool->n_threads - 1;
+
+  for (i = 1; i < pool->n_threads; ++i)
+    g_thread_pool_push (pool->threads, &pool->stripes[i], NULL);
+
+  func (user_data, 0, pool->n_threads);
+
+  g_mutex_lock (&pool->lock);
+  while (pool->pending > 0)
+    g_cond_wait (&pool->cond, &pool->lock);
+  g_mutex_unlock (&pool->lock);
+}
+
+/* split rows [0, height) evenly, returning the range for one stripe */
+static inline void
+gst_stripe_get_rows (guint stripe, guint n_stripes, gint height,
+    gint * row_start, gint * row_end)
+{
+  *row_start = (gint) ((gint64) height * stripe / n_stripes);
+  *row_end = (gint) ((gint64) height * (stripe + 1) / n_stripes);
+}
+
+#endif /* _STRIPE_POOL_H_ */
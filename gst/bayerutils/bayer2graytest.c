@@ -0,0 +1,201 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Check test for bayer2gray.
+ *
+ * Relabelling Bayer as gray should move no pixels: the output buffer must
+ * reference the same GstMemory as the input, carrying a gray video meta
+ * when the input rows are padded and downstream accepts one, and only fall
+ * back to copying rows when downstream needs the default layout.
+ */
+
+#include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
+#include <gst/video/video.h>
+
+#include "gstbayer2gray.h"
+
+#define WIDTH 64
+#define HEIGHT 48
+/* a row stride wider than the default gray one */
+#define PADDED_STRIDE 80
+
+#define BAYER8_CAPS "video/x-bayer, format = (string) rggb, " \
+    "width = (int) 64, height = (int) 48, framerate = (fraction) 30/1"
+
+static GstHarness *
+setup_bayer2gray (gboolean downstream_video_meta)
+{
+  GstHarness *h;
+
+  h = gst_harness_new ("bayer2gray");
+  if (downstream_video_meta)
+    gst_harness_add_propose_allocation_meta (h, GST_VIDEO_META_API_TYPE,
+        NULL);
+  gst_harness_set_src_caps_str (h, BAYER8_CAPS);
+
+  return h;
+}
+
+/* a Bayer frame with each row filled with its index, described by a video
+ * meta when the stride isn't the default one */
+static GstBuffer *
+create_bayer_buffer (gint stride)
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  gint y;
+
+  buf = gst_buffer_new_allocate (NULL, (gsize) stride * HEIGHT, NULL);
+  fail_unless (gst_buffer_map (buf, &map, GST_MAP_WRITE));
+  for (y = 0; y < HEIGHT; y++)
+    memset (map.data + y * stride, y, stride);
+  gst_buffer_unmap (buf, &map);
+
+  if (stride != GST_ROUND_UP_4 (WIDTH)) {
+    gsize offsets[GST_VIDEO_MAX_PLANES] = { 0, };
+    gint strides[GST_VIDEO_MAX_PLANES] = { stride, };
+
+    gst_buffer_add_video_meta_full (buf, GST_VIDEO_FRAME_FLAG_NONE,
+        GST_VIDEO_FORMAT_GRAY8, WIDTH, HEIGHT, 1, offsets, strides);
+  }
+
+  return buf;
+}
+
+static void
+check_gray_caps (GstHarness * h)
+{
+  GstCaps *caps;
+  GstVideoInfo info;
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_video_info_from_caps (&info, caps));
+  fail_unless_equals_int (GST_VIDEO_INFO_FORMAT (&info),
+      GST_VIDEO_FORMAT_GRAY8);
+  fail_unless_equals_int (GST_VIDEO_INFO_WIDTH (&info), WIDTH);
+  fail_unless_equals_int (GST_VIDEO_INFO_HEIGHT (&info), HEIGHT);
+  gst_caps_unref (caps);
+}
+
+GST_START_TEST (test_shares_memory)
+{
+  GstHarness *h = setup_bayer2gray (FALSE);
+  GstBuffer *inbuf, *outbuf;
+
+  inbuf = create_bayer_buffer (GST_ROUND_UP_4 (WIDTH));
+  outbuf = gst_harness_push_and_pull (h, gst_buffer_ref (inbuf));
+  fail_unless (outbuf != NULL);
+  check_gray_caps (h);
+
+  fail_unless (outbuf != inbuf);
+  fail_unless_equals_int (gst_buffer_n_memory (outbuf),
+      gst_buffer_n_memory (inbuf));
+  fail_unless (gst_buffer_peek_memory (outbuf, 0) ==
+      gst_buffer_peek_memory (inbuf, 0));
+
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_shares_memory_with_video_meta)
+{
+  GstHarness *h = setup_bayer2gray (TRUE);
+  GstBuffer *inbuf, *outbuf;
+  GstVideoMeta *meta;
+
+  inbuf = create_bayer_buffer (PADDED_STRIDE);
+  outbuf = gst_harness_push_and_pull (h, gst_buffer_ref (inbuf));
+  fail_unless (outbuf != NULL);
+  check_gray_caps (h);
+
+  fail_unless (gst_buffer_peek_memory (outbuf, 0) ==
+      gst_buffer_peek_memory (inbuf, 0));
+
+  /* the padded rows are described to downstream as gray */
+  meta = gst_buffer_get_video_meta (outbuf);
+  fail_unless (meta != NULL);
+  fail_unless_equals_int (meta->format, GST_VIDEO_FORMAT_GRAY8);
+  fail_unless_equals_int (meta->width, WIDTH);
+  fail_unless_equals_int (meta->height, HEIGHT);
+  fail_unless_equals_int (meta->stride[0], PADDED_STRIDE);
+  fail_unless_equals_int (meta->offset[0], 0);
+
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_copies_without_video_meta)
+{
+  GstHarness *h = setup_bayer2gray (FALSE);
+  GstBuffer *inbuf, *outbuf;
+  GstMapInfo map;
+  gint x, y;
+
+  inbuf = create_bayer_buffer (PADDED_STRIDE);
+  outbuf = gst_harness_push_and_pull (h, gst_buffer_ref (inbuf));
+  fail_unless (outbuf != NULL);
+
+  /* downstream can't read padded rows, so they are packed */
+  fail_if (gst_buffer_peek_memory (outbuf, 0) ==
+      gst_buffer_peek_memory (inbuf, 0));
+  fail_unless_equals_int (gst_buffer_get_size (outbuf),
+      GST_ROUND_UP_4 (WIDTH) * HEIGHT);
+
+  fail_unless (gst_buffer_map (outbuf, &map, GST_MAP_READ));
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH; x++)
+      fail_unless_equals_int (map.data[y * GST_ROUND_UP_4 (WIDTH) + x], y);
+  }
+  gst_buffer_unmap (outbuf, &map);
+
+  gst_buffer_unref (outbuf);
+  gst_buffer_unref (inbuf);
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+static Suite *
+bayer2gray_suite (void)
+{
+  Suite *s = suite_create ("bayer2gray");
+  TCase *tc_chain = tcase_create ("general");
+
+  /* the element is linked into the test rather than loaded as a plugin */
+  gst_element_register (NULL, "bayer2gray", GST_RANK_NONE,
+      GST_TYPE_BAYER2GRAY);
+
+  suite_add_tcase (s, tc_chain);
+  tcase_add_test (tc_chain, test_shares_memory);
+  tcase_add_test (tc_chain, test_shares_memory_with_video_meta);
+  tcase_add_test (tc_chain, test_copies_without_video_meta);
+
+  return s;
+}
+
+GST_CHECK_MAIN (bayer2gray);
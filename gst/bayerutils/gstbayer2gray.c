@@ -24,7 +24,13 @@
 /**
 * SECTION:element-bayer2gray
 *
-* Convert grayscale video from one bpp/depth combination to another.
+* Relabel Bayer video as grayscale without touching the pixels.
+*
+* The output buffer shares the memory of the input buffer. Bayer buffers
+* without a #GstVideoMeta are assumed to have rows padded to four bytes, the
+* same as the default gray stride. If the input has a video meta with some
+* other stride it's passed on as a gray video meta, unless downstream
+* doesn't support video meta, in which case the rows are copied.
 *
 * <refsect2>
 * <title>Example launch line</title>
@@ -39,6 +45,7 @@
 #endif
 
 #include "gstbayer2gray.h"
+#include "gstbayerutils.h"
 
 #include <gst/video/video.h>
 
@@ -55,25 +62,6 @@ enum
   PROP_LAST
 };
 
-#define VIDEO_CAPS_MAKE_BAYER8(format)                       \
-    "video/x-bayer, "                                        \
-    "format = (string) " format ", "                         \
-    "width = " GST_VIDEO_SIZE_RANGE ", "                     \
-    "height = " GST_VIDEO_SIZE_RANGE ", "                    \
-    "framerate = " GST_VIDEO_FPS_RANGE
-
-#define VIDEO_CAPS_MAKE_BAYER16(format)                      \
-    "video/x-bayer, "                                        \
-    "format = (string) " format ", "                         \
-    "endianness = (int) {1234, 4321}, "                      \
-    "bpp = (int) {16, 14, 12, 10}, "                         \
-    "width = " GST_VIDEO_SIZE_RANGE ", "                     \
-    "height = " GST_VIDEO_SIZE_RANGE ", "                    \
-    "framerate = " GST_VIDEO_FPS_RANGE
-
-#define VIDEO_CAPS_BAYER8 VIDEO_CAPS_MAKE_BAYER8("{bggr,grbg,gbrg,rggb}")
-#define VIDEO_CAPS_BAYER16 VIDEO_CAPS_MAKE_BAYER16("{bggr16,grbg16,gbrg16,rggb16}")
-
 /* the capabilities of the inputs and outputs */
 static GstStaticPadTemplate gst_bayer2gray_sink_template =
     GST_STATIC_PAD_TEMPLATE ("sink",
@@ -102,10 +90,15 @@ static GstCaps *gst_bayer2gray_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps);
 static gboolean gst_bayer2gray_set_caps (GstBaseTransform * btrans,
     GstCaps * incaps, GstCaps * outcaps);
+static gboolean gst_bayer2gray_transform_size (GstBaseTransform * btrans,
+    GstPadDirection direction, GstCaps * caps, gsize size, GstCaps * othercaps,
+    gsize * othersize);
+static gboolean gst_bayer2gray_decide_allocation (GstBaseTransform * btrans,
+    GstQuery * query);
+static GstFlowReturn gst_bayer2gray_prepare_output_buffer (GstBaseTransform *
+    btrans, GstBuffer * inbuf, GstBuffer ** outbuf);
 static GstFlowReturn gst_bayer2gray_transform (GstBaseTransform * btrans,
     GstBuffer * inbuf, GstBuffer * outbuf);
-static GstFlowReturn gst_bayer2gray_transform_ip (GstBaseTransform * btrans,
-    GstBuffer * buf);
 
 /* GstBayer2Gray method declarations */
 static void gst_bayer2gray_reset (GstBayer2Gray * filter);
@@ -175,10 +168,14 @@ gst_bayer2gray_class_init (GstBayer2GrayClass * klass)
       GST_DEBUG_FUNCPTR (gst_bayer2gray_transform_caps);
   gstbasetransform_class->set_caps =
       GST_DEBUG_FUNCPTR (gst_bayer2gray_set_caps);
+  gstbasetransform_class->transform_size =
+      GST_DEBUG_FUNCPTR (gst_bayer2gray_transform_size);
+  gstbasetransform_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_bayer2gray_decide_allocation);
+  gstbasetransform_class->prepare_output_buffer =
+      GST_DEBUG_FUNCPTR (gst_bayer2gray_prepare_output_buffer);
   gstbasetransform_class->transform =
       GST_DEBUG_FUNCPTR (gst_bayer2gray_transform);
-  gstbasetransform_class->transform_ip =
-      GST_DEBUG_FUNCPTR (gst_bayer2gray_transform_ip);
 }
 
 static void
@@ -186,7 +183,7 @@ gst_bayer2gray_init (GstBayer2Gray * filt)
 {
   GST_DEBUG_OBJECT (filt, "init class instance");
 
-  /* FIXME: fix in-place transform */
+  /* output buffers share the input memory, but need their own meta */
   gst_base_transform_set_in_place (GST_BASE_TRANSFORM (filt), FALSE);
 
   gst_bayer2gray_reset (filt);
@@ -296,79 +293,157 @@ gst_bayer2gray_set_caps (GstBaseTransform * btrans, GstCaps * incaps,
     GstCaps * outcaps)
 {
   GstBayer2Gray *filt = GST_BAYER2GRAY (btrans);
-  gboolean res = TRUE;
-  GstVideoInfo vinfo;
 
   GST_DEBUG_OBJECT (filt,
       "set_caps: in '%" GST_PTR_FORMAT "' out '%" GST_PTR_FORMAT "'", incaps,
       outcaps);
 
-  gst_video_info_from_caps (&filt->vinfo, outcaps);
+  if (!gst_video_info_from_caps (&filt->vinfo, outcaps)) {
+    GST_ERROR_OBJECT (filt, "Failed to parse caps %" GST_PTR_FORMAT, outcaps);
+    return FALSE;
+  }
 
-  return res;
+  filt->width = GST_VIDEO_INFO_WIDTH (&filt->vinfo);
+  filt->height = GST_VIDEO_INFO_HEIGHT (&filt->vinfo);
+  filt->depth = GST_VIDEO_INFO_COMP_DEPTH (&filt->vinfo, 0);
+  filt->fps_n = GST_VIDEO_INFO_FPS_N (&filt->vinfo);
+  filt->fps_d = GST_VIDEO_INFO_FPS_D (&filt->vinfo);
+
+  return TRUE;
 }
 
-static GstFlowReturn
-gst_bayer2gray_transform (GstBaseTransform * btrans,
-    GstBuffer * inbuf, GstBuffer * outbuf)
+/* only used when rows have to be copied into a default gray layout */
+static gboolean
+gst_bayer2gray_transform_size (GstBaseTransform * btrans,
+    GstPadDirection direction, GstCaps * caps, gsize size, GstCaps * othercaps,
+    gsize * othersize)
 {
-  GstBayer2Gray *filt = GST_BAYER2GRAY (btrans);
-  GstMapInfo minfo_in, minfo_out;
+  GstVideoInfo info;
 
-  GST_LOG_OBJECT (filt, "Doing non-inplace transform, copying data (FIX THIS)");
+  if (direction == GST_PAD_SRC) {
+    *othersize = size;
+    return TRUE;
+  }
 
-  gst_buffer_map (inbuf, &minfo_in, GST_MAP_READ);
-  gst_buffer_map (outbuf, &minfo_out, GST_MAP_WRITE);
-  memcpy (minfo_out.data, minfo_in.data, minfo_in.size);
-  gst_buffer_unmap (inbuf, &minfo_in);
-  gst_buffer_unmap (outbuf, &minfo_out);
+  if (!gst_video_info_from_caps (&info, othercaps))
+    return FALSE;
 
-  return GST_FLOW_OK;
+  *othersize = GST_VIDEO_INFO_SIZE (&info);
+
+  return TRUE;
 }
 
-/* FIXME: inplace transform doesn't work now due to buffer meta issue with
-   videoconvert, or really at least all elements using videofilter base
-   class */
-static GstFlowReturn
-gst_bayer2gray_transform_ip (GstBaseTransform * btrans, GstBuffer * buf)
+static gboolean
+gst_bayer2gray_decide_allocation (GstBaseTransform * btrans, GstQuery * query)
 {
   GstBayer2Gray *filt = GST_BAYER2GRAY (btrans);
 
-  GST_LOG_OBJECT (filt, "in-place transform, doing nothing");
+  filt->downstream_video_meta =
+      gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
 
-  gst_buffer_add_video_meta (buf, GST_VIDEO_FRAME_FLAG_NONE,
-      filt->vinfo.finfo->format, filt->vinfo.width, filt->vinfo.height);
-  GST_ERROR ("%d,%d,%d", filt->vinfo.finfo->format, filt->vinfo.width,
-      filt->vinfo.height);
-  return GST_FLOW_OK;
+  GST_DEBUG_OBJECT (filt, "Downstream %s video meta",
+      filt->downstream_video_meta ? "supports" : "doesn't support");
+
+  return
+      GST_BASE_TRANSFORM_CLASS (gst_bayer2gray_parent_class)->decide_allocation
+      (btrans, query);
 }
 
-static void
-gst_bayer2gray_reset (GstBayer2Gray * bayer2gray)
+static GstFlowReturn
+gst_bayer2gray_prepare_output_buffer (GstBaseTransform * btrans,
+    GstBuffer * inbuf, GstBuffer ** outbuf)
 {
+  GstBayer2Gray *filt = GST_BAYER2GRAY (btrans);
+  GstVideoMeta *meta = gst_buffer_get_video_meta (inbuf);
+  gsize offset = 0;
+
+  filt->in_stride = GST_VIDEO_INFO_PLANE_STRIDE (&filt->vinfo, 0);
+  if (meta) {
+    offset = meta->offset[0];
+    filt->in_stride = meta->stride[0];
+  }
+
+  filt->shared = filt->downstream_video_meta || (offset == 0 &&
+      filt->in_stride == GST_VIDEO_INFO_PLANE_STRIDE (&filt->vinfo, 0));
+
+  if (!filt->shared) {
+    GST_LOG_OBJECT (filt, "Downstream needs default stride, copying rows");
+    return
+        GST_BASE_TRANSFORM_CLASS
+        (gst_bayer2gray_parent_class)->prepare_output_buffer (btrans, inbuf,
+        outbuf);
+  }
+
+  /* new buffer referencing the same memory, any Bayer video meta dropped */
+  *outbuf = gst_buffer_copy_region (inbuf, GST_BUFFER_COPY_MEMORY, 0, -1);
+  if (!*outbuf)
+    return GST_FLOW_ERROR;
+
+  if (meta) {
+    gsize offsets[GST_VIDEO_MAX_PLANES] = { offset, };
+    gint strides[GST_VIDEO_MAX_PLANES] = { filt->in_stride, };
+
+    gst_buffer_add_video_meta_full (*outbuf, GST_VIDEO_FRAME_FLAG_NONE,
+        GST_VIDEO_INFO_FORMAT (&filt->vinfo), filt->width, filt->height, 1,
+        offsets, strides);
+  }
+
+  GST_BASE_TRANSFORM_GET_CLASS (btrans)->copy_metadata (btrans, inbuf,
+      *outbuf);
+
+  return GST_FLOW_OK;
 }
 
-/* Register filters that make up the gstgl plugin */
-static gboolean
-plugin_init (GstPlugin * plugin)
+static GstFlowReturn
+gst_bayer2gray_transform (GstBaseTransform * btrans,
+    GstBuffer * inbuf, GstBuffer * outbuf)
 {
-  GST_DEBUG_CATEGORY_INIT (GST_CAT_DEFAULT, "bayer2gray", 0, "bayer2gray");
-
-  GST_DEBUG ("plugin_init");
+  GstBayer2Gray *filt = GST_BAYER2GRAY (btrans);
+  GstVideoMeta *meta;
+  GstMapInfo minfo_in;
+  GstVideoFrame frame_out;
+  const guint8 *src;
+  guint8 *dst;
+  gint y, row_size;
+
+  /* the output already references the input pixels */
+  if (filt->shared)
+    return GST_FLOW_OK;
+
+  if (!gst_buffer_map (inbuf, &minfo_in, GST_MAP_READ)) {
+    GST_ELEMENT_ERROR (filt, RESOURCE, READ, (NULL),
+        ("Failed to map input buffer"));
+    return GST_FLOW_ERROR;
+  }
+  if (!gst_video_frame_map (&frame_out, &filt->vinfo, outbuf, GST_MAP_WRITE)) {
+    gst_buffer_unmap (inbuf, &minfo_in);
+    GST_ELEMENT_ERROR (filt, RESOURCE, WRITE, (NULL),
+        ("Failed to map output buffer"));
+    return GST_FLOW_ERROR;
+  }
 
-  GST_CAT_INFO (GST_CAT_DEFAULT, "registering bayer2gray element");
+  meta = gst_buffer_get_video_meta (inbuf);
+  src = minfo_in.data + (meta ? meta->offset[0] : 0);
+  dst = GST_VIDEO_FRAME_PLANE_DATA (&frame_out, 0);
+  row_size = filt->width * GST_VIDEO_FRAME_COMP_PSTRIDE (&frame_out, 0);
 
-  if (!gst_element_register (plugin, "bayer2gray", GST_RANK_NONE,
-          GST_TYPE_BAYER2GRAY)) {
-    return FALSE;
+  for (y = 0; y < filt->height; y++) {
+    memcpy (dst, src, row_size);
+    src += filt->in_stride;
+    dst += GST_VIDEO_FRAME_PLANE_STRIDE (&frame_out, 0);
   }
 
-  return TRUE;
+  gst_video_frame_unmap (&frame_out);
+  gst_buffer_unmap (inbuf, &minfo_in);
+
+  return GST_FLOW_OK;
 }
 
-GST_PLUGIN_DEFINE (GST_VERSION_MAJOR,
-    GST_VERSION_MINOR,
-    bayerutils,
-    "Plugins for working with Bayer video",
-    plugin_init, GST_PACKAGE_VERSION, GST_PACKAGE_LICENSE, GST_PACKAGE_NAME,
-    GST_PACKAGE_ORIGIN);
+static void
+gst_bayer2gray_reset (GstBayer2Gray * bayer2gray)
+{
+  gst_video_info_init (&bayer2gray->vinfo);
+  bayer2gray->downstream_video_meta = FALSE;
+  bayer2gray->shared = FALSE;
+  bayer2gray->in_stride = 0;
+}
@@ -64,6 +64,11 @@ struct _GstBayer2Gray
   gint bpp;
   gint fps_n;
   gint fps_d;
+
+  /* output sharing the input memory */
+  gboolean downstream_video_meta;
+  gboolean shared;
+  gint in_stride;
 };
 
 struct _GstBayer2GrayClass
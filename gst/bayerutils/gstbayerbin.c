@@ -0,0 +1,566 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+* SECTION:element-bayerbin
+*
+* Reduce Bayer video to half width and height by combining each 2x2 quad
+* of the color filter array into one pixel, far cheaper than demosaicing at
+* full resolution and scaling down.
+*
+* Gray output combines all four samples of a quad. RGB output takes red and
+* blue from their own sample and green from the two green samples, red and
+* blue counting twice so every channel has the same weight. In average mode
+* the result has the brightness of the input, while sum mode adds the
+* samples like hardware binning, saturating at the largest output value.
+* Input with more than 8 significant bits keeps its precision in GRAY16 and
+* ARGB64. An odd last row or column is dropped.
+*
+* <refsect2>
+* <title>Example launch line</title>
+* |[
+* gst-launch-1.0 videotestsrc ! bayerbin ! video/x-raw,format=GRAY8 ! videoconvert ! autovideosink
+* ]|
+* </refsect2>
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstbayerbin.h"
+
+#include <string.h>
+
+enum
+{
+  PROP_0,
+  PROP_MODE,
+  PROP_LAST
+};
+
+#define DEFAULT_PROP_MODE GST_BAYER_BIN_MODE_AVERAGE
+
+#define VIDEO_CAPS_BINNED GST_VIDEO_CAPS_MAKE ("{ GRAY8, GRAY16_LE, " \
+    "GRAY16_BE }") ";" GST_VIDEO_CAPS_MAKE (GST_BAYER_RGB_FORMATS)
+
+/* the capabilities of the inputs and outputs */
+static GstStaticPadTemplate gst_bayer_bin_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VIDEO_CAPS_BAYER8 ";" VIDEO_CAPS_BAYER16)
+    );
+
+static GstStaticPadTemplate gst_bayer_bin_src_template =
+GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VIDEO_CAPS_BINNED)
+    );
+
+#define GST_TYPE_BAYER_BIN_MODE (gst_bayer_bin_mode_get_type ())
+static GType
+gst_bayer_bin_mode_get_type (void)
+{
+  static GType mode_type = 0;
+
+  static const GEnumValue mode_types[] = {
+    {GST_BAYER_BIN_MODE_AVERAGE, "Average the samples of each color",
+        "average"},
+    {GST_BAYER_BIN_MODE_SUM, "Add the samples of each color", "sum"},
+    {0, NULL, NULL}
+  };
+
+  if (!mode_type) {
+    mode_type = g_enum_register_static ("GstBayerBinMode", mode_types);
+  }
+  return mode_type;
+}
+
+/* GObject vmethod declarations */
+static void gst_bayer_bin_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_bayer_bin_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_bayer_bin_dispose (GObject * object);
+
+/* GstBaseTransform vmethod declarations */
+static GstCaps *gst_bayer_bin_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps);
+static gboolean gst_bayer_bin_set_caps (GstBaseTransform * btrans,
+    GstCaps * incaps, GstCaps * outcaps);
+static gboolean gst_bayer_bin_transform_size (GstBaseTransform * btrans,
+    GstPadDirection direction, GstCaps * caps, gsize size, GstCaps * othercaps,
+    gsize * othersize);
+static GstFlowReturn gst_bayer_bin_transform (GstBaseTransform * btrans,
+    GstBuffer * inbuf, GstBuffer * outbuf);
+
+/* GstBayerBin method declarations */
+static void gst_bayer_bin_reset (GstBayerBin * filt);
+static void gst_bayer_bin_update_weights (GstBayerBin * filt);
+
+/* setup debug */
+GST_DEBUG_CATEGORY_STATIC (bayer_bin_debug);
+#define GST_CAT_DEFAULT bayer_bin_debug
+
+G_DEFINE_TYPE (GstBayerBin, gst_bayer_bin, GST_TYPE_BASE_TRANSFORM);
+
+/************************************************************************/
+/* GObject vmethod implementations                                      */
+/************************************************************************/
+
+static void
+gst_bayer_bin_dispose (GObject * object)
+{
+  GstBayerBin *filt = GST_BAYER_BIN (object);
+
+  GST_DEBUG ("dispose");
+
+  gst_bayer_bin_reset (filt);
+
+  /* chain up to the parent class */
+  G_OBJECT_CLASS (gst_bayer_bin_parent_class)->dispose (object);
+}
+
+static void
+gst_bayer_bin_class_init (GstBayerBinClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *gstelement_class = GST_ELEMENT_CLASS (klass);
+  GstBaseTransformClass *gstbasetransform_class =
+      GST_BASE_TRANSFORM_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (bayer_bin_debug, "bayerbin", 0,
+      "Bayer 2x2 binning filter");
+
+  GST_DEBUG ("class init");
+
+  /* Register GObject vmethods */
+  gobject_class->dispose = GST_DEBUG_FUNCPTR (gst_bayer_bin_dispose);
+  gobject_class->set_property = GST_DEBUG_FUNCPTR (gst_bayer_bin_set_property);
+  gobject_class->get_property = GST_DEBUG_FUNCPTR (gst_bayer_bin_get_property);
+
+  /* Install GObject properties */
+  g_object_class_install_property (gobject_class, PROP_MODE,
+      g_param_spec_enum ("mode", "Mode",
+          "How the samples of each 2x2 quad are combined",
+          GST_TYPE_BAYER_BIN_MODE, DEFAULT_PROP_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_bayer_bin_sink_template));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_bayer_bin_src_template));
+
+  gst_element_class_set_static_metadata (gstelement_class,
+      "Bayer 2x2 binning", "Filter/Converter/Video/Scaler",
+      "Bins Bayer video to half resolution gray or RGB video",
+      "Joshua M. Doe <oss@nvl.army.mil>");
+
+  /* Register GstBaseTransform vmethods */
+  gstbasetransform_class->transform_caps =
+      GST_DEBUG_FUNCPTR (gst_bayer_bin_transform_caps);
+  gstbasetransform_class->set_caps = GST_DEBUG_FUNCPTR (gst_bayer_bin_set_caps);
+  gstbasetransform_class->transform_size =
+      GST_DEBUG_FUNCPTR (gst_bayer_bin_transform_size);
+  gstbasetransform_class->transform =
+      GST_DEBUG_FUNCPTR (gst_bayer_bin_transform);
+}
+
+static void
+gst_bayer_bin_init (GstBayerBin * filt)
+{
+  GST_DEBUG_OBJECT (filt, "init class instance");
+
+  filt->mode = DEFAULT_PROP_MODE;
+  filt->bin8 = gst_bayer_simd_get_bin8_func (gst_simd_get_level ());
+  filt->bin16 = gst_bayer_simd_get_bin16_func (gst_simd_get_level ());
+
+  GST_DEBUG_OBJECT (filt, "Using %s kernels",
+      gst_simd_get_name (gst_simd_get_level ()));
+
+  gst_bayer_bin_reset (filt);
+}
+
+static void
+gst_bayer_bin_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstBayerBin *filt = GST_BAYER_BIN (object);
+
+  GST_DEBUG_OBJECT (filt, "setting property %s", pspec->name);
+
+  switch (prop_id) {
+    case PROP_MODE:
+      GST_OBJECT_LOCK (filt);
+      filt->mode = g_value_get_enum (value);
+      gst_bayer_bin_update_weights (filt);
+      GST_OBJECT_UNLOCK (filt);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_bayer_bin_get_property (GObject * object, guint prop_id, GValue * value,
+    GParamSpec * pspec)
+{
+  GstBayerBin *filt = GST_BAYER_BIN (object);
+
+  GST_DEBUG_OBJECT (filt, "getting property %s", pspec->name);
+
+  switch (prop_id) {
+    case PROP_MODE:
+      g_value_set_enum (value, filt->mode);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/************************************************************************/
+/* GstBaseTransform vmethod implementations                             */
+/************************************************************************/
+
+/* halve a frame dimension, or give the range of dimensions that halve to
+ * it, dropping the odd last row or column */
+static void
+gst_bayer_bin_scale_dimension (GstStructure * s, const gchar * field,
+    gboolean to_binned)
+{
+  const GValue *value = gst_structure_get_value (s, field);
+  gint min, max;
+
+  if (!value)
+    return;
+
+  if (G_VALUE_HOLDS_INT (value)) {
+    min = max = g_value_get_int (value);
+  } else if (GST_VALUE_HOLDS_INT_RANGE (value)) {
+    min = gst_value_get_int_range_min (value);
+    max = gst_value_get_int_range_max (value);
+  } else {
+    return;
+  }
+
+  if (to_binned) {
+    min = MAX (min / 2, 1);
+    max = MAX (max / 2, 1);
+  } else {
+    min = min > (G_MAXINT >> 1) ? G_MAXINT : min << 1;
+    max = max > (G_MAXINT >> 1) - 1 ? G_MAXINT : (max << 1) + 1;
+  }
+
+  if (min == max)
+    gst_structure_set (s, field, G_TYPE_INT, min, NULL);
+  else
+    gst_structure_set (s, field, GST_TYPE_INT_RANGE, min, max, NULL);
+}
+
+static GstCaps *
+gst_bayer_bin_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps)
+{
+  GstBayerBin *filt = GST_BAYER_BIN (trans);
+  static const gchar *fields[] =
+      { "width", "height", "framerate", "pixel-aspect-ratio" };
+  GstCaps *other_caps, *tmpl_caps;
+  guint i, j, k, n;
+
+  GST_LOG_OBJECT (filt, "transforming caps from %" GST_PTR_FORMAT, caps);
+
+  if (direction == GST_PAD_SRC)
+    tmpl_caps = gst_caps_from_string (VIDEO_CAPS_BAYER8 ";" VIDEO_CAPS_BAYER16);
+  else
+    tmpl_caps = gst_caps_from_string (VIDEO_CAPS_BINNED);
+
+  /* same rate with every format of the other side, at half or twice the
+   * size */
+  other_caps = gst_caps_new_empty ();
+  n = gst_caps_get_size (caps);
+  for (i = 0; i < n; ++i) {
+    const GstStructure *s = gst_caps_get_structure (caps, i);
+
+    for (j = 0; j < gst_caps_get_size (tmpl_caps); ++j) {
+      GstStructure *s_other =
+          gst_structure_copy (gst_caps_get_structure (tmpl_caps, j));
+
+      for (k = 0; k < G_N_ELEMENTS (fields); ++k) {
+        const GValue *v = gst_structure_get_value (s, fields[k]);
+        if (v)
+          gst_structure_set_value (s_other, fields[k], v);
+      }
+      gst_bayer_bin_scale_dimension (s_other, "width",
+          direction == GST_PAD_SINK);
+      gst_bayer_bin_scale_dimension (s_other, "height",
+          direction == GST_PAD_SINK);
+      other_caps = gst_caps_merge_structure (other_caps, s_other);
+    }
+  }
+  gst_caps_unref (tmpl_caps);
+
+  if (!gst_caps_is_empty (other_caps) && filter_caps) {
+    GstCaps *tmp = gst_caps_intersect_full (filter_caps, other_caps,
+        GST_CAPS_INTERSECT_FIRST);
+    gst_caps_replace (&other_caps, tmp);
+    gst_caps_unref (tmp);
+  }
+
+  GST_LOG_OBJECT (filt, "transformed caps to %" GST_PTR_FORMAT, other_caps);
+
+  return other_caps;
+}
+
+static gboolean
+gst_bayer_bin_set_caps (GstBaseTransform * btrans, GstCaps * incaps,
+    GstCaps * outcaps)
+{
+  GstBayerBin *filt = GST_BAYER_BIN (btrans);
+  GstVideoFormat format;
+
+  GST_DEBUG_OBJECT (filt,
+      "set_caps: in '%" GST_PTR_FORMAT "' out '%" GST_PTR_FORMAT "'", incaps,
+      outcaps);
+
+  if (!gst_bayer_info_from_caps (&filt->info_in, incaps) ||
+      !gst_video_info_from_caps (&filt->info_out, outcaps)) {
+    GST_ERROR_OBJECT (filt, "Failed to parse caps");
+    return FALSE;
+  }
+
+  if (GST_VIDEO_INFO_WIDTH (&filt->info_out) != filt->info_in.width / 2 ||
+      GST_VIDEO_INFO_HEIGHT (&filt->info_out) != filt->info_in.height / 2) {
+    GST_ERROR_OBJECT (filt, "Output must be half the size of the input");
+    return FALSE;
+  }
+
+  format = GST_VIDEO_INFO_FORMAT (&filt->info_out);
+  filt->rgb = GST_VIDEO_INFO_IS_RGB (&filt->info_out);
+  if (filt->rgb)
+    gst_bayer_rgb_layout_init (&filt->out_layout, &filt->info_out);
+  filt->swap_out = (format == GST_VIDEO_FORMAT_GRAY16_LE &&
+      G_BYTE_ORDER == G_BIG_ENDIAN) || (format == GST_VIDEO_FORMAT_GRAY16_BE
+      && G_BYTE_ORDER == G_LITTLE_ENDIAN);
+
+  GST_OBJECT_LOCK (filt);
+  gst_bayer_bin_update_weights (filt);
+  GST_OBJECT_UNLOCK (filt);
+
+  g_free (filt->scratch);
+  filt->scratch = g_new (guint16, 2 * filt->info_in.width +
+      3 * GST_VIDEO_INFO_WIDTH (&filt->info_out));
+
+  return TRUE;
+}
+
+static gboolean
+gst_bayer_bin_transform_size (GstBaseTransform * btrans,
+    GstPadDirection direction, GstCaps * caps, gsize size, GstCaps * othercaps,
+    gsize * othersize)
+{
+  if (direction == GST_PAD_SINK) {
+    GstVideoInfo info;
+
+    if (!gst_video_info_from_caps (&info, othercaps))
+      return FALSE;
+    *othersize = GST_VIDEO_INFO_SIZE (&info);
+  } else {
+    GstBayerInfo info;
+
+    if (!gst_bayer_info_from_caps (&info, othercaps))
+      return FALSE;
+    *othersize = info.size;
+  }
+
+  return TRUE;
+}
+
+static GstFlowReturn
+gst_bayer_bin_transform (GstBaseTransform * btrans, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstBayerBin *filt = GST_BAYER_BIN (btrans);
+  const gint width_in = filt->info_in.width;
+  const gint width = GST_VIDEO_INFO_WIDTH (&filt->info_out);
+  const gint height = GST_VIDEO_INFO_HEIGHT (&filt->info_out);
+  const gint n_out = filt->rgb ? 3 : 1;
+  GstVideoMeta *meta;
+  GstMapInfo minfo_in;
+  GstVideoFrame frame_out;
+  const guint8 *src;
+  gint in_stride, y, x, c;
+  gsize needed;
+  guint16 *swapped[2], *chan[3];
+  gint weights[3][4];
+  gint shift, max;
+
+  if (!gst_buffer_map (inbuf, &minfo_in, GST_MAP_READ)) {
+    GST_ELEMENT_ERROR (filt, RESOURCE, READ, (NULL),
+        ("Failed to map input buffer"));
+    return GST_FLOW_ERROR;
+  }
+
+  meta = gst_buffer_get_video_meta (inbuf);
+  src = minfo_in.data + (meta ? meta->offset[0] : 0);
+  in_stride = meta ? meta->stride[0] : filt->info_in.stride;
+
+  needed = (src - minfo_in.data) + (gsize) in_stride * (2 * height - 1) +
+      width_in * filt->info_in.depth / 8;
+  if (minfo_in.size < needed) {
+    gst_buffer_unmap (inbuf, &minfo_in);
+    GST_ELEMENT_ERROR (filt, STREAM, FORMAT, (NULL),
+        ("Input buffer too small, %" G_GSIZE_FORMAT " bytes instead of %"
+            G_GSIZE_FORMAT, minfo_in.size, needed));
+    return GST_FLOW_ERROR;
+  }
+
+  if (!gst_video_frame_map (&frame_out, &filt->info_out, outbuf,
+          GST_MAP_WRITE)) {
+    gst_buffer_unmap (inbuf, &minfo_in);
+    GST_ELEMENT_ERROR (filt, RESOURCE, WRITE, (NULL),
+        ("Failed to map output buffer"));
+    return GST_FLOW_ERROR;
+  }
+
+  swapped[0] = filt->scratch;
+  swapped[1] = filt->scratch + width_in;
+  for (c = 0; c < 3; c++)
+    chan[c] = filt->scratch + 2 * width_in + c * width;
+
+  /* snapshot the weights, so a mode change can't tear the frame but also
+   * doesn't wait for it */
+  GST_OBJECT_LOCK (filt);
+  memcpy (weights, filt->weights, sizeof (weights));
+  shift = filt->shift;
+  max = filt->max;
+  GST_OBJECT_UNLOCK (filt);
+
+  for (y = 0; y < height; y++) {
+    const guint8 *row0 = src + (gsize) (2 * y) * in_stride;
+    const guint8 *row1 = row0 + in_stride;
+    guint8 *dst = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (&frame_out, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (&frame_out, 0);
+    guint16 *out[3] = { chan[0], chan[1], chan[2] };
+    gboolean direct;
+
+    /* native 16-bit gray is written straight to the frame */
+    direct = !filt->rgb && !filt->swap_out &&
+        GST_VIDEO_INFO_COMP_DEPTH (&filt->info_out, 0) == 16;
+    if (direct)
+      out[0] = (guint16 *) dst;
+
+    if (filt->info_in.depth == 8) {
+      filt->bin8 (out, n_out, row0, row1, width,
+          (const gint (*)[4]) weights, shift, max);
+    } else if (filt->info_in.swap) {
+      const guint16 *s0 = (const guint16 *) row0;
+      const guint16 *s1 = (const guint16 *) row1;
+      for (x = 0; x < 2 * width; x++) {
+        swapped[0][x] = GUINT16_SWAP_LE_BE (s0[x]);
+        swapped[1][x] = GUINT16_SWAP_LE_BE (s1[x]);
+      }
+      filt->bin16 (out, n_out, swapped[0], swapped[1], width,
+          (const gint (*)[4]) weights, shift, max);
+    } else {
+      filt->bin16 (out, n_out, (const guint16 *) row0,
+          (const guint16 *) row1, width, (const gint (*)[4]) weights, shift,
+          max);
+    }
+
+    if (filt->rgb) {
+      gst_bayer_rgb_layout_pack (&filt->out_layout, dst, out, width);
+    } else if (GST_VIDEO_INFO_COMP_DEPTH (&filt->info_out, 0) == 8) {
+      for (x = 0; x < width; x++)
+        dst[x] = (guint8) out[0][x];
+    } else if (!direct) {
+      guint16 *dst16 = (guint16 *) dst;
+      for (x = 0; x < width; x++)
+        dst16[x] = GUINT16_SWAP_LE_BE (out[0][x]);
+    }
+  }
+
+  gst_video_frame_unmap (&frame_out);
+  gst_buffer_unmap (inbuf, &minfo_in);
+
+  return GST_FLOW_OK;
+}
+
+/************************************************************************/
+/* GstBayerBin method implementations                                   */
+/************************************************************************/
+
+/* called with the object lock held */
+static void
+gst_bayer_bin_update_weights (GstBayerBin * filt)
+{
+  const GstBayerInfo *info = &filt->info_in;
+  gint in_bits, out_bits, count_log2, c, k;
+
+  if (info->width == 0)
+    return;
+
+  memset (filt->weights, 0, sizeof (filt->weights));
+  if (filt->rgb) {
+    /* one red, two green and one blue sample per quad */
+    for (c = 0; c < 3; c++) {
+      for (k = 0; k < 4; k++) {
+        if (info->cfa[k] == (GstBayerColor) c)
+          filt->weights[c][k] = c == GST_BAYER_COLOR_GREEN ? 1 : 2;
+      }
+    }
+    count_log2 = 1;
+    out_bits = filt->out_layout.depth;
+  } else {
+    for (k = 0; k < 4; k++)
+      filt->weights[0][k] = 1;
+    count_log2 = 2;
+    out_bits = GST_VIDEO_INFO_COMP_DEPTH (&filt->info_out, 0);
+  }
+
+  /* sums are in units of the input, scale them to the output depth */
+  in_bits = info->bpp;
+  filt->shift = in_bits - out_bits;
+  if (filt->mode == GST_BAYER_BIN_MODE_AVERAGE)
+    filt->shift += count_log2;
+  if (filt->shift < 0) {
+    for (c = 0; c < 3; c++) {
+      for (k = 0; k < 4; k++)
+        filt->weights[c][k] <<= -filt->shift;
+    }
+    filt->shift = 0;
+  }
+  filt->max = (1 << out_bits) - 1;
+}
+
+static void
+gst_bayer_bin_reset (GstBayerBin * filt)
+{
+  g_free (filt->scratch);
+  filt->scratch = NULL;
+
+  memset (&filt->info_in, 0, sizeof (filt->info_in));
+  gst_video_info_init (&filt->info_out);
+  filt->rgb = FALSE;
+  filt->swap_out = FALSE;
+}
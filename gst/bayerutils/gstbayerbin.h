@@ -0,0 +1,92 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_BAYER_BIN_H__
+#define __GST_BAYER_BIN_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/video/video.h>
+
+#include "gstbayerutils.h"
+#include "gstbayersimd.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_BAYER_BIN \
+  (gst_bayer_bin_get_type())
+#define GST_BAYER_BIN(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_BAYER_BIN,GstBayerBin))
+#define GST_BAYER_BIN_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_BAYER_BIN,GstBayerBinClass))
+#define GST_IS_BAYER_BIN(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_BAYER_BIN))
+#define GST_IS_BAYER_BIN_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_BAYER_BIN))
+
+typedef struct _GstBayerBin GstBayerBin;
+typedef struct _GstBayerBinClass GstBayerBinClass;
+
+typedef enum {
+  GST_BAYER_BIN_MODE_AVERAGE,
+  GST_BAYER_BIN_MODE_SUM
+} GstBayerBinMode;
+
+/**
+* GstBayerBin:
+* @element: the parent element.
+*
+*
+* The opaque GstBayerBin data structure.
+*/
+struct _GstBayerBin
+{
+  GstBaseTransform element;
+
+  /* properties */
+  GstBayerBinMode mode;
+
+  /* format */
+  GstBayerInfo info_in;
+  GstVideoInfo info_out;
+  gboolean rgb;
+  GstBayerRgbLayout out_layout;
+  gboolean swap_out;
+
+  /* weights of each quad sample for each output channel */
+  gint weights[3][4];
+  gint shift;
+  gint max;
+  GstBayerBin8Func bin8;
+  GstBayerBin16Func bin16;
+
+  /* two byte swapped input rows and three output rows */
+  guint16 *scratch;
+};
+
+struct _GstBayerBinClass
+{
+  GstBaseTransformClass parent_class;
+};
+
+GType gst_bayer_bin_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_BAYER_BIN_H__ */
@@ -0,0 +1,609 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+* SECTION:element-bayerdemosaic
+*
+* Interpolate RGB video from 8 or 16-bit Bayer video.
+*
+* The bilinear method averages the nearest samples of each color, while the
+* Malvar-He-Cutler method adds a gradient correction from the 5x5
+* neighbourhood, giving sharper edges with fewer color fringes at little
+* extra cost. Both work on horizontal stripes of the frame in parallel, each
+* stripe keeping a small ring of input rows widened to 16 bits.
+*
+* Input with more than 8 significant bits is best sent to ARGB64, which
+* keeps the full precision; the other formats keep the 8 most significant
+* bits.
+*
+* <refsect2>
+* <title>Example launch line</title>
+* |[
+* gst-launch-1.0 videotestsrc ! bayerdemosaic method=malvar ! videoconvert ! autovideosink
+* ]|
+* </refsect2>
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstbayerdemosaic.h"
+
+#include <string.h>
+
+enum
+{
+  PROP_0,
+  PROP_METHOD,
+  PROP_N_THREADS,
+  PROP_LAST
+};
+
+#define DEFAULT_PROP_METHOD GST_BAYER_DEMOSAIC_METHOD_BILINEAR
+#define DEFAULT_PROP_N_THREADS 0
+
+#define VIDEO_CAPS_RGB GST_VIDEO_CAPS_MAKE (GST_BAYER_RGB_FORMATS)
+
+/* the capabilities of the inputs and outputs */
+static GstStaticPadTemplate gst_bayer_demosaic_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VIDEO_CAPS_BAYER8 ";" VIDEO_CAPS_BAYER16)
+    );
+
+static GstStaticPadTemplate gst_bayer_demosaic_src_template =
+GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VIDEO_CAPS_RGB)
+    );
+
+#define GST_TYPE_BAYER_DEMOSAIC_METHOD (gst_bayer_demosaic_method_get_type ())
+static GType
+gst_bayer_demosaic_method_get_type (void)
+{
+  static GType method_type = 0;
+
+  static const GEnumValue method_types[] = {
+    {GST_BAYER_DEMOSAIC_METHOD_BILINEAR, "Bilinear interpolation",
+        "bilinear"},
+    {GST_BAYER_DEMOSAIC_METHOD_MALVAR,
+        "Gradient corrected linear interpolation (Malvar-He-Cutler)",
+        "malvar"},
+    {0, NULL, NULL}
+  };
+
+  if (!method_type) {
+    method_type =
+        g_enum_register_static ("GstBayerDemosaicMethod", method_types);
+  }
+  return method_type;
+}
+
+/* filters making up each method, see GstBayerDemosaicTerm for the order of
+ * coefficients */
+enum
+{
+  FILTER_IDENTITY,
+  FILTER_GREEN,                 /* green at a red or blue site */
+  FILTER_HORIZONTAL,            /* color of the left and right neighbours */
+  FILTER_VERTICAL,              /* color of the upper and lower neighbours */
+  FILTER_DIAGONAL,              /* red at a blue site or blue at a red site */
+  N_FILTERS
+};
+
+static const gint filters[2][N_FILTERS][GST_BAYER_DEMOSAIC_N_TERMS] = {
+  /* bilinear */
+  {
+        {16, 0, 0, 0, 0, 0},
+        {0, 4, 4, 0, 0, 0},
+        {0, 8, 0, 0, 0, 0},
+        {0, 0, 8, 0, 0, 0},
+        {0, 0, 0, 4, 0, 0},
+      },
+  /* Malvar-He-Cutler, "High-quality linear interpolation for demosaicing of
+   * Bayer-patterned color images", ICASSP 2004 */
+  {
+        {16, 0, 0, 0, 0, 0},
+        {8, 4, 4, 0, -2, -2},
+        {10, 8, 0, -2, -2, 1},
+        {10, 0, 8, -2, 1, -2},
+        {12, 0, 0, 4, -3, -3},
+      }
+};
+
+/* frame shared by all stripes, with the filters copied so the object lock
+ * isn't held while processing */
+typedef struct
+{
+  GstBayerDemosaic *filt;
+  const guint8 *in_data;
+  gint in_stride;
+  GstVideoFrame *out_frame;
+  gint coefs[2][3][2][GST_BAYER_DEMOSAIC_N_TERMS];
+} GstBayerDemosaicJob;
+
+/* GObject vmethod declarations */
+static void gst_bayer_demosaic_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_bayer_demosaic_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_bayer_demosaic_dispose (GObject * object);
+
+/* GstBaseTransform vmethod declarations */
+static GstCaps *gst_bayer_demosaic_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps);
+static gboolean gst_bayer_demosaic_set_caps (GstBaseTransform * btrans,
+    GstCaps * incaps, GstCaps * outcaps);
+static gboolean gst_bayer_demosaic_transform_size (GstBaseTransform * btrans,
+    GstPadDirection direction, GstCaps * caps, gsize size, GstCaps * othercaps,
+    gsize * othersize);
+static GstFlowReturn gst_bayer_demosaic_transform (GstBaseTransform * btrans,
+    GstBuffer * inbuf, GstBuffer * outbuf);
+
+/* GstBayerDemosaic method declarations */
+static void gst_bayer_demosaic_reset (GstBayerDemosaic * filt);
+static void gst_bayer_demosaic_update_filters (GstBayerDemosaic * filt);
+
+/* setup debug */
+GST_DEBUG_CATEGORY_STATIC (bayer_demosaic_debug);
+#define GST_CAT_DEFAULT bayer_demosaic_debug
+
+G_DEFINE_TYPE (GstBayerDemosaic, gst_bayer_demosaic, GST_TYPE_BASE_TRANSFORM);
+
+/************************************************************************/
+/* GObject vmethod implementations                                      */
+/************************************************************************/
+
+static void
+gst_bayer_demosaic_dispose (GObject * object)
+{
+  GstBayerDemosaic *filt = GST_BAYER_DEMOSAIC (object);
+
+  GST_DEBUG ("dispose");
+
+  gst_bayer_demosaic_reset (filt);
+
+  /* chain up to the parent class */
+  G_OBJECT_CLASS (gst_bayer_demosaic_parent_class)->dispose (object);
+}
+
+static void
+gst_bayer_demosaic_class_init (GstBayerDemosaicClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *gstelement_class = GST_ELEMENT_CLASS (klass);
+  GstBaseTransformClass *gstbasetransform_class =
+      GST_BASE_TRANSFORM_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (bayer_demosaic_debug, "bayerdemosaic", 0,
+      "Bayer demosaic filter");
+
+  GST_DEBUG ("class init");
+
+  /* Register GObject vmethods */
+  gobject_class->dispose = GST_DEBUG_FUNCPTR (gst_bayer_demosaic_dispose);
+  gobject_class->set_property =
+      GST_DEBUG_FUNCPTR (gst_bayer_demosaic_set_property);
+  gobject_class->get_property =
+      GST_DEBUG_FUNCPTR (gst_bayer_demosaic_get_property);
+
+  /* Install GObject properties */
+  g_object_class_install_property (gobject_class, PROP_METHOD,
+      g_param_spec_enum ("method", "Method", "Interpolation method",
+          GST_TYPE_BAYER_DEMOSAIC_METHOD, DEFAULT_PROP_METHOD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      GST_STRIPE_POOL_PARAM_SPEC_N_THREADS (DEFAULT_PROP_N_THREADS));
+
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_bayer_demosaic_sink_template));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_bayer_demosaic_src_template));
+
+  gst_element_class_set_static_metadata (gstelement_class,
+      "Bayer demosaic", "Filter/Converter/Video",
+      "Interpolates RGB video from Bayer video",
+      "Joshua M. Doe <oss@nvl.army.mil>");
+
+  /* Register GstBaseTransform vmethods */
+  gstbasetransform_class->transform_caps =
+      GST_DEBUG_FUNCPTR (gst_bayer_demosaic_transform_caps);
+  gstbasetransform_class->set_caps =
+      GST_DEBUG_FUNCPTR (gst_bayer_demosaic_set_caps);
+  gstbasetransform_class->transform_size =
+      GST_DEBUG_FUNCPTR (gst_bayer_demosaic_transform_size);
+  gstbasetransform_class->transform =
+      GST_DEBUG_FUNCPTR (gst_bayer_demosaic_transform);
+}
+
+static void
+gst_bayer_demosaic_init (GstBayerDemosaic * filt)
+{
+  GST_DEBUG_OBJECT (filt, "init class instance");
+
+  filt->method = DEFAULT_PROP_METHOD;
+  filt->n_threads = DEFAULT_PROP_N_THREADS;
+  filt->demosaic = gst_bayer_simd_get_demosaic_func (gst_simd_get_level ());
+
+  GST_DEBUG_OBJECT (filt, "Using %s kernels",
+      gst_simd_get_name (gst_simd_get_level ()));
+
+  gst_bayer_demosaic_reset (filt);
+}
+
+static void
+gst_bayer_demosaic_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstBayerDemosaic *filt = GST_BAYER_DEMOSAIC (object);
+
+  GST_DEBUG_OBJECT (filt, "setting property %s", pspec->name);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      GST_OBJECT_LOCK (filt);
+      filt->method = g_value_get_enum (value);
+      gst_bayer_demosaic_update_filters (filt);
+      GST_OBJECT_UNLOCK (filt);
+      break;
+    case PROP_N_THREADS:
+      filt->n_threads = g_value_get_uint (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_bayer_demosaic_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstBayerDemosaic *filt = GST_BAYER_DEMOSAIC (object);
+
+  GST_DEBUG_OBJECT (filt, "getting property %s", pspec->name);
+
+  switch (prop_id) {
+    case PROP_METHOD:
+      g_value_set_enum (value, filt->method);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, filt->n_threads);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/************************************************************************/
+/* GstBaseTransform vmethod implementations                             */
+/************************************************************************/
+
+static GstCaps *
+gst_bayer_demosaic_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps)
+{
+  GstBayerDemosaic *filt = GST_BAYER_DEMOSAIC (trans);
+  static const gchar *fields[] =
+      { "width", "height", "framerate", "pixel-aspect-ratio" };
+  GstCaps *other_caps, *tmpl_caps;
+  guint i, j, k, n;
+
+  GST_LOG_OBJECT (filt, "transforming caps from %" GST_PTR_FORMAT, caps);
+
+  if (direction == GST_PAD_SRC)
+    tmpl_caps = gst_caps_from_string (VIDEO_CAPS_BAYER8 ";" VIDEO_CAPS_BAYER16);
+  else
+    tmpl_caps = gst_caps_from_string (VIDEO_CAPS_RGB);
+
+  /* same dimensions and rate with every format of the other side */
+  other_caps = gst_caps_new_empty ();
+  n = gst_caps_get_size (caps);
+  for (i = 0; i < n; ++i) {
+    const GstStructure *s = gst_caps_get_structure (caps, i);
+
+    for (j = 0; j < gst_caps_get_size (tmpl_caps); ++j) {
+      GstStructure *s_other =
+          gst_structure_copy (gst_caps_get_structure (tmpl_caps, j));
+
+      for (k = 0; k < G_N_ELEMENTS (fields); ++k) {
+        const GValue *v = gst_structure_get_value (s, fields[k]);
+        if (v)
+          gst_structure_set_value (s_other, fields[k], v);
+      }
+      other_caps = gst_caps_merge_structure (other_caps, s_other);
+    }
+  }
+  gst_caps_unref (tmpl_caps);
+
+  if (!gst_caps_is_empty (other_caps) && filter_caps) {
+    GstCaps *tmp = gst_caps_intersect_full (filter_caps, other_caps,
+        GST_CAPS_INTERSECT_FIRST);
+    gst_caps_replace (&other_caps, tmp);
+    gst_caps_unref (tmp);
+  }
+
+  GST_LOG_OBJECT (filt, "transformed caps to %" GST_PTR_FORMAT, other_caps);
+
+  return other_caps;
+}
+
+static gboolean
+gst_bayer_demosaic_set_caps (GstBaseTransform * btrans, GstCaps * incaps,
+    GstCaps * outcaps)
+{
+  GstBayerDemosaic *filt = GST_BAYER_DEMOSAIC (btrans);
+  gint in_bits, out_bits;
+
+  GST_DEBUG_OBJECT (filt,
+      "set_caps: in '%" GST_PTR_FORMAT "' out '%" GST_PTR_FORMAT "'", incaps,
+      outcaps);
+
+  if (!gst_bayer_info_from_caps (&filt->info_in, incaps) ||
+      !gst_video_info_from_caps (&filt->info_out, outcaps)) {
+    GST_ERROR_OBJECT (filt, "Failed to parse caps");
+    return FALSE;
+  }
+
+  /* work at the significant depth of the input, then scale to the output */
+  gst_bayer_rgb_layout_init (&filt->out_layout, &filt->info_out);
+  in_bits = filt->info_in.bpp;
+  out_bits = filt->out_layout.depth;
+  filt->max = (1 << in_bits) - 1;
+  filt->rshift = MAX (0, in_bits - out_bits);
+  filt->lshift = MAX (0, out_bits - in_bits);
+
+  GST_OBJECT_LOCK (filt);
+  gst_bayer_demosaic_update_filters (filt);
+  GST_OBJECT_UNLOCK (filt);
+
+  if (gst_stripe_pool_ensure (&filt->stripe_pool, filt->n_threads))
+    GST_DEBUG_OBJECT (filt, "Processing with %d threads",
+        filt->stripe_pool->n_threads);
+
+  filt->scratch_stride = 5 * (filt->info_in.width + 4) +
+      3 * filt->info_in.width;
+  g_free (filt->scratch);
+  filt->scratch =
+      g_new (guint16, filt->stripe_pool->n_threads * filt->scratch_stride);
+
+  return TRUE;
+}
+
+static gboolean
+gst_bayer_demosaic_transform_size (GstBaseTransform * btrans,
+    GstPadDirection direction, GstCaps * caps, gsize size, GstCaps * othercaps,
+    gsize * othersize)
+{
+  if (direction == GST_PAD_SINK) {
+    GstVideoInfo info;
+
+    if (!gst_video_info_from_caps (&info, othercaps))
+      return FALSE;
+    *othersize = GST_VIDEO_INFO_SIZE (&info);
+  } else {
+    GstBayerInfo info;
+
+    if (!gst_bayer_info_from_caps (&info, othercaps))
+      return FALSE;
+    *othersize = info.size;
+  }
+
+  return TRUE;
+}
+
+/* mirror about the edge sample, which keeps the CFA phase of the index */
+static inline gint
+gst_bayer_demosaic_reflect (gint i, gint n)
+{
+  if (i < 0)
+    i = -i;
+  if (i >= n)
+    i = 2 * n - 2 - i;
+  return CLAMP (i, 0, n - 1);
+}
+
+/* widen input row y to 16 bits, with two samples of padding at each end */
+static void
+gst_bayer_demosaic_load_row (const GstBayerDemosaicJob * job, guint16 * dst,
+    gint y)
+{
+  const GstBayerDemosaic *filt = job->filt;
+  const gint width = filt->info_in.width;
+  const guint8 *src = job->in_data + (gsize) y * job->in_stride;
+  guint16 *row = dst + 2;
+  gint x;
+
+  if (filt->info_in.depth == 8) {
+    for (x = 0; x < width; x++)
+      row[x] = src[x];
+  } else if (filt->info_in.swap) {
+    const guint16 *src16 = (const guint16 *) src;
+    for (x = 0; x < width; x++)
+      row[x] = GUINT16_SWAP_LE_BE (src16[x]);
+  } else {
+    memcpy (row, src, width * sizeof (guint16));
+  }
+
+  row[-2] = row[gst_bayer_demosaic_reflect (-2, width)];
+  row[-1] = row[gst_bayer_demosaic_reflect (-1, width)];
+  row[width] = row[gst_bayer_demosaic_reflect (width, width)];
+  row[width + 1] = row[gst_bayer_demosaic_reflect (width + 1, width)];
+}
+
+static void
+gst_bayer_demosaic_process_stripe (gpointer user_data, guint stripe,
+    guint n_stripes)
+{
+  const GstBayerDemosaicJob *job = (const GstBayerDemosaicJob *) user_data;
+  GstBayerDemosaic *filt = job->filt;
+  const gint width = filt->info_in.width;
+  const gint height = filt->info_in.height;
+  guint16 *scratch = filt->scratch + stripe * filt->scratch_stride;
+  guint16 *ring[5], *rgb[3];
+  gint ring_row[5];
+  gint row_start, row_end, y, k;
+
+  gst_stripe_get_rows (stripe, n_stripes, height, &row_start, &row_end);
+
+  /* rows y - 2 to y + 2 always fall in distinct slots of a five row ring */
+  for (k = 0; k < 5; k++) {
+    ring[k] = scratch + k * (width + 4);
+    ring_row[k] = -1;
+  }
+  for (k = 0; k < 3; k++)
+    rgb[k] = scratch + 5 * (width + 4) + k * width;
+
+  for (y = row_start; y < row_end; y++) {
+    const guint16 *rows[5];
+
+    for (k = 0; k < 5; k++) {
+      const gint src_y = gst_bayer_demosaic_reflect (y + k - 2, height);
+      const gint slot = src_y % 5;
+
+      if (ring_row[slot] != src_y) {
+        gst_bayer_demosaic_load_row (job, ring[slot], src_y);
+        ring_row[slot] = src_y;
+      }
+      rows[k] = ring[slot] + 2;
+    }
+
+    filt->demosaic (rgb, rows, width,
+        (const gint (*)[2][GST_BAYER_DEMOSAIC_N_TERMS]) job->coefs[y & 1],
+        filt->max, filt->rshift, filt->lshift);
+    gst_bayer_rgb_layout_pack (&filt->out_layout,
+        (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (job->out_frame, 0) +
+        y * GST_VIDEO_FRAME_PLANE_STRIDE (job->out_frame, 0), rgb, width);
+  }
+}
+
+static GstFlowReturn
+gst_bayer_demosaic_transform (GstBaseTransform * btrans, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstBayerDemosaic *filt = GST_BAYER_DEMOSAIC (btrans);
+  GstBayerDemosaicJob job;
+  GstVideoMeta *meta;
+  GstMapInfo minfo_in;
+  GstVideoFrame frame_out;
+  gsize offset, needed;
+
+  if (!gst_buffer_map (inbuf, &minfo_in, GST_MAP_READ)) {
+    GST_ELEMENT_ERROR (filt, RESOURCE, READ, (NULL),
+        ("Failed to map input buffer"));
+    return GST_FLOW_ERROR;
+  }
+
+  meta = gst_buffer_get_video_meta (inbuf);
+  offset = meta ? meta->offset[0] : 0;
+  job.in_stride = meta ? meta->stride[0] : filt->info_in.stride;
+
+  needed = offset + (gsize) job.in_stride * (filt->info_in.height - 1) +
+      filt->info_in.width * filt->info_in.depth / 8;
+  if (minfo_in.size < needed) {
+    gst_buffer_unmap (inbuf, &minfo_in);
+    GST_ELEMENT_ERROR (filt, STREAM, FORMAT, (NULL),
+        ("Input buffer too small, %" G_GSIZE_FORMAT " bytes instead of %"
+            G_GSIZE_FORMAT, minfo_in.size, needed));
+    return GST_FLOW_ERROR;
+  }
+
+  if (!gst_video_frame_map (&frame_out, &filt->info_out, outbuf,
+          GST_MAP_WRITE)) {
+    gst_buffer_unmap (inbuf, &minfo_in);
+    GST_ELEMENT_ERROR (filt, RESOURCE, WRITE, (NULL),
+        ("Failed to map output buffer"));
+    return GST_FLOW_ERROR;
+  }
+
+  job.filt = filt;
+  job.in_data = minfo_in.data + offset;
+  job.out_frame = &frame_out;
+
+  GST_OBJECT_LOCK (filt);
+  memcpy (job.coefs, filt->coefs, sizeof (job.coefs));
+  GST_OBJECT_UNLOCK (filt);
+
+  gst_stripe_pool_run (filt->stripe_pool, gst_bayer_demosaic_process_stripe,
+      &job);
+
+  gst_video_frame_unmap (&frame_out);
+  gst_buffer_unmap (inbuf, &minfo_in);
+
+  return GST_FLOW_OK;
+}
+
+/************************************************************************/
+/* GstBayerDemosaic method implementations                              */
+/************************************************************************/
+
+/* pick the filter of each output channel at each of the four CFA sites,
+ * called with the object lock held */
+static void
+gst_bayer_demosaic_update_filters (GstBayerDemosaic * filt)
+{
+  const GstBayerInfo *info = &filt->info_in;
+  gint py, px, c;
+
+  if (info->width == 0)
+    return;
+
+  for (py = 0; py < 2; py++) {
+    for (px = 0; px < 2; px++) {
+      const GstBayerColor site = GST_BAYER_INFO_COLOR (info, px, py);
+      const GstBayerColor horizontal = GST_BAYER_INFO_COLOR (info, px + 1, py);
+
+      for (c = 0; c < 3; c++) {
+        gint filter;
+
+        if (c == site)
+          filter = FILTER_IDENTITY;
+        else if (c == GST_BAYER_COLOR_GREEN)
+          filter = FILTER_GREEN;
+        else if (site != GST_BAYER_COLOR_GREEN)
+          filter = FILTER_DIAGONAL;
+        else if (c == horizontal)
+          filter = FILTER_HORIZONTAL;
+        else
+          filter = FILTER_VERTICAL;
+
+        memcpy (filt->coefs[py][c][px], filters[filt->method][filter],
+            sizeof (filters[0][0]));
+      }
+    }
+  }
+}
+
+static void
+gst_bayer_demosaic_reset (GstBayerDemosaic * filt)
+{
+  gst_stripe_pool_free (filt->stripe_pool);
+  filt->stripe_pool = NULL;
+  g_free (filt->scratch);
+  filt->scratch = NULL;
+  filt->scratch_stride = 0;
+
+  memset (&filt->info_in, 0, sizeof (filt->info_in));
+  gst_video_info_init (&filt->info_out);
+}
@@ -0,0 +1,95 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_BAYER_DEMOSAIC_H__
+#define __GST_BAYER_DEMOSAIC_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/video/video.h>
+
+#include "gstbayerutils.h"
+#include "gstbayersimd.h"
+#include "stripepool.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_BAYER_DEMOSAIC \
+  (gst_bayer_demosaic_get_type())
+#define GST_BAYER_DEMOSAIC(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_BAYER_DEMOSAIC,GstBayerDemosaic))
+#define GST_BAYER_DEMOSAIC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_BAYER_DEMOSAIC,GstBayerDemosaicClass))
+#define GST_IS_BAYER_DEMOSAIC(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_BAYER_DEMOSAIC))
+#define GST_IS_BAYER_DEMOSAIC_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_BAYER_DEMOSAIC))
+
+typedef struct _GstBayerDemosaic GstBayerDemosaic;
+typedef struct _GstBayerDemosaicClass GstBayerDemosaicClass;
+
+typedef enum {
+  GST_BAYER_DEMOSAIC_METHOD_BILINEAR,
+  GST_BAYER_DEMOSAIC_METHOD_MALVAR
+} GstBayerDemosaicMethod;
+
+/**
+* GstBayerDemosaic:
+* @element: the parent element.
+*
+*
+* The opaque GstBayerDemosaic data structure.
+*/
+struct _GstBayerDemosaic
+{
+  GstBaseTransform element;
+
+  /* properties */
+  GstBayerDemosaicMethod method;
+  guint n_threads;
+
+  /* format */
+  GstBayerInfo info_in;
+  GstVideoInfo info_out;
+
+  /* filters for even and odd rows */
+  gint coefs[2][3][2][GST_BAYER_DEMOSAIC_N_TERMS];
+  gint max;
+  gint rshift;
+  gint lshift;
+  GstBayerDemosaicFunc demosaic;
+
+  GstBayerRgbLayout out_layout;
+
+  /* per stripe ring of five padded input rows and three output rows */
+  GstStripePool *stripe_pool;
+  guint16 *scratch;
+  gsize scratch_stride;
+};
+
+struct _GstBayerDemosaicClass
+{
+  GstBaseTransformClass parent_class;
+};
+
+GType gst_bayer_demosaic_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_BAYER_DEMOSAIC_H__ */
@@ -0,0 +1,507 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+* SECTION:element-bayernormalize
+*
+* Correct raw Bayer video in a single pass: subtract a black level, apply a
+* white balance gain, and optionally shift 10, 12 or 14-bit samples up to
+* the full 16-bit range.
+*
+* The black level and gain are set for each site of the color filter array,
+* the two green sites being told apart by the color sharing their row. The
+* black level is in units of the input and results saturate at zero and at
+* the largest sample value. Frames are processed in place, so the output
+* has the same pattern, size and endianness as the input.
+*
+* <refsect2>
+* <title>Example launch line</title>
+* |[
+* gst-launch-1.0 videotestsrc ! bayernormalize black-level-red=64 gain-red=1.8 gain-blue=1.4 ! bayerdemosaic ! videoconvert ! autovideosink
+* ]|
+* </refsect2>
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstbayernormalize.h"
+
+#include <string.h>
+
+enum
+{
+  PROP_0,
+  PROP_BLACK_LEVEL_RED,
+  PROP_BLACK_LEVEL_GREEN_RED,
+  PROP_BLACK_LEVEL_GREEN_BLUE,
+  PROP_BLACK_LEVEL_BLUE,
+  PROP_GAIN_RED,
+  PROP_GAIN_GREEN_RED,
+  PROP_GAIN_GREEN_BLUE,
+  PROP_GAIN_BLUE,
+  PROP_NORMALIZE,
+  PROP_LAST
+};
+
+#define DEFAULT_PROP_BLACK_LEVEL 0
+#define DEFAULT_PROP_GAIN 1.0
+#define DEFAULT_PROP_NORMALIZE TRUE
+
+/* largest gain keeping the products within 32 bits */
+#define MAX_GAIN 16.0
+
+/* the capabilities of the inputs and outputs */
+static GstStaticPadTemplate gst_bayer_normalize_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VIDEO_CAPS_BAYER8 ";" VIDEO_CAPS_BAYER16)
+    );
+
+static GstStaticPadTemplate gst_bayer_normalize_src_template =
+GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (VIDEO_CAPS_BAYER8 ";" VIDEO_CAPS_BAYER16)
+    );
+
+/* GObject vmethod declarations */
+static void gst_bayer_normalize_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_bayer_normalize_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+
+/* GstBaseTransform vmethod declarations */
+static GstCaps *gst_bayer_normalize_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps);
+static gboolean gst_bayer_normalize_set_caps (GstBaseTransform * btrans,
+    GstCaps * incaps, GstCaps * outcaps);
+static GstFlowReturn gst_bayer_normalize_transform_ip (GstBaseTransform *
+    btrans, GstBuffer * buf);
+
+/* GstBayerNormalize method declarations */
+static gboolean gst_bayer_normalize_update (GstBayerNormalize * filt);
+
+/* setup debug */
+GST_DEBUG_CATEGORY_STATIC (bayer_normalize_debug);
+#define GST_CAT_DEFAULT bayer_normalize_debug
+
+G_DEFINE_TYPE (GstBayerNormalize, gst_bayer_normalize,
+    GST_TYPE_BASE_TRANSFORM);
+
+/************************************************************************/
+/* GObject vmethod implementations                                      */
+/************************************************************************/
+
+static void
+gst_bayer_normalize_class_init (GstBayerNormalizeClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *gstelement_class = GST_ELEMENT_CLASS (klass);
+  GstBaseTransformClass *gstbasetransform_class =
+      GST_BASE_TRANSFORM_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (bayer_normalize_debug, "bayernormalize", 0,
+      "Bayer black level, gain and depth normalization filter");
+
+  GST_DEBUG ("class init");
+
+  /* Register GObject vmethods */
+  gobject_class->set_property =
+      GST_DEBUG_FUNCPTR (gst_bayer_normalize_set_property);
+  gobject_class->get_property =
+      GST_DEBUG_FUNCPTR (gst_bayer_normalize_get_property);
+
+  /* Install GObject properties */
+  g_object_class_install_property (gobject_class, PROP_BLACK_LEVEL_RED,
+      g_param_spec_uint ("black-level-red", "Red black level",
+          "Value subtracted from red samples", 0, G_MAXUINT16,
+          DEFAULT_PROP_BLACK_LEVEL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_BLACK_LEVEL_GREEN_RED,
+      g_param_spec_uint ("black-level-green-red",
+          "Green on red rows black level",
+          "Value subtracted from green samples on rows with red samples", 0,
+          G_MAXUINT16, DEFAULT_PROP_BLACK_LEVEL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_BLACK_LEVEL_GREEN_BLUE,
+      g_param_spec_uint ("black-level-green-blue",
+          "Green on blue rows black level",
+          "Value subtracted from green samples on rows with blue samples", 0,
+          G_MAXUINT16, DEFAULT_PROP_BLACK_LEVEL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_BLACK_LEVEL_BLUE,
+      g_param_spec_uint ("black-level-blue", "Blue black level",
+          "Value subtracted from blue samples", 0, G_MAXUINT16,
+          DEFAULT_PROP_BLACK_LEVEL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_GAIN_RED,
+      g_param_spec_double ("gain-red", "Red gain",
+          "Gain of red samples after subtracting the black level", 0.0,
+          MAX_GAIN, DEFAULT_PROP_GAIN,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_GAIN_GREEN_RED,
+      g_param_spec_double ("gain-green-red", "Green on red rows gain",
+          "Gain of green samples on rows with red samples after subtracting "
+          "the black level", 0.0, MAX_GAIN, DEFAULT_PROP_GAIN,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_GAIN_GREEN_BLUE,
+      g_param_spec_double ("gain-green-blue", "Green on blue rows gain",
+          "Gain of green samples on rows with blue samples after subtracting "
+          "the black level", 0.0, MAX_GAIN, DEFAULT_PROP_GAIN,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_GAIN_BLUE,
+      g_param_spec_double ("gain-blue", "Blue gain",
+          "Gain of blue samples after subtracting the black level", 0.0,
+          MAX_GAIN, DEFAULT_PROP_GAIN,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_CONTROLLABLE));
+  g_object_class_install_property (gobject_class, PROP_NORMALIZE,
+      g_param_spec_boolean ("normalize", "Normalize",
+          "Shift 16-bit samples with fewer significant bits up to the full "
+          "16-bit range", DEFAULT_PROP_NORMALIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_bayer_normalize_sink_template));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_bayer_normalize_src_template));
+
+  gst_element_class_set_static_metadata (gstelement_class,
+      "Bayer normalize", "Filter/Effect/Video",
+      "Applies black level, white balance and bit depth normalization to "
+      "Bayer video", "Joshua M. Doe <oss@nvl.army.mil>");
+
+  /* Register GstBaseTransform vmethods */
+  gstbasetransform_class->transform_caps =
+      GST_DEBUG_FUNCPTR (gst_bayer_normalize_transform_caps);
+  gstbasetransform_class->set_caps =
+      GST_DEBUG_FUNCPTR (gst_bayer_normalize_set_caps);
+  gstbasetransform_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_bayer_normalize_transform_ip);
+}
+
+static void
+gst_bayer_normalize_init (GstBayerNormalize * filt)
+{
+  gint i;
+
+  GST_DEBUG_OBJECT (filt, "init class instance");
+
+  for (i = 0; i < GST_BAYER_NORMALIZE_N_SITES; i++) {
+    filt->black_level[i] = DEFAULT_PROP_BLACK_LEVEL;
+    filt->gain[i] = DEFAULT_PROP_GAIN;
+  }
+  filt->normalize = DEFAULT_PROP_NORMALIZE;
+  memset (&filt->info_in, 0, sizeof (filt->info_in));
+
+  filt->normalize8 = gst_bayer_simd_get_normalize8_func (gst_simd_get_level ());
+  filt->normalize16 =
+      gst_bayer_simd_get_normalize16_func (gst_simd_get_level ());
+
+  GST_DEBUG_OBJECT (filt, "Using %s kernels",
+      gst_simd_get_name (gst_simd_get_level ()));
+
+  gst_base_transform_set_in_place (GST_BASE_TRANSFORM (filt), TRUE);
+}
+
+static void
+gst_bayer_normalize_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstBayerNormalize *filt = GST_BAYER_NORMALIZE (object);
+  gboolean identity, configured;
+
+  GST_DEBUG_OBJECT (filt, "setting property %s", pspec->name);
+
+  GST_OBJECT_LOCK (filt);
+  switch (prop_id) {
+    case PROP_BLACK_LEVEL_RED:
+    case PROP_BLACK_LEVEL_GREEN_RED:
+    case PROP_BLACK_LEVEL_GREEN_BLUE:
+    case PROP_BLACK_LEVEL_BLUE:
+      filt->black_level[prop_id - PROP_BLACK_LEVEL_RED] =
+          g_value_get_uint (value);
+      break;
+    case PROP_GAIN_RED:
+    case PROP_GAIN_GREEN_RED:
+    case PROP_GAIN_GREEN_BLUE:
+    case PROP_GAIN_BLUE:
+      filt->gain[prop_id - PROP_GAIN_RED] = g_value_get_double (value);
+      break;
+    case PROP_NORMALIZE:
+      filt->normalize = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  identity = gst_bayer_normalize_update (filt);
+  configured = filt->info_in.width != 0;
+  GST_OBJECT_UNLOCK (filt);
+
+  /* output depth may have changed, set_caps applies it once renegotiated */
+  if (prop_id == PROP_NORMALIZE)
+    gst_base_transform_reconfigure_src (GST_BASE_TRANSFORM (filt));
+  else if (configured)
+    gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (filt), identity);
+}
+
+static void
+gst_bayer_normalize_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstBayerNormalize *filt = GST_BAYER_NORMALIZE (object);
+
+  GST_DEBUG_OBJECT (filt, "getting property %s", pspec->name);
+
+  GST_OBJECT_LOCK (filt);
+  switch (prop_id) {
+    case PROP_BLACK_LEVEL_RED:
+    case PROP_BLACK_LEVEL_GREEN_RED:
+    case PROP_BLACK_LEVEL_GREEN_BLUE:
+    case PROP_BLACK_LEVEL_BLUE:
+      g_value_set_uint (value,
+          filt->black_level[prop_id - PROP_BLACK_LEVEL_RED]);
+      break;
+    case PROP_GAIN_RED:
+    case PROP_GAIN_GREEN_RED:
+    case PROP_GAIN_GREEN_BLUE:
+    case PROP_GAIN_BLUE:
+      g_value_set_double (value, filt->gain[prop_id - PROP_GAIN_RED]);
+      break;
+    case PROP_NORMALIZE:
+      g_value_set_boolean (value, filt->normalize);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+  GST_OBJECT_UNLOCK (filt);
+}
+
+/************************************************************************/
+/* GstBaseTransform vmethod implementations                             */
+/************************************************************************/
+
+static GstCaps *
+gst_bayer_normalize_transform_caps (GstBaseTransform * trans,
+    GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps)
+{
+  GstBayerNormalize *filt = GST_BAYER_NORMALIZE (trans);
+  GstCaps *normalized_caps, *other_caps, *bayer16_caps;
+  const GValue *any_bpp;
+  gboolean normalize;
+  guint i, n;
+
+  GST_LOG_OBJECT (filt, "transforming caps from %" GST_PTR_FORMAT, caps);
+
+  GST_OBJECT_LOCK (filt);
+  normalize = filt->normalize;
+  GST_OBJECT_UNLOCK (filt);
+
+  if (!normalize) {
+    other_caps = gst_caps_ref (caps);
+  } else {
+    /* 16-bit samples are always output with 16 significant bits, which
+     * could have come from any depth */
+    other_caps = gst_caps_new_empty ();
+    normalized_caps = gst_caps_normalize (gst_caps_ref (caps));
+    bayer16_caps = gst_caps_from_string (VIDEO_CAPS_BAYER16);
+    any_bpp =
+        gst_structure_get_value (gst_caps_get_structure (bayer16_caps, 0),
+        "bpp");
+
+    n = gst_caps_get_size (normalized_caps);
+    for (i = 0; i < n; ++i) {
+      GstStructure *s =
+          gst_structure_copy (gst_caps_get_structure (normalized_caps, i));
+      const gchar *format = gst_structure_get_string (s, "format");
+
+      if (format && g_str_has_suffix (format, "16")) {
+        if (direction == GST_PAD_SINK)
+          gst_structure_set (s, "bpp", G_TYPE_INT, 16, NULL);
+        else
+          gst_structure_set_value (s, "bpp", any_bpp);
+      }
+      other_caps = gst_caps_merge_structure (other_caps, s);
+    }
+
+    gst_caps_unref (bayer16_caps);
+    gst_caps_unref (normalized_caps);
+  }
+
+  if (!gst_caps_is_empty (other_caps) && filter_caps) {
+    GstCaps *tmp = gst_caps_intersect_full (filter_caps, other_caps,
+        GST_CAPS_INTERSECT_FIRST);
+    gst_caps_replace (&other_caps, tmp);
+    gst_caps_unref (tmp);
+  }
+
+  GST_LOG_OBJECT (filt, "transformed caps to %" GST_PTR_FORMAT, other_caps);
+
+  return other_caps;
+}
+
+static gboolean
+gst_bayer_normalize_set_caps (GstBaseTransform * btrans, GstCaps * incaps,
+    GstCaps * outcaps)
+{
+  GstBayerNormalize *filt = GST_BAYER_NORMALIZE (btrans);
+  GstBayerInfo info, info_out;
+  gboolean identity;
+
+  GST_DEBUG_OBJECT (filt,
+      "set_caps: in '%" GST_PTR_FORMAT "' out '%" GST_PTR_FORMAT "'", incaps,
+      outcaps);
+
+  if (!gst_bayer_info_from_caps (&info, incaps)) {
+    GST_ERROR_OBJECT (filt, "Failed to parse caps %" GST_PTR_FORMAT, incaps);
+    return FALSE;
+  }
+  if (!gst_bayer_info_from_caps (&info_out, outcaps)) {
+    GST_ERROR_OBJECT (filt, "Failed to parse caps %" GST_PTR_FORMAT, outcaps);
+    return FALSE;
+  }
+
+  GST_OBJECT_LOCK (filt);
+  filt->info_in = info;
+  filt->bpp_out = info_out.bpp;
+  identity = gst_bayer_normalize_update (filt);
+  GST_OBJECT_UNLOCK (filt);
+
+  gst_base_transform_set_passthrough (btrans, identity);
+
+  return TRUE;
+}
+
+static GstFlowReturn
+gst_bayer_normalize_transform_ip (GstBaseTransform * btrans, GstBuffer * buf)
+{
+  GstBayerNormalize *filt = GST_BAYER_NORMALIZE (btrans);
+  const GstBayerInfo *info = &filt->info_in;
+  GstVideoMeta *meta;
+  GstMapInfo minfo;
+  guint8 *data;
+  gint stride, y;
+  gsize needed;
+  gint black[4], gain[4];
+  gint shift, max;
+
+  if (!gst_buffer_map (buf, &minfo, GST_MAP_READWRITE)) {
+    GST_ELEMENT_ERROR (filt, RESOURCE, READ, (NULL),
+        ("Failed to map buffer"));
+    return GST_FLOW_ERROR;
+  }
+
+  meta = gst_buffer_get_video_meta (buf);
+  data = minfo.data + (meta ? meta->offset[0] : 0);
+  stride = meta ? meta->stride[0] : info->stride;
+
+  needed = (data - minfo.data) + (gsize) stride * (info->height - 1) +
+      info->width * info->depth / 8;
+  if (minfo.size < needed) {
+    gst_buffer_unmap (buf, &minfo);
+    GST_ELEMENT_ERROR (filt, STREAM, FORMAT, (NULL),
+        ("Buffer too small, %" G_GSIZE_FORMAT " bytes instead of %"
+            G_GSIZE_FORMAT, minfo.size, needed));
+    return GST_FLOW_ERROR;
+  }
+
+  /* snapshot the levels, so changing them can't tear the frame but also
+   * doesn't wait for it */
+  GST_OBJECT_LOCK (filt);
+  memcpy (black, filt->black, sizeof (black));
+  memcpy (gain, filt->gain_fixed, sizeof (gain));
+  shift = filt->shift;
+  max = filt->max;
+  GST_OBJECT_UNLOCK (filt);
+
+  for (y = 0; y < info->height; y++) {
+    guint8 *row = data + (gsize) y * stride;
+    const gint k = GST_BAYER_INFO_CFA_INDEX (0, y);
+
+    if (info->depth == 8)
+      filt->normalize8 (row, row, info->width, black + k, gain + k, shift,
+          max);
+    else
+      filt->normalize16 ((guint16 *) row, (const guint16 *) row, info->width,
+          black + k, gain + k, shift, max, info->swap);
+  }
+
+  gst_buffer_unmap (buf, &minfo);
+
+  return GST_FLOW_OK;
+}
+
+/************************************************************************/
+/* GstBayerNormalize method implementations                             */
+/************************************************************************/
+
+/* translate the properties for each CFA position, called with the object
+ * lock held, returns whether frames would be unchanged */
+static gboolean
+gst_bayer_normalize_update (GstBayerNormalize * filt)
+{
+  const GstBayerInfo *info = &filt->info_in;
+  gboolean identity;
+  gint lshift, k;
+
+  if (info->width == 0)
+    return FALSE;
+
+  /* the requested depth only applies once downstream has accepted it */
+  lshift = filt->bpp_out - info->bpp;
+  filt->shift = GST_BAYER_NORMALIZE_SHIFT - lshift;
+  filt->max = (1 << (info->bpp + lshift)) - 1;
+  identity = lshift == 0;
+
+  for (k = 0; k < 4; k++) {
+    const GstBayerColor color = info->cfa[k];
+    GstBayerNormalizeSite site;
+
+    if (color == GST_BAYER_COLOR_RED)
+      site = GST_BAYER_NORMALIZE_SITE_RED;
+    else if (color == GST_BAYER_COLOR_BLUE)
+      site = GST_BAYER_NORMALIZE_SITE_BLUE;
+    else if (info->cfa[k ^ 1] == GST_BAYER_COLOR_RED)
+      site = GST_BAYER_NORMALIZE_SITE_GREEN_RED;
+    else
+      site = GST_BAYER_NORMALIZE_SITE_GREEN_BLUE;
+
+    /* black is subtracted from input samples, so limit it to their range */
+    filt->black[k] = MIN (filt->black_level[site],
+        (guint) (1 << info->bpp) - 1);
+    filt->gain_fixed[k] = (gint) (filt->gain[site] *
+        (1 << GST_BAYER_NORMALIZE_SHIFT) + 0.5);
+    identity = identity && filt->black[k] == 0 &&
+        filt->gain_fixed[k] == 1 << GST_BAYER_NORMALIZE_SHIFT;
+  }
+
+  return identity;
+}
@@ -0,0 +1,94 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_BAYER_NORMALIZE_H__
+#define __GST_BAYER_NORMALIZE_H__
+
+#include <gst/base/gstbasetransform.h>
+#include <gst/video/video.h>
+
+#include "gstbayerutils.h"
+#include "gstbayersimd.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_BAYER_NORMALIZE \
+  (gst_bayer_normalize_get_type())
+#define GST_BAYER_NORMALIZE(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_BAYER_NORMALIZE,GstBayerNormalize))
+#define GST_BAYER_NORMALIZE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_BAYER_NORMALIZE,GstBayerNormalizeClass))
+#define GST_IS_BAYER_NORMALIZE(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_BAYER_NORMALIZE))
+#define GST_IS_BAYER_NORMALIZE_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_BAYER_NORMALIZE))
+
+typedef struct _GstBayerNormalize GstBayerNormalize;
+typedef struct _GstBayerNormalizeClass GstBayerNormalizeClass;
+
+/* CFA sites, the green samples told apart by the color sharing their row */
+typedef enum {
+  GST_BAYER_NORMALIZE_SITE_RED,
+  GST_BAYER_NORMALIZE_SITE_GREEN_RED,
+  GST_BAYER_NORMALIZE_SITE_GREEN_BLUE,
+  GST_BAYER_NORMALIZE_SITE_BLUE,
+  GST_BAYER_NORMALIZE_N_SITES
+} GstBayerNormalizeSite;
+
+/**
+* GstBayerNormalize:
+* @element: the parent element.
+*
+*
+* The opaque GstBayerNormalize data structure.
+*/
+struct _GstBayerNormalize
+{
+  GstBaseTransform element;
+
+  /* properties, by GstBayerNormalizeSite */
+  guint black_level[GST_BAYER_NORMALIZE_N_SITES];
+  gdouble gain[GST_BAYER_NORMALIZE_N_SITES];
+  gboolean normalize;
+
+  /* format, and the significant output bits negotiated for it, which only
+   * follow normalize once the caps have been renegotiated */
+  GstBayerInfo info_in;
+  gint bpp_out;
+
+  /* black level and fixed-point gain by GST_BAYER_INFO_CFA_INDEX */
+  gint black[4];
+  gint gain_fixed[4];
+  gint shift;
+  gint max;
+  GstBayerNormalize8Func normalize8;
+  GstBayerNormalize16Func normalize16;
+};
+
+struct _GstBayerNormalizeClass
+{
+  GstBaseTransformClass parent_class;
+};
+
+GType gst_bayer_normalize_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_BAYER_NORMALIZE_H__ */
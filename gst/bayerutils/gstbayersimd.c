@@ -0,0 +1,675 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Vectorized kernels for bayerutils.
+ *
+ * The demosaic kernel widens samples to 32-bit lanes, where even and odd
+ * columns use alternating coefficients, so one set of vectors covers both
+ * filters of a row. The arithmetic matches the scalar loop exactly.
+ *
+ * The binning kernels read the two samples of each quad row as one 32-bit
+ * lane and split them with a mask and a shift, so the weighted sums are
+ * computed in 32 bits like the scalar loop.
+ *
+ * The normalize kernels subtract the black level with saturation in 16-bit
+ * lanes, then widen to 32 bits for the gain, as the scalar loop does.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstbayersimd.h"
+
+static void
+demosaic_scalar (guint16 * out[3], const guint16 * rows[5], gint width,
+    const gint coefs[3][2][GST_BAYER_DEMOSAIC_N_TERMS], gint max,
+    gint rshift, gint lshift)
+{
+  const gint round = 1 << (GST_BAYER_DEMOSAIC_SHIFT - 1);
+  const guint16 *r0 = rows[0], *r1 = rows[1], *r2 = rows[2];
+  const guint16 *r3 = rows[3], *r4 = rows[4];
+  gint c, k, x;
+
+  for (x = 0; x < width; x++) {
+    gint t[GST_BAYER_DEMOSAIC_N_TERMS];
+
+    t[GST_BAYER_DEMOSAIC_CENTER] = r2[x];
+    t[GST_BAYER_DEMOSAIC_H1] = r2[x - 1] + r2[x + 1];
+    t[GST_BAYER_DEMOSAIC_V1] = r1[x] + r3[x];
+    t[GST_BAYER_DEMOSAIC_DIAGONAL] = r1[x - 1] + r1[x + 1] + r3[x - 1] +
+        r3[x + 1];
+    t[GST_BAYER_DEMOSAIC_H2] = r2[x - 2] + r2[x + 2];
+    t[GST_BAYER_DEMOSAIC_V2] = r0[x] + r4[x];
+
+    for (c = 0; c < 3; c++) {
+      const gint *coef = coefs[c][x & 1];
+      gint v = 0;
+
+      for (k = 0; k < GST_BAYER_DEMOSAIC_N_TERMS; k++)
+        v += coef[k] * t[k];
+      v = (v + round) >> GST_BAYER_DEMOSAIC_SHIFT;
+      v = CLAMP (v, 0, max);
+      out[c][x] = (v >> rshift) << lshift;
+    }
+  }
+}
+
+#define BIN_SCALAR(name,type)                                                 \
+static void                                                                   \
+name (guint16 * out[3], gint n_out, const type * row0, const type * row1,     \
+    gint width, const gint weights[3][4], gint shift, gint max)               \
+{                                                                             \
+  const guint round = shift ? 1u << (shift - 1) : 0;                         \
+  gint c, x;                                                                  \
+                                                                              \
+  for (c = 0; c < n_out; c++) {                                               \
+    const gint *w = weights[c];                                               \
+    for (x = 0; x < width; x++) {                                             \
+      guint v = (guint) w[0] * row0[2 * x] + (guint) w[1] * row0[2 * x + 1] + \
+          (guint) w[2] * row1[2 * x] + (guint) w[3] * row1[2 * x + 1];        \
+      v = (v + round) >> shift;                                               \
+      out[c][x] = MIN (v, (guint) max);                                       \
+    }                                                                         \
+  }                                                                           \
+}
+
+BIN_SCALAR (bin8_scalar, guint8)
+BIN_SCALAR (bin16_scalar, guint16)
+
+static void
+normalize8_scalar (guint8 * dst, const guint8 * src, gint width,
+    const gint black[2], const gint gain[2], gint shift, gint max)
+{
+  const guint round = shift ? 1u << (shift - 1) : 0;
+  gint x;
+
+  for (x = 0; x < width; x++) {
+    const gint b = black[x & 1];
+    guint v = src[x] > b ? src[x] - b : 0;
+    v = (v * (guint) gain[x & 1] + round) >> shift;
+    dst[x] = MIN (v, (guint) max);
+  }
+}
+
+static void
+normalize16_scalar (guint16 * dst, const guint16 * src, gint width,
+    const gint black[2], const gint gain[2], gint shift, gint max,
+    gboolean swap)
+{
+  const guint round = shift ? 1u << (shift - 1) : 0;
+  gint x;
+
+  for (x = 0; x < width; x++) {
+    const gint b = black[x & 1];
+    guint v = swap ? GUINT16_SWAP_LE_BE (src[x]) : src[x];
+    v = v > (guint) b ? v - b : 0;
+    v = MIN ((v * (guint) gain[x & 1] + round) >> shift, (guint) max);
+    dst[x] = swap ? GUINT16_SWAP_LE_BE ((guint16) v) : v;
+  }
+}
+
+#ifdef HAVE_X86_SIMD
+
+TARGET_SSE41 static inline __m128i
+load4_sse41 (const guint16 * p)
+{
+  return _mm_cvtepu16_epi32 (_mm_loadl_epi64 ((const __m128i *) p));
+}
+
+TARGET_SSE41 static void
+demosaic_sse41 (guint16 * out[3], const guint16 * rows[5], gint width,
+    const gint coefs[3][2][GST_BAYER_DEMOSAIC_N_TERMS], gint max,
+    gint rshift, gint lshift)
+{
+  const guint16 *r0 = rows[0], *r1 = rows[1], *r2 = rows[2];
+  const guint16 *r3 = rows[3], *r4 = rows[4];
+  const __m128i round = _mm_set1_epi32 (1 << (GST_BAYER_DEMOSAIC_SHIFT - 1));
+  const __m128i zero = _mm_setzero_si128 ();
+  const __m128i maxv = _mm_set1_epi32 (max);
+  const __m128i rs = _mm_cvtsi32_si128 (rshift);
+  const __m128i ls = _mm_cvtsi32_si128 (lshift);
+  __m128i cv[3][GST_BAYER_DEMOSAIC_N_TERMS];
+  gboolean used[3][GST_BAYER_DEMOSAIC_N_TERMS];
+  gint c, k, x;
+
+  for (c = 0; c < 3; c++) {
+    for (k = 0; k < GST_BAYER_DEMOSAIC_N_TERMS; k++) {
+      cv[c][k] = _mm_setr_epi32 (coefs[c][0][k], coefs[c][1][k],
+          coefs[c][0][k], coefs[c][1][k]);
+      used[c][k] = coefs[c][0][k] != 0 || coefs[c][1][k] != 0;
+    }
+  }
+
+  for (x = 0; x + 4 <= width; x += 4) {
+    __m128i t[GST_BAYER_DEMOSAIC_N_TERMS];
+
+    t[GST_BAYER_DEMOSAIC_CENTER] = load4_sse41 (r2 + x);
+    t[GST_BAYER_DEMOSAIC_H1] = _mm_add_epi32 (load4_sse41 (r2 + x - 1),
+        load4_sse41 (r2 + x + 1));
+    t[GST_BAYER_DEMOSAIC_V1] = _mm_add_epi32 (load4_sse41 (r1 + x),
+        load4_sse41 (r3 + x));
+    t[GST_BAYER_DEMOSAIC_DIAGONAL] =
+        _mm_add_epi32 (_mm_add_epi32 (load4_sse41 (r1 + x - 1),
+            load4_sse41 (r1 + x + 1)), _mm_add_epi32 (load4_sse41 (r3 + x - 1),
+            load4_sse41 (r3 + x + 1)));
+    t[GST_BAYER_DEMOSAIC_H2] = _mm_add_epi32 (load4_sse41 (r2 + x - 2),
+        load4_sse41 (r2 + x + 2));
+    t[GST_BAYER_DEMOSAIC_V2] = _mm_add_epi32 (load4_sse41 (r0 + x),
+        load4_sse41 (r4 + x));
+
+    for (c = 0; c < 3; c++) {
+      __m128i acc = round;
+
+      for (k = 0; k < GST_BAYER_DEMOSAIC_N_TERMS; k++) {
+        if (used[c][k])
+          acc = _mm_add_epi32 (acc, _mm_mullo_epi32 (t[k], cv[c][k]));
+      }
+      acc = _mm_srai_epi32 (acc, GST_BAYER_DEMOSAIC_SHIFT);
+      acc = _mm_min_epi32 (_mm_max_epi32 (acc, zero), maxv);
+      acc = _mm_sll_epi32 (_mm_srl_epi32 (acc, rs), ls);
+      _mm_storel_epi64 ((__m128i *) (out[c] + x), _mm_packus_epi32 (acc, acc));
+    }
+  }
+
+  if (x < width) {
+    guint16 *tail[3] = { out[0] + x, out[1] + x, out[2] + x };
+    const guint16 *tail_rows[5] = { r0 + x, r1 + x, r2 + x, r3 + x, r4 + x };
+
+    /* x is a multiple of four, so column parity is unchanged */
+    demosaic_scalar (tail, tail_rows, width - x, coefs, max, rshift, lshift);
+  }
+}
+
+TARGET_AVX2 static inline __m256i
+load8_avx2 (const guint16 * p)
+{
+  return _mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const __m128i *) p));
+}
+
+TARGET_AVX2 static void
+demosaic_avx2 (guint16 * out[3], const guint16 * rows[5], gint width,
+    const gint coefs[3][2][GST_BAYER_DEMOSAIC_N_TERMS], gint max,
+    gint rshift, gint lshift)
+{
+  const guint16 *r0 = rows[0], *r1 = rows[1], *r2 = rows[2];
+  const guint16 *r3 = rows[3], *r4 = rows[4];
+  const __m256i round =
+      _mm256_set1_epi32 (1 << (GST_BAYER_DEMOSAIC_SHIFT - 1));
+  const __m256i zero = _mm256_setzero_si256 ();
+  const __m256i maxv = _mm256_set1_epi32 (max);
+  const __m128i rs = _mm_cvtsi32_si128 (rshift);
+  const __m128i ls = _mm_cvtsi32_si128 (lshift);
+  __m256i cv[3][GST_BAYER_DEMOSAIC_N_TERMS];
+  gboolean used[3][GST_BAYER_DEMOSAIC_N_TERMS];
+  gint c, k, x;
+
+  for (c = 0; c < 3; c++) {
+    for (k = 0; k < GST_BAYER_DEMOSAIC_N_TERMS; k++) {
+      const gint e = coefs[c][0][k], o = coefs[c][1][k];
+      cv[c][k] = _mm256_setr_epi32 (e, o, e, o, e, o, e, o);
+      used[c][k] = e != 0 || o != 0;
+    }
+  }
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m256i t[GST_BAYER_DEMOSAIC_N_TERMS];
+
+    t[GST_BAYER_DEMOSAIC_CENTER] = load8_avx2 (r2 + x);
+    t[GST_BAYER_DEMOSAIC_H1] = _mm256_add_epi32 (load8_avx2 (r2 + x - 1),
+        load8_avx2 (r2 + x + 1));
+    t[GST_BAYER_DEMOSAIC_V1] = _mm256_add_epi32 (load8_avx2 (r1 + x),
+        load8_avx2 (r3 + x));
+    t[GST_BAYER_DEMOSAIC_DIAGONAL] =
+        _mm256_add_epi32 (_mm256_add_epi32 (load8_avx2 (r1 + x - 1),
+            load8_avx2 (r1 + x + 1)), _mm256_add_epi32 (load8_avx2 (r3 + x -
+                1), load8_avx2 (r3 + x + 1)));
+    t[GST_BAYER_DEMOSAIC_H2] = _mm256_add_epi32 (load8_avx2 (r2 + x - 2),
+        load8_avx2 (r2 + x + 2));
+    t[GST_BAYER_DEMOSAIC_V2] = _mm256_add_epi32 (load8_avx2 (r0 + x),
+        load8_avx2 (r4 + x));
+
+    for (c = 0; c < 3; c++) {
+      __m256i acc = round;
+
+      for (k = 0; k < GST_BAYER_DEMOSAIC_N_TERMS; k++) {
+        if (used[c][k])
+          acc = _mm256_add_epi32 (acc, _mm256_mullo_epi32 (t[k], cv[c][k]));
+      }
+      acc = _mm256_srai_epi32 (acc, GST_BAYER_DEMOSAIC_SHIFT);
+      acc = _mm256_min_epi32 (_mm256_max_epi32 (acc, zero), maxv);
+      acc = _mm256_sll_epi32 (_mm256_srl_epi32 (acc, rs), ls);
+      /* packing works within 128-bit lanes, gather the low halves */
+      acc = _mm256_permute4x64_epi64 (_mm256_packus_epi32 (acc, acc),
+          _MM_SHUFFLE (3, 1, 2, 0));
+      _mm_storeu_si128 ((__m128i *) (out[c] + x),
+          _mm256_castsi256_si128 (acc));
+    }
+  }
+
+  if (x < width) {
+    guint16 *tail[3] = { out[0] + x, out[1] + x, out[2] + x };
+    const guint16 *tail_rows[5] = { r0 + x, r1 + x, r2 + x, r3 + x, r4 + x };
+
+    /* x is a multiple of eight, so column parity is unchanged */
+    demosaic_scalar (tail, tail_rows, width - x, coefs, max, rshift, lshift);
+  }
+}
+
+/* weighted sums of four quads, each 32-bit lane of q0 and q1 holding the
+ * two samples of one quad row */
+TARGET_SSE41 static inline void
+bin_quads_sse41 (guint16 * out[3], gint n_out, gint x, __m128i q0,
+    __m128i q1, const __m128i wv[3][4], const gboolean used[3][4],
+    __m128i round, __m128i shift, __m128i maxv)
+{
+  const __m128i mask = _mm_set1_epi32 (0xffff);
+  __m128i s[4];
+  gint c, k;
+
+  s[0] = _mm_and_si128 (q0, mask);
+  s[1] = _mm_srli_epi32 (q0, 16);
+  s[2] = _mm_and_si128 (q1, mask);
+  s[3] = _mm_srli_epi32 (q1, 16);
+
+  for (c = 0; c < n_out; c++) {
+    __m128i acc = round;
+    for (k = 0; k < 4; k++) {
+      if (used[c][k])
+        acc = _mm_add_epi32 (acc, _mm_mullo_epi32 (s[k], wv[c][k]));
+    }
+    acc = _mm_min_epu32 (_mm_srl_epi32 (acc, shift), maxv);
+    _mm_storel_epi64 ((__m128i *) (out[c] + x), _mm_packus_epi32 (acc, acc));
+  }
+}
+
+#define BIN_SETUP(set1,type)                                                  \
+  const type round = set1 (shift ? 1 << (shift - 1) : 0);                     \
+  const type maxv = set1 (max);                                               \
+  const __m128i shiftv = _mm_cvtsi32_si128 (shift);                           \
+  type wv[3][4];                                                              \
+  gboolean used[3][4];                                                        \
+  gint c, k, x;                                                               \
+                                                                              \
+  for (c = 0; c < n_out; c++) {                                               \
+    for (k = 0; k < 4; k++) {                                                 \
+      wv[c][k] = set1 (weights[c][k]);                                        \
+      used[c][k] = weights[c][k] != 0;                                        \
+    }                                                                         \
+  }
+
+#define BIN_TAIL(scalar)                                                      \
+  if (x < width) {                                                            \
+    guint16 *tail[3] = { out[0] + x, NULL, NULL };                            \
+    for (c = 1; c < n_out; c++)                                               \
+      tail[c] = out[c] + x;                                                   \
+    scalar (tail, n_out, row0 + 2 * x, row1 + 2 * x, width - x, weights,      \
+        shift, max);                                                          \
+  }
+
+TARGET_SSE41 static void
+bin8_sse41 (guint16 * out[3], gint n_out, const guint8 * row0,
+    const guint8 * row1, gint width, const gint weights[3][4], gint shift,
+    gint max)
+{
+  BIN_SETUP (_mm_set1_epi32, __m128i);
+
+  for (x = 0; x + 4 <= width; x += 4) {
+    __m128i q0 = _mm_cvtepu8_epi16 (_mm_loadl_epi64 ((const __m128i *)
+            (row0 + 2 * x)));
+    __m128i q1 = _mm_cvtepu8_epi16 (_mm_loadl_epi64 ((const __m128i *)
+            (row1 + 2 * x)));
+    bin_quads_sse41 (out, n_out, x, q0, q1, (const __m128i (*)[4]) wv,
+        (const gboolean (*)[4]) used, round, shiftv, maxv);
+  }
+
+  BIN_TAIL (bin8_scalar);
+}
+
+TARGET_SSE41 static void
+bin16_sse41 (guint16 * out[3], gint n_out, const guint16 * row0,
+    const guint16 * row1, gint width, const gint weights[3][4], gint shift,
+    gint max)
+{
+  BIN_SETUP (_mm_set1_epi32, __m128i);
+
+  for (x = 0; x + 4 <= width; x += 4) {
+    __m128i q0 = _mm_loadu_si128 ((const __m128i *) (row0 + 2 * x));
+    __m128i q1 = _mm_loadu_si128 ((const __m128i *) (row1 + 2 * x));
+    bin_quads_sse41 (out, n_out, x, q0, q1, (const __m128i (*)[4]) wv,
+        (const gboolean (*)[4]) used, round, shiftv, maxv);
+  }
+
+  BIN_TAIL (bin16_scalar);
+}
+
+TARGET_AVX2 static inline void
+bin_quads_avx2 (guint16 * out[3], gint n_out, gint x, __m256i q0,
+    __m256i q1, const __m256i wv[3][4], const gboolean used[3][4],
+    __m256i round, __m128i shift, __m256i maxv)
+{
+  const __m256i mask = _mm256_set1_epi32 (0xffff);
+  __m256i s[4];
+  gint c, k;
+
+  s[0] = _mm256_and_si256 (q0, mask);
+  s[1] = _mm256_srli_epi32 (q0, 16);
+  s[2] = _mm256_and_si256 (q1, mask);
+  s[3] = _mm256_srli_epi32 (q1, 16);
+
+  for (c = 0; c < n_out; c++) {
+    __m256i acc = round;
+    for (k = 0; k < 4; k++) {
+      if (used[c][k])
+        acc = _mm256_add_epi32 (acc, _mm256_mullo_epi32 (s[k], wv[c][k]));
+    }
+    acc = _mm256_min_epu32 (_mm256_srl_epi32 (acc, shift), maxv);
+    /* packing works within 128-bit lanes, gather the low halves */
+    acc = _mm256_permute4x64_epi64 (_mm256_packus_epi32 (acc, acc),
+        _MM_SHUFFLE (3, 1, 2, 0));
+    _mm_storeu_si128 ((__m128i *) (out[c] + x), _mm256_castsi256_si128 (acc));
+  }
+}
+
+TARGET_AVX2 static void
+bin8_avx2 (guint16 * out[3], gint n_out, const guint8 * row0,
+    const guint8 * row1, gint width, const gint weights[3][4], gint shift,
+    gint max)
+{
+  BIN_SETUP (_mm256_set1_epi32, __m256i);
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m256i q0 = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *)
+            (row0 + 2 * x)));
+    __m256i q1 = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *)
+            (row1 + 2 * x)));
+    bin_quads_avx2 (out, n_out, x, q0, q1, (const __m256i (*)[4]) wv,
+        (const gboolean (*)[4]) used, round, shiftv, maxv);
+  }
+
+  BIN_TAIL (bin8_scalar);
+}
+
+TARGET_AVX2 static void
+bin16_avx2 (guint16 * out[3], gint n_out, const guint16 * row0,
+    const guint16 * row1, gint width, const gint weights[3][4], gint shift,
+    gint max)
+{
+  BIN_SETUP (_mm256_set1_epi32, __m256i);
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m256i q0 = _mm256_loadu_si256 ((const __m256i *) (row0 + 2 * x));
+    __m256i q1 = _mm256_loadu_si256 ((const __m256i *) (row1 + 2 * x));
+    bin_quads_avx2 (out, n_out, x, q0, q1, (const __m256i (*)[4]) wv,
+        (const gboolean (*)[4]) used, round, shiftv, maxv);
+  }
+
+  BIN_TAIL (bin16_scalar);
+}
+
+
+#define NORMALIZE_SETUP(type,set1,setr16,setr32)                              \
+  const type blackv = setr16 (black[0], black[1]);                            \
+  const type gainv = setr32 (gain[0], gain[1]);                               \
+  const type round = set1 (shift ? 1 << (shift - 1) : 0);                     \
+  const type maxv = set1 (max);                                               \
+  const __m128i shiftv = _mm_cvtsi32_si128 (shift);                           \
+  gint x
+
+#define SETR16_SSE41(a,b) _mm_setr_epi16 (a, b, a, b, a, b, a, b)
+#define SETR32_SSE41(a,b) _mm_setr_epi32 (a, b, a, b)
+#define SETR16_AVX2(a,b) _mm256_setr_epi16 (a, b, a, b, a, b, a, b, \
+    a, b, a, b, a, b, a, b)
+#define SETR32_AVX2(a,b) _mm256_setr_epi32 (a, b, a, b, a, b, a, b)
+
+/* eight 16-bit samples starting at an even column */
+TARGET_SSE41 static inline __m128i
+normalize_sse41 (__m128i v, __m128i blackv, __m128i gainv, __m128i round,
+    __m128i shift, __m128i maxv)
+{
+  const __m128i zero = _mm_setzero_si128 ();
+  __m128i lo, hi;
+
+  v = _mm_subs_epu16 (v, blackv);
+  lo = _mm_add_epi32 (_mm_mullo_epi32 (_mm_unpacklo_epi16 (v, zero), gainv),
+      round);
+  hi = _mm_add_epi32 (_mm_mullo_epi32 (_mm_unpackhi_epi16 (v, zero), gainv),
+      round);
+  lo = _mm_min_epu32 (_mm_srl_epi32 (lo, shift), maxv);
+  hi = _mm_min_epu32 (_mm_srl_epi32 (hi, shift), maxv);
+  return _mm_packus_epi32 (lo, hi);
+}
+
+TARGET_SSE41 static void
+normalize8_sse41 (guint8 * dst, const guint8 * src, gint width,
+    const gint black[2], const gint gain[2], gint shift, gint max)
+{
+  NORMALIZE_SETUP (__m128i, _mm_set1_epi32, SETR16_SSE41, SETR32_SSE41);
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m128i v = _mm_cvtepu8_epi16 (_mm_loadl_epi64 ((const __m128i *)
+            (src + x)));
+    v = normalize_sse41 (v, blackv, gainv, round, shiftv, maxv);
+    _mm_storel_epi64 ((__m128i *) (dst + x), _mm_packus_epi16 (v, v));
+  }
+
+  if (x < width)
+    normalize8_scalar (dst + x, src + x, width - x, black, gain, shift, max);
+}
+
+TARGET_SSE41 static void
+normalize16_sse41 (guint16 * dst, const guint16 * src, gint width,
+    const gint black[2], const gint gain[2], gint shift, gint max,
+    gboolean swap)
+{
+  NORMALIZE_SETUP (__m128i, _mm_set1_epi32, SETR16_SSE41, SETR32_SSE41);
+  const __m128i swap_mask = _mm_setr_epi8 (1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11,
+      10, 13, 12, 15, 14);
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + x));
+    if (swap)
+      v = _mm_shuffle_epi8 (v, swap_mask);
+    v = normalize_sse41 (v, blackv, gainv, round, shiftv, maxv);
+    if (swap)
+      v = _mm_shuffle_epi8 (v, swap_mask);
+    _mm_storeu_si128 ((__m128i *) (dst + x), v);
+  }
+
+  if (x < width)
+    normalize16_scalar (dst + x, src + x, width - x, black, gain, shift, max,
+        swap);
+}
+
+/* sixteen 16-bit samples starting at an even column */
+TARGET_AVX2 static inline __m256i
+normalize_avx2 (__m256i v, __m256i blackv, __m256i gainv, __m256i round,
+    __m128i shift, __m256i maxv)
+{
+  const __m256i zero = _mm256_setzero_si256 ();
+  __m256i lo, hi;
+
+  v = _mm256_subs_epu16 (v, blackv);
+  lo = _mm256_add_epi32 (_mm256_mullo_epi32 (_mm256_unpacklo_epi16 (v, zero),
+          gainv), round);
+  hi = _mm256_add_epi32 (_mm256_mullo_epi32 (_mm256_unpackhi_epi16 (v, zero),
+          gainv), round);
+  lo = _mm256_min_epu32 (_mm256_srl_epi32 (lo, shift), maxv);
+  hi = _mm256_min_epu32 (_mm256_srl_epi32 (hi, shift), maxv);
+  /* unpacking and packing within 128-bit lanes keeps the sample order */
+  return _mm256_packus_epi32 (lo, hi);
+}
+
+TARGET_AVX2 static void
+normalize8_avx2 (guint8 * dst, const guint8 * src, gint width,
+    const gint black[2], const gint gain[2], gint shift, gint max)
+{
+  NORMALIZE_SETUP (__m256i, _mm256_set1_epi32, SETR16_AVX2,
+      SETR32_AVX2);
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    __m256i v = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *)
+            (src + x)));
+    v = normalize_avx2 (v, blackv, gainv, round, shiftv, maxv);
+    v = _mm256_permute4x64_epi64 (_mm256_packus_epi16 (v, v),
+        _MM_SHUFFLE (3, 1, 2, 0));
+    _mm_storeu_si128 ((__m128i *) (dst + x), _mm256_castsi256_si128 (v));
+  }
+
+  if (x < width)
+    normalize8_scalar (dst + x, src + x, width - x, black, gain, shift, max);
+}
+
+TARGET_AVX2 static void
+normalize16_avx2 (guint16 * dst, const guint16 * src, gint width,
+    const gint black[2], const gint gain[2], gint shift, gint max,
+    gboolean swap)
+{
+  NORMALIZE_SETUP (__m256i, _mm256_set1_epi32, SETR16_AVX2,
+      SETR32_AVX2);
+  const __m256i swap_mask = _mm256_setr_epi8 (1, 0, 3, 2, 5, 4, 7, 6, 9, 8,
+      11, 10, 13, 12, 15, 14, 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12,
+      15, 14);
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) (src + x));
+    if (swap)
+      v = _mm256_shuffle_epi8 (v, swap_mask);
+    v = normalize_avx2 (v, blackv, gainv, round, shiftv, maxv);
+    if (swap)
+      v = _mm256_shuffle_epi8 (v, swap_mask);
+    _mm256_storeu_si256 ((__m256i *) (dst + x), v);
+  }
+
+  if (x < width)
+    normalize16_scalar (dst + x, src + x, width - x, black, gain, shift, max,
+        swap);
+}
+
+#endif /* HAVE_X86_SIMD */
+
+/**
+ * gst_bayer_simd_get_demosaic_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the demosaic row kernel for @level, falling back to a scalar loop
+ */
+GstBayerDemosaicFunc
+gst_bayer_simd_get_demosaic_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return demosaic_avx2;
+    case GST_SIMD_SSE41:
+      return demosaic_sse41;
+#endif
+    default:
+      return demosaic_scalar;
+  }
+}
+
+/**
+ * gst_bayer_simd_get_bin8_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 8-bit 2x2 binning kernel for @level, falling back to a scalar
+ * loop
+ */
+GstBayerBin8Func
+gst_bayer_simd_get_bin8_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return bin8_avx2;
+    case GST_SIMD_SSE41:
+      return bin8_sse41;
+#endif
+    default:
+      return bin8_scalar;
+  }
+}
+
+/**
+ * gst_bayer_simd_get_bin16_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 16-bit 2x2 binning kernel for @level, falling back to a scalar
+ * loop
+ */
+GstBayerBin16Func
+gst_bayer_simd_get_bin16_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return bin16_avx2;
+    case GST_SIMD_SSE41:
+      return bin16_sse41;
+#endif
+    default:
+      return bin16_scalar;
+  }
+}
+
+/**
+ * gst_bayer_simd_get_normalize8_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 8-bit normalize kernel for @level, falling back to a scalar
+ * loop
+ */
+GstBayerNormalize8Func
+gst_bayer_simd_get_normalize8_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return normalize8_avx2;
+    case GST_SIMD_SSE41:
+      return normalize8_sse41;
+#endif
+    default:
+      return normalize8_scalar;
+  }
+}
+
+/**
+ * gst_bayer_simd_get_normalize16_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 16-bit normalize kernel for @level, falling back to a scalar
+ * loop
+ */
+GstBayerNormalize16Func
+gst_bayer_simd_get_normalize16_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return normalize16_avx2;
+    case GST_SIMD_SSE41:
+      return normalize16_sse41;
+#endif
+    default:
+      return normalize16_scalar;
+  }
+}
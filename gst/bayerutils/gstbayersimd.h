@@ -0,0 +1,135 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_BAYER_SIMD_H__
+#define __GST_BAYER_SIMD_H__
+
+#include <glib.h>
+
+#include "simdlevel.h"
+
+G_BEGIN_DECLS
+
+/* demosaic filter coefficients are in units of 1 / (1 << SHIFT) */
+#define GST_BAYER_DEMOSAIC_SHIFT 4
+
+/**
+* GstBayerDemosaicTerm:
+*
+* Sums of neighbouring samples that the demosaic filters are built from,
+* relative to the center sample at (x, y).
+*/
+typedef enum {
+  GST_BAYER_DEMOSAIC_CENTER,    /* (x, y) */
+  GST_BAYER_DEMOSAIC_H1,        /* (x - 1, y) + (x + 1, y) */
+  GST_BAYER_DEMOSAIC_V1,        /* (x, y - 1) + (x, y + 1) */
+  GST_BAYER_DEMOSAIC_DIAGONAL,  /* (x +- 1, y +- 1) */
+  GST_BAYER_DEMOSAIC_H2,        /* (x - 2, y) + (x + 2, y) */
+  GST_BAYER_DEMOSAIC_V2,        /* (x, y - 2) + (x, y + 2) */
+  GST_BAYER_DEMOSAIC_N_TERMS
+} GstBayerDemosaicTerm;
+
+/**
+* GstBayerDemosaicFunc:
+* @out: output rows of red, green and blue samples
+* @rows: five input rows centered on the output row, each readable two
+*     samples before the first and after the last pixel
+* @width: number of pixels
+* @coefs: coefficient of each term for each output channel, for even and
+*     odd columns
+* @max: largest valid sample, results are clamped to [0, @max]
+* @rshift: right shift applied to clamped results
+* @lshift: left shift applied after @rshift
+*
+* Interpolate one row of red, green and blue from a row of Bayer samples,
+* each output being a rounded weighted sum of the terms.
+*/
+typedef void (*GstBayerDemosaicFunc) (guint16 * out[3],
+    const guint16 * rows[5], gint width,
+    const gint coefs[3][2][GST_BAYER_DEMOSAIC_N_TERMS], gint max,
+    gint rshift, gint lshift);
+
+/**
+* GstBayerBin8Func:
+* @out: output rows, one per channel
+* @n_out: number of output channels, 1 to 3
+* @row0: even input row of 8-bit samples
+* @row1: odd input row of 8-bit samples
+* @width: number of output pixels, each from a 2x2 quad of input samples
+* @weights: weight of each sample of a quad for each output channel, indexed
+*     by GST_BAYER_INFO_CFA_INDEX
+* @shift: rounding right shift of the weighted sums
+* @max: results are clamped to @max
+*
+* Combine each 2x2 quad of a pair of Bayer rows into one output pixel.
+*/
+typedef void (*GstBayerBin8Func) (guint16 * out[3], gint n_out,
+    const guint8 * row0, const guint8 * row1, gint width,
+    const gint weights[3][4], gint shift, gint max);
+
+/**
+* GstBayerBin16Func:
+*
+* Same as #GstBayerBin8Func for rows of native 16-bit samples.
+*/
+typedef void (*GstBayerBin16Func) (guint16 * out[3], gint n_out,
+    const guint16 * row0, const guint16 * row1, gint width,
+    const gint weights[3][4], gint shift, gint max);
+
+/* normalize gains are in units of 1 / (1 << SHIFT) */
+#define GST_BAYER_NORMALIZE_SHIFT 12
+
+/**
+* GstBayerNormalize8Func:
+* @dst: output row of 8-bit samples, may equal @src
+* @src: input row of 8-bit samples
+* @width: number of samples
+* @black: black level subtracted from even and odd columns, saturating at 0
+* @gain: gain of even and odd columns, in units of
+*     1 / (1 << GST_BAYER_NORMALIZE_SHIFT), at most 16
+* @shift: rounding right shift of the scaled samples
+* @max: results are clamped to @max
+*
+* Subtract a black level from each sample and scale it, in one pass.
+*/
+typedef void (*GstBayerNormalize8Func) (guint8 * dst, const guint8 * src,
+    gint width, const gint black[2], const gint gain[2], gint shift,
+    gint max);
+
+/**
+* GstBayerNormalize16Func:
+* @swap: whether samples are byte swapped, both in @src and @dst
+*
+* Same as #GstBayerNormalize8Func for rows of 16-bit samples.
+*/
+typedef void (*GstBayerNormalize16Func) (guint16 * dst, const guint16 * src,
+    gint width, const gint black[2], const gint gain[2], gint shift,
+    gint max, gboolean swap);
+
+GstBayerDemosaicFunc gst_bayer_simd_get_demosaic_func (GstSimdLevel level);
+GstBayerBin8Func gst_bayer_simd_get_bin8_func (GstSimdLevel level);
+GstBayerBin16Func gst_bayer_simd_get_bin16_func (GstSimdLevel level);
+GstBayerNormalize8Func gst_bayer_simd_get_normalize8_func (
+    GstSimdLevel level);
+GstBayerNormalize16Func gst_bayer_simd_get_normalize16_func (
+    GstSimdLevel level);
+
+G_END_DECLS
+
+#endif /* __GST_BAYER_SIMD_H__ */
@@ -0,0 +1,223 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstbayerutils.h"
+#include "gstbayer2gray.h"
+#include "gstbayerbin.h"
+#include "gstbayerdemosaic.h"
+#include "gstbayernormalize.h"
+
+#include <string.h>
+
+#define GST_CAT_DEFAULT gst_nvl_bayerutils_debug
+GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
+
+/**
+ * gst_bayer_info_from_caps:
+ * @info: #GstBayerInfo to fill
+ * @caps: fixed video/x-bayer caps
+ *
+ * Parse the pattern, sample size and dimensions of Bayer caps. 16-bit caps
+ * without endianness or bpp fields are taken as native and 16 bits.
+ *
+ * Returns: %TRUE if @caps could be parsed
+ */
+gboolean
+gst_bayer_info_from_caps (GstBayerInfo * info, const GstCaps * caps)
+{
+  GstStructure *s;
+  const gchar *format;
+  gint endianness, i;
+
+  g_return_val_if_fail (info != NULL, FALSE);
+  g_return_val_if_fail (gst_caps_is_fixed (caps), FALSE);
+
+  s = gst_caps_get_structure (caps, 0);
+  if (!gst_structure_has_name (s, "video/x-bayer"))
+    return FALSE;
+
+  format = gst_structure_get_string (s, "format");
+  if (!format || strlen (format) < 4 ||
+      !gst_structure_get_int (s, "width", &info->width) ||
+      !gst_structure_get_int (s, "height", &info->height))
+    return FALSE;
+
+  for (i = 0; i < 4; i++) {
+    switch (format[i]) {
+      case 'r':
+        info->cfa[i] = GST_BAYER_COLOR_RED;
+        break;
+      case 'g':
+        info->cfa[i] = GST_BAYER_COLOR_GREEN;
+        break;
+      case 'b':
+        info->cfa[i] = GST_BAYER_COLOR_BLUE;
+        break;
+      default:
+        return FALSE;
+    }
+  }
+
+  if (!gst_structure_get_fraction (s, "framerate", &info->fps_n, &info->fps_d)) {
+    info->fps_n = 0;
+    info->fps_d = 1;
+  }
+
+  if (g_str_has_suffix (format, "16")) {
+    info->depth = 16;
+    if (!gst_structure_get_int (s, "bpp", &info->bpp))
+      info->bpp = 16;
+    if (!gst_structure_get_int (s, "endianness", &endianness))
+      endianness = G_BYTE_ORDER;
+    info->swap = endianness != G_BYTE_ORDER;
+  } else {
+    info->depth = 8;
+    info->bpp = 8;
+    info->swap = FALSE;
+  }
+
+  if (info->bpp < 1 || info->bpp > info->depth)
+    return FALSE;
+
+  info->stride = GST_ROUND_UP_4 (info->width * info->depth / 8);
+  info->size = (gsize) info->stride * info->height;
+
+  return TRUE;
+}
+
+/**
+ * gst_bayer_rgb_layout_init:
+ * @layout: #GstBayerRgbLayout to fill
+ * @info: #GstVideoInfo of one of GST_BAYER_RGB_FORMATS
+ *
+ * Describe where each sample of a packed RGB pixel goes.
+ */
+void
+gst_bayer_rgb_layout_init (GstBayerRgbLayout * layout,
+    const GstVideoInfo * info)
+{
+  const GstVideoFormatInfo *finfo = info->finfo;
+  gint c, sum = 0;
+
+  layout->depth = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0);
+  layout->pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, 0) * 8 /
+      layout->depth;
+  for (c = 0; c < 3; c++) {
+    layout->offsets[c] = GST_VIDEO_FORMAT_INFO_POFFSET (finfo, c) * 8 /
+        layout->depth;
+    sum += layout->offsets[c];
+  }
+
+  /* alpha or padding takes whichever sample is left */
+  layout->fill = layout->pstride == 4 ? 6 - sum : -1;
+}
+
+/**
+ * gst_bayer_rgb_layout_pack:
+ * @layout: #GstBayerRgbLayout of the output
+ * @dst: output row
+ * @rgb: rows of red, green and blue samples already at the output depth
+ * @width: number of pixels
+ *
+ * Interleave one row of red, green and blue samples, setting any alpha or
+ * padding to opaque.
+ */
+void
+gst_bayer_rgb_layout_pack (const GstBayerRgbLayout * layout, gpointer dst,
+    guint16 * rgb[3], gint width)
+{
+  const gint pstride = layout->pstride;
+  gint c, x;
+
+  if (layout->depth == 16) {
+    guint16 *out = (guint16 *) dst;
+
+    for (c = 0; c < 3; c++) {
+      const gint offset = layout->offsets[c];
+      for (x = 0; x < width; x++)
+        out[x * pstride + offset] = rgb[c][x];
+    }
+    if (layout->fill >= 0) {
+      for (x = 0; x < width; x++)
+        out[x * pstride + layout->fill] = 0xffff;
+    }
+  } else {
+    guint8 *out = (guint8 *) dst;
+
+    for (c = 0; c < 3; c++) {
+      const gint offset = layout->offsets[c];
+      for (x = 0; x < width; x++)
+        out[x * pstride + offset] = (guint8) rgb[c][x];
+    }
+    if (layout->fill >= 0) {
+      for (x = 0; x < width; x++)
+        out[x * pstride + layout->fill] = 0xff;
+    }
+  }
+}
+
+/* Register filters that make up the gstgl plugin */
+static gboolean
+plugin_init (GstPlugin * plugin)
+{
+  GST_DEBUG_CATEGORY_INIT (GST_CAT_DEFAULT, "bayerutils", 0, "bayerutils");
+
+  GST_DEBUG ("plugin_init");
+
+  GST_CAT_INFO (GST_CAT_DEFAULT, "registering bayer2gray element");
+
+  if (!gst_element_register (plugin, "bayer2gray", GST_RANK_NONE,
+          GST_TYPE_BAYER2GRAY)) {
+    return FALSE;
+  }
+
+  GST_CAT_INFO (GST_CAT_DEFAULT, "registering bayerdemosaic element");
+
+  if (!gst_element_register (plugin, "bayerdemosaic", GST_RANK_NONE,
+          GST_TYPE_BAYER_DEMOSAIC)) {
+    return FALSE;
+  }
+
+  GST_CAT_INFO (GST_CAT_DEFAULT, "registering bayerbin element");
+
+  if (!gst_element_register (plugin, "bayerbin", GST_RANK_NONE,
+          GST_TYPE_BAYER_BIN)) {
+    return FALSE;
+  }
+
+  GST_CAT_INFO (GST_CAT_DEFAULT, "registering bayernormalize element");
+
+  if (!gst_element_register (plugin, "bayernormalize", GST_RANK_NONE,
+          GST_TYPE_BAYER_NORMALIZE)) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+GST_PLUGIN_DEFINE (GST_VERSION_MAJOR,
+    GST_VERSION_MINOR,
+    bayerutils,
+    "Plugins for working with Bayer video",
+    plugin_init, GST_PACKAGE_VERSION, GST_PACKAGE_LICENSE, GST_PACKAGE_NAME,
+    GST_PACKAGE_ORIGIN);
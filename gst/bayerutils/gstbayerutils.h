@@ -0,0 +1,122 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_BAYER_UTILS_H__
+#define __GST_BAYER_UTILS_H__
+
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+G_BEGIN_DECLS
+
+#define VIDEO_CAPS_MAKE_BAYER8(format)                       \
+    "video/x-bayer, "                                        \
+    "format = (string) " format ", "                         \
+    "width = " GST_VIDEO_SIZE_RANGE ", "                     \
+    "height = " GST_VIDEO_SIZE_RANGE ", "                    \
+    "framerate = " GST_VIDEO_FPS_RANGE
+
+#define VIDEO_CAPS_MAKE_BAYER16(format)                      \
+    "video/x-bayer, "                                        \
+    "format = (string) " format ", "                         \
+    "endianness = (int) {1234, 4321}, "                      \
+    "bpp = (int) {16, 14, 12, 10}, "                         \
+    "width = " GST_VIDEO_SIZE_RANGE ", "                     \
+    "height = " GST_VIDEO_SIZE_RANGE ", "                    \
+    "framerate = " GST_VIDEO_FPS_RANGE
+
+#define VIDEO_CAPS_BAYER8 VIDEO_CAPS_MAKE_BAYER8("{bggr,grbg,gbrg,rggb}")
+#define VIDEO_CAPS_BAYER16 VIDEO_CAPS_MAKE_BAYER16("{bggr16,grbg16,gbrg16,rggb16}")
+
+/**
+* GstBayerColor:
+* @GST_BAYER_COLOR_RED: red filter
+* @GST_BAYER_COLOR_GREEN: green filter
+* @GST_BAYER_COLOR_BLUE: blue filter
+*
+* Color of a position in the color filter array.
+*/
+typedef enum {
+  GST_BAYER_COLOR_RED,
+  GST_BAYER_COLOR_GREEN,
+  GST_BAYER_COLOR_BLUE
+} GstBayerColor;
+
+/**
+* GstBayerInfo:
+* @width: frame width
+* @height: frame height
+* @fps_n: framerate numerator
+* @fps_d: framerate denominator
+* @depth: bits per stored sample, 8 or 16
+* @bpp: significant bits per sample
+* @swap: whether 16-bit samples are byte swapped relative to the host
+* @stride: default row stride in bytes, rows being padded to four bytes
+* @size: default frame size in bytes
+* @cfa: color of each position of a 2x2 quad, indexed by
+*     GST_BAYER_INFO_CFA_INDEX
+*
+* Description of video/x-bayer caps.
+*/
+typedef struct {
+  gint width;
+  gint height;
+  gint fps_n;
+  gint fps_d;
+  gint depth;
+  gint bpp;
+  gboolean swap;
+  gint stride;
+  gsize size;
+  GstBayerColor cfa[4];
+} GstBayerInfo;
+
+#define GST_BAYER_INFO_CFA_INDEX(x,y) ((((y) & 1) << 1) | ((x) & 1))
+#define GST_BAYER_INFO_COLOR(info,x,y) ((info)->cfa[GST_BAYER_INFO_CFA_INDEX (x, y)])
+
+gboolean gst_bayer_info_from_caps (GstBayerInfo * info, const GstCaps * caps);
+
+#define GST_BAYER_RGB_FORMATS "{ ARGB64, RGB, BGR, RGBx, BGRx, xRGB, " \
+    "xBGR, RGBA, BGRA, ARGB, ABGR }"
+
+/**
+* GstBayerRgbLayout:
+* @depth: bits per output sample, 8 or 16
+* @pstride: samples per pixel
+* @offsets: offset in samples of red, green and blue within a pixel
+* @fill: offset in samples of alpha or padding, or -1
+*
+* Pixel layout of one of GST_BAYER_RGB_FORMATS.
+*/
+typedef struct {
+  gint depth;
+  gint pstride;
+  gint offsets[3];
+  gint fill;
+} GstBayerRgbLayout;
+
+void gst_bayer_rgb_layout_init (GstBayerRgbLayout * layout,
+    const GstVideoInfo * info);
+void gst_bayer_rgb_layout_pack (const GstBayerRgbLayout * layout,
+    gpointer dst, guint16 * rgb[3], gint width);
+
+G_END_DECLS
+
+#endif /* __GST_BAYER_UTILS_H__ */
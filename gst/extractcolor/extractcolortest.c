@@ -0,0 +1,247 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Bit-exactness test for the extractcolor kernels.
+ *
+ * Runs every kernel at every instruction set the CPU supports on random
+ * rows of many widths, aligned and unaligned, and compares the output with
+ * the scalar kernel, including the bytes past the end of the row so that
+ * overruns are caught too. Returns nonzero on any mismatch.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gstextractcolorsimd.h"
+
+/* widths around every vector size, so each tail length is covered */
+static const gint widths[] = {
+  0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 131
+};
+
+#define MAX_WIDTH 131
+/* pixels past the widest row, left untouched by every kernel */
+#define GUARD 16
+#define GUARD_BYTE 0xa5
+
+typedef struct
+{
+  GstSimdLevel level;
+  const gchar *kernel;
+  gint failures;
+} Check;
+
+static void
+compare (Check * check, const void *expected, const void *actual, gsize size,
+    gint width, gint misalign)
+{
+  if (memcmp (expected, actual, size) != 0) {
+    fprintf (stderr, "%s %s: mismatch at width %d, misaligned by %d\n",
+        gst_simd_get_name (check->level), check->kernel, width, misalign);
+    check->failures++;
+  }
+}
+
+static void
+test_copy64 (Check * check, const guint16 * src, gint width, gint misalign)
+{
+  GstExtractColorCopy64Func scalar =
+      gst_extract_color_simd_get_copy64_func (GST_SIMD_NONE);
+  GstExtractColorCopy64Func simd =
+      gst_extract_color_simd_get_copy64_func (check->level);
+  guint16 expected[MAX_WIDTH + GUARD], actual[MAX_WIDTH + GUARD];
+  gint word;
+
+  check->kernel = "copy64";
+  for (word = 0; word < 4; word++) {
+    memset (expected, GUARD_BYTE, sizeof (expected));
+    memset (actual, GUARD_BYTE, sizeof (actual));
+    scalar (expected, src, width, word);
+    simd (actual, src, width, word);
+    compare (check, expected, actual, sizeof (expected), width, misalign);
+  }
+}
+
+static void
+test_deinterleave32 (Check * check, const guint8 * src, gint width,
+    gint misalign)
+{
+  GstExtractColorDeinterleave32Func scalar =
+      gst_extract_color_simd_get_deinterleave32_func (GST_SIMD_NONE);
+  GstExtractColorDeinterleave32Func simd =
+      gst_extract_color_simd_get_deinterleave32_func (check->level);
+  guint8 expected[4][MAX_WIDTH + GUARD], actual[4][MAX_WIDTH + GUARD];
+  guint8 *expected_rows[4], *actual_rows[4];
+  gint wanted, c;
+
+  check->kernel = "deinterleave32";
+  /* every combination of requested components */
+  for (wanted = 1; wanted < 16; wanted++) {
+    memset (expected, GUARD_BYTE, sizeof (expected));
+    memset (actual, GUARD_BYTE, sizeof (actual));
+    for (c = 0; c < 4; c++) {
+      expected_rows[c] = (wanted & (1 << c)) ? expected[c] : NULL;
+      actual_rows[c] = (wanted & (1 << c)) ? actual[c] : NULL;
+    }
+    scalar (expected_rows, src, width);
+    simd (actual_rows, src, width);
+    compare (check, expected, actual, sizeof (expected), width, misalign);
+  }
+}
+
+static void
+test_deinterleave64 (Check * check, const guint16 * src, gint width,
+    gint misalign)
+{
+  GstExtractColorDeinterleave64Func scalar =
+      gst_extract_color_simd_get_deinterleave64_func (GST_SIMD_NONE);
+  GstExtractColorDeinterleave64Func simd =
+      gst_extract_color_simd_get_deinterleave64_func (check->level);
+  guint16 expected[4][MAX_WIDTH + GUARD], actual[4][MAX_WIDTH + GUARD];
+  guint16 *expected_rows[4], *actual_rows[4];
+  gint wanted, c;
+
+  check->kernel = "deinterleave64";
+  for (wanted = 1; wanted < 16; wanted++) {
+    memset (expected, GUARD_BYTE, sizeof (expected));
+    memset (actual, GUARD_BYTE, sizeof (actual));
+    for (c = 0; c < 4; c++) {
+      expected_rows[c] = (wanted & (1 << c)) ? expected[c] : NULL;
+      actual_rows[c] = (wanted & (1 << c)) ? actual[c] : NULL;
+    }
+    scalar (expected_rows, src, width);
+    simd (actual_rows, src, width);
+    compare (check, expected, actual, sizeof (expected), width, misalign);
+  }
+}
+
+/* weights summing to exactly one with one unused position, as the element
+ * computes them */
+static void
+random_weights (GRand * rand, gint one, gint weights[4])
+{
+  const gint unused = g_rand_int_range (rand, 0, 4);
+  gint remaining = one;
+  gint i;
+
+  for (i = 0; i < 4; i++) {
+    if (i == unused) {
+      weights[i] = 0;
+    } else if (i == (unused == 3 ? 2 : 3)) {
+      weights[i] = remaining;
+    } else {
+      weights[i] = g_rand_int_range (rand, 0, remaining + 1);
+      remaining -= weights[i];
+    }
+  }
+}
+
+static void
+test_luma32 (Check * check, GRand * rand, const guint8 * src, gint width,
+    gint misalign)
+{
+  GstExtractColorLuma32Func scalar =
+      gst_extract_color_simd_get_luma32_func (GST_SIMD_NONE);
+  GstExtractColorLuma32Func simd =
+      gst_extract_color_simd_get_luma32_func (check->level);
+  const gint one = 1 << GST_EXTRACT_COLOR_LUMA8_SHIFT;
+  guint8 expected[MAX_WIDTH + GUARD], actual[MAX_WIDTH + GUARD];
+  gint weights[4];
+  gint i;
+
+  check->kernel = "luma32";
+  for (i = 0; i < 8; i++) {
+    random_weights (rand, one, weights);
+    memset (expected, GUARD_BYTE, sizeof (expected));
+    memset (actual, GUARD_BYTE, sizeof (actual));
+    scalar (expected, src, width, weights);
+    simd (actual, src, width, weights);
+    compare (check, expected, actual, sizeof (expected), width, misalign);
+  }
+}
+
+static void
+test_luma64 (Check * check, GRand * rand, const guint16 * src, gint width,
+    gint misalign)
+{
+  GstExtractColorLuma64Func scalar =
+      gst_extract_color_simd_get_luma64_func (GST_SIMD_NONE);
+  GstExtractColorLuma64Func simd =
+      gst_extract_color_simd_get_luma64_func (check->level);
+  const gint one = 1 << GST_EXTRACT_COLOR_LUMA16_SHIFT;
+  guint16 expected[MAX_WIDTH + GUARD], actual[MAX_WIDTH + GUARD];
+  gint weights[4];
+  gint i;
+
+  check->kernel = "luma64";
+  for (i = 0; i < 8; i++) {
+    random_weights (rand, one, weights);
+    memset (expected, GUARD_BYTE, sizeof (expected));
+    memset (actual, GUARD_BYTE, sizeof (actual));
+    scalar (expected, src, width, weights);
+    simd (actual, src, width, weights);
+    compare (check, expected, actual, sizeof (expected), width, misalign);
+  }
+}
+
+int
+main (int argc, char **argv)
+{
+  GstSimdLevel detected;
+  Check check;
+  GRand *rand;
+  guint16 *src;
+  gint failures = 0;
+  guint i;
+
+  /* one spare pixel to misalign by, and saturated pixels at the start to
+   * hit the largest luma sums */
+  src = g_new (guint16, (MAX_WIDTH + 1) * 4);
+  rand = g_rand_new_with_seed (0);
+  for (i = 0; i < (MAX_WIDTH + 1) * 4; i++)
+    src[i] = i < 16 ? G_MAXUINT16 : (guint16) g_rand_int (rand);
+
+  detected = gst_simd_get_level ();
+  for (check.level = GST_SIMD_SSSE3; check.level <= detected; check.level++) {
+    check.failures = 0;
+    for (i = 0; i < G_N_ELEMENTS (widths); i++) {
+      gint misalign;
+
+      for (misalign = 0; misalign < 2; misalign++) {
+        const guint16 *src64 = src + misalign * 4;
+        const guint8 *src32 = (const guint8 *) src + misalign * 4;
+
+        test_copy64 (&check, src64, widths[i], misalign);
+        test_deinterleave32 (&check, src32, widths[i], misalign);
+        test_deinterleave64 (&check, src64, widths[i], misalign);
+        test_luma32 (&check, rand, src32, widths[i], misalign);
+        test_luma64 (&check, rand, src64, widths[i], misalign);
+      }
+    }
+    printf ("%-6s %d mismatches\n", gst_simd_get_name (check.level),
+        check.failures);
+    failures += check.failures;
+  }
+
+  g_rand_free (rand);
+  g_free (src);
+
+  return failures > 0;
+}
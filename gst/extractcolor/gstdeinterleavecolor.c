@@ -0,0 +1,804 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+* SECTION:element-deinterleavecolor
+*
+* Split RGB video into one grayscale stream per requested color component.
+* Each input frame is read once, writing every requested component in the
+* same pass, so it replaces several extractcolor elements behind a tee.
+* Source pads are requested by component name.
+*
+* <refsect2>
+* <title>Example launch line</title>
+* |[
+* gst-launch-1.0 videotestsrc ! video/x-raw,format=BGRx ! deinterleavecolor name=d
+*     d.src_red ! queue ! videoconvert ! autovideosink
+*     d.src_blue ! queue ! videoconvert ! autovideosink
+* ]|
+* </refsect2>
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstdeinterleavecolor.h"
+
+#include <string.h>
+
+#define RGB8_FORMATS "{ RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, RGB, BGR }"
+#define RGB16_FORMATS "ARGB64"
+
+static GstStaticPadTemplate gst_deinterleave_color_sink_template =
+    GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (RGB8_FORMATS) ";"
+        GST_VIDEO_CAPS_MAKE (RGB16_FORMATS))
+    );
+
+static GstStaticPadTemplate gst_deinterleave_color_src_template =
+    GST_STATIC_PAD_TEMPLATE ("src_%s",
+    GST_PAD_SRC,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE ("GRAY8") ";"
+        GST_VIDEO_CAPS_MAKE ("GRAY16_LE"))
+    );
+
+/* pad names, indexed by GstExtractColorComponent */
+static const gchar *component_pad_names[] = {
+  "src_red", "src_green", "src_blue"
+};
+
+/* GObject vmethod declarations */
+static void gst_deinterleave_color_finalize (GObject * object);
+
+/* GstElement vmethod declarations */
+static GstPad *gst_deinterleave_color_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps);
+static void gst_deinterleave_color_release_pad (GstElement * element,
+    GstPad * pad);
+static GstStateChangeReturn gst_deinterleave_color_change_state (GstElement *
+    element, GstStateChange transition);
+
+/* pad function declarations */
+static GstFlowReturn gst_deinterleave_color_chain (GstPad * pad,
+    GstObject * parent, GstBuffer * buf);
+static gboolean gst_deinterleave_color_sink_event (GstPad * pad,
+    GstObject * parent, GstEvent * event);
+static gboolean gst_deinterleave_color_sink_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
+static gboolean gst_deinterleave_color_src_query (GstPad * pad,
+    GstObject * parent, GstQuery * query);
+
+/* GstDeinterleaveColor method declarations */
+static void gst_deinterleave_color_reset (GstDeinterleaveColor * filt);
+
+/* setup debug */
+GST_DEBUG_CATEGORY_STATIC (deinterleave_color_debug);
+#define GST_CAT_DEFAULT deinterleave_color_debug
+
+G_DEFINE_TYPE (GstDeinterleaveColor, gst_deinterleave_color, GST_TYPE_ELEMENT);
+
+/************************************************************************/
+/* GObject vmethod implementations                                      */
+/************************************************************************/
+
+static void
+gst_deinterleave_color_finalize (GObject * object)
+{
+  GstDeinterleaveColor *filt = GST_DEINTERLEAVE_COLOR (object);
+
+  GST_DEBUG ("finalize");
+
+  gst_flow_combiner_free (filt->flow_combiner);
+
+  /* chain up to the parent class */
+  G_OBJECT_CLASS (gst_deinterleave_color_parent_class)->finalize (object);
+}
+
+static void
+gst_deinterleave_color_class_init (GstDeinterleaveColorClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *gstelement_class = GST_ELEMENT_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (deinterleave_color_debug, "deinterleavecolor", 0,
+      "Deinterleave Color Filter");
+
+  GST_DEBUG ("class init");
+
+  /* Register GObject vmethods */
+  gobject_class->finalize = GST_DEBUG_FUNCPTR (gst_deinterleave_color_finalize);
+
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_deinterleave_color_sink_template));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_deinterleave_color_src_template));
+
+  gst_element_class_set_static_metadata (gstelement_class,
+      "Deinterleave color filter", "Filter/Converter/Video",
+      "Splits RGB video into one stream per color component",
+      "Joshua M. Doe <oss@nvl.army.mil>");
+
+  /* Register GstElement vmethods */
+  gstelement_class->request_new_pad =
+      GST_DEBUG_FUNCPTR (gst_deinterleave_color_request_new_pad);
+  gstelement_class->release_pad =
+      GST_DEBUG_FUNCPTR (gst_deinterleave_color_release_pad);
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_deinterleave_color_change_state);
+}
+
+static void
+gst_deinterleave_color_init (GstDeinterleaveColor * filt)
+{
+  GST_DEBUG_OBJECT (filt, "init class instance");
+
+  filt->sinkpad =
+      gst_pad_new_from_static_template (&gst_deinterleave_color_sink_template,
+      "sink");
+  gst_pad_set_chain_function (filt->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_deinterleave_color_chain));
+  gst_pad_set_event_function (filt->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_deinterleave_color_sink_event));
+  gst_pad_set_query_function (filt->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_deinterleave_color_sink_query));
+  gst_element_add_pad (GST_ELEMENT (filt), filt->sinkpad);
+
+  filt->flow_combiner = gst_flow_combiner_new ();
+
+  gst_deinterleave_color_reset (filt);
+}
+
+/************************************************************************/
+/* GstElement vmethod implementations                                   */
+/************************************************************************/
+
+static gint
+gst_deinterleave_color_component_from_name (const gchar * name)
+{
+  gint comp;
+
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    if (strcmp (name, component_pad_names[comp]) == 0)
+      return comp;
+  }
+
+  return -1;
+}
+
+static GstPad *
+gst_deinterleave_color_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps)
+{
+  GstDeinterleaveColor *filt = GST_DEINTERLEAVE_COLOR (element);
+  GstPad *pad;
+  gint comp;
+
+  GST_OBJECT_LOCK (filt);
+  if (name) {
+    comp = gst_deinterleave_color_component_from_name (name);
+    if (comp < 0) {
+      GST_OBJECT_UNLOCK (filt);
+      GST_WARNING_OBJECT (filt, "No component named %s", name);
+      return NULL;
+    }
+  } else {
+    /* the first component without a pad */
+    for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+      if (!filt->srcpads[comp])
+        break;
+    }
+    if (comp == GST_DEINTERLEAVE_COLOR_N_COMPONENTS) {
+      GST_OBJECT_UNLOCK (filt);
+      GST_WARNING_OBJECT (filt, "All components already have pads");
+      return NULL;
+    }
+  }
+
+  if (filt->srcpads[comp]) {
+    GST_OBJECT_UNLOCK (filt);
+    GST_WARNING_OBJECT (filt, "Pad %s already exists",
+        component_pad_names[comp]);
+    return NULL;
+  }
+
+  pad = gst_pad_new_from_template (templ, component_pad_names[comp]);
+  gst_pad_set_query_function (pad,
+      GST_DEBUG_FUNCPTR (gst_deinterleave_color_src_query));
+
+  filt->srcpads[comp] = pad;
+  filt->pending_events[comp] = TRUE;
+  gst_flow_combiner_add_pad (filt->flow_combiner, pad);
+  GST_OBJECT_UNLOCK (filt);
+
+  GST_DEBUG_OBJECT (filt, "Created pad %s", component_pad_names[comp]);
+
+  gst_element_add_pad (element, pad);
+
+  return pad;
+}
+
+static void
+gst_deinterleave_color_release_pad (GstElement * element, GstPad * pad)
+{
+  GstDeinterleaveColor *filt = GST_DEINTERLEAVE_COLOR (element);
+  GstBufferPool *pool = NULL;
+  gint comp;
+
+  GST_OBJECT_LOCK (filt);
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    if (filt->srcpads[comp] == pad) {
+      filt->srcpads[comp] = NULL;
+      pool = filt->pools[comp];
+      filt->pools[comp] = NULL;
+      gst_flow_combiner_remove_pad (filt->flow_combiner, pad);
+      break;
+    }
+  }
+  GST_OBJECT_UNLOCK (filt);
+
+  if (pool) {
+    gst_buffer_pool_set_active (pool, FALSE);
+    gst_object_unref (pool);
+  }
+
+  gst_pad_set_active (pad, FALSE);
+  gst_element_remove_pad (element, pad);
+}
+
+static GstStateChangeReturn
+gst_deinterleave_color_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstDeinterleaveColor *filt = GST_DEINTERLEAVE_COLOR (element);
+  GstStateChangeReturn ret;
+
+  ret =
+      GST_ELEMENT_CLASS (gst_deinterleave_color_parent_class)->change_state
+      (element, transition);
+  if (ret == GST_STATE_CHANGE_FAILURE)
+    return ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_deinterleave_color_reset (filt);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+/************************************************************************/
+/* pad functions                                                        */
+/************************************************************************/
+
+static GstCaps *
+gst_deinterleave_color_get_src_caps (GstDeinterleaveColor * filt)
+{
+  GstCaps *caps = NULL;
+
+  GST_OBJECT_LOCK (filt);
+  if (filt->have_info)
+    caps = gst_video_info_to_caps (&filt->info_out);
+  GST_OBJECT_UNLOCK (filt);
+
+  return caps;
+}
+
+static gboolean
+gst_deinterleave_color_set_caps (GstDeinterleaveColor * filt, GstCaps * caps)
+{
+  GstVideoInfo info_in, info_out;
+  GstVideoFormat format_out;
+  gint comp;
+
+  if (!gst_video_info_from_caps (&info_in, caps)) {
+    GST_ERROR_OBJECT (filt, "Failed to parse caps %" GST_PTR_FORMAT, caps);
+    return FALSE;
+  }
+
+  format_out = GST_VIDEO_INFO_COMP_DEPTH (&info_in, 0) == 8 ?
+      GST_VIDEO_FORMAT_GRAY8 : GST_VIDEO_FORMAT_GRAY16_LE;
+  gst_video_info_set_format (&info_out, format_out,
+      GST_VIDEO_INFO_WIDTH (&info_in), GST_VIDEO_INFO_HEIGHT (&info_in));
+  info_out.fps_n = info_in.fps_n;
+  info_out.fps_d = info_in.fps_d;
+  info_out.par_n = info_in.par_n;
+  info_out.par_d = info_in.par_d;
+  info_out.interlace_mode = info_in.interlace_mode;
+
+  GST_DEBUG_OBJECT (filt, "Input caps %" GST_PTR_FORMAT, caps);
+
+  GST_OBJECT_LOCK (filt);
+  filt->info_in = info_in;
+  filt->info_out = info_out;
+  filt->have_info = TRUE;
+
+  /* every pad needs the new caps and a new pool */
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++)
+    filt->pending_events[comp] = TRUE;
+  GST_OBJECT_UNLOCK (filt);
+
+  return TRUE;
+}
+
+static gboolean
+gst_deinterleave_color_collect_sticky (GstPad * pad, GstEvent ** event,
+    gpointer user_data)
+{
+  GList **events = (GList **) user_data;
+
+  *events = g_list_prepend (*events, gst_event_ref (*event));
+
+  return TRUE;
+}
+
+/* create and activate a pool for one source pad, preferring downstream's */
+static GstBufferPool *
+gst_deinterleave_color_create_pool (GstDeinterleaveColor * filt, GstPad * pad,
+    GstCaps * caps)
+{
+  GstQuery *query;
+  GstBufferPool *pool = NULL;
+  GstStructure *config;
+  guint size, min = 0, max = 0;
+
+  size = GST_VIDEO_INFO_SIZE (&filt->info_out);
+
+  query = gst_query_new_allocation (caps, TRUE);
+  if (!gst_pad_peer_query (pad, query))
+    GST_DEBUG_OBJECT (pad, "Peer allocation query failed");
+
+  if (gst_query_get_n_allocation_pools (query) > 0) {
+    guint pool_size;
+    gst_query_parse_nth_allocation_pool (query, 0, &pool, &pool_size, &min,
+        &max);
+    size = MAX (size, pool_size);
+  }
+
+  if (!pool)
+    pool = gst_video_buffer_pool_new ();
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, size, min, max);
+  if (gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL))
+    gst_buffer_pool_config_add_option (config,
+        GST_BUFFER_POOL_OPTION_VIDEO_META);
+
+  if (!gst_buffer_pool_set_config (pool, config)) {
+    /* downstream pool didn't accept our settings, use our own */
+    gst_object_unref (pool);
+    pool = gst_video_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_set_params (config, caps, size, min, max);
+    gst_buffer_pool_set_config (pool, config);
+  }
+  gst_query_unref (query);
+
+  if (!gst_buffer_pool_set_active (pool, TRUE)) {
+    GST_ERROR_OBJECT (pad, "Failed to activate buffer pool");
+    gst_object_unref (pool);
+    return NULL;
+  }
+
+  return pool;
+}
+
+/* optionally send the sticky events of the sink pad to a source pad,
+ * replacing caps with our own, then give it a new pool */
+static gboolean
+gst_deinterleave_color_update_pad (GstDeinterleaveColor * filt, gint comp,
+    GstPad * pad, gboolean push_events)
+{
+  GstCaps *caps;
+  GstBufferPool *pool = NULL, *old_pool;
+
+  caps = gst_deinterleave_color_get_src_caps (filt);
+
+  if (push_events) {
+    GList *events = NULL, *l;
+
+    /* collect first, as the foreach function holds the sink pad lock */
+    gst_pad_sticky_events_foreach (filt->sinkpad,
+        gst_deinterleave_color_collect_sticky, &events);
+    events = g_list_reverse (events);
+
+    for (l = events; l; l = l->next) {
+      GstEvent *event = (GstEvent *) l->data;
+
+      if (GST_EVENT_TYPE (event) == GST_EVENT_CAPS) {
+        gst_event_unref (event);
+        if (!caps)
+          continue;
+        event = gst_event_new_caps (caps);
+      }
+
+      gst_pad_push_event (pad, event);
+    }
+    g_list_free (events);
+  }
+
+  if (caps) {
+    pool = gst_deinterleave_color_create_pool (filt, pad, caps);
+    gst_caps_unref (caps);
+    if (!pool)
+      return FALSE;
+  }
+
+  GST_OBJECT_LOCK (filt);
+  old_pool = filt->pools[comp];
+  filt->pools[comp] = pool;
+  GST_OBJECT_UNLOCK (filt);
+
+  if (old_pool) {
+    gst_buffer_pool_set_active (old_pool, FALSE);
+    gst_object_unref (old_pool);
+  }
+
+  return TRUE;
+}
+
+/* bring every pad that missed sticky events up to date */
+static void
+gst_deinterleave_color_update_pads (GstDeinterleaveColor * filt)
+{
+  GstPad *pads[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  gint comp;
+
+  GST_OBJECT_LOCK (filt);
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    pads[comp] = NULL;
+    if (filt->srcpads[comp] && filt->pending_events[comp]) {
+      pads[comp] = gst_object_ref (filt->srcpads[comp]);
+      filt->pending_events[comp] = FALSE;
+    }
+  }
+  GST_OBJECT_UNLOCK (filt);
+
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    if (!pads[comp])
+      continue;
+
+    if (!gst_deinterleave_color_update_pad (filt, comp, pads[comp], TRUE)) {
+      /* try again with the next buffer */
+      GST_OBJECT_LOCK (filt);
+      filt->pending_events[comp] = TRUE;
+      GST_OBJECT_UNLOCK (filt);
+    }
+    gst_object_unref (pads[comp]);
+  }
+}
+
+static gboolean
+gst_deinterleave_color_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstDeinterleaveColor *filt = GST_DEINTERLEAVE_COLOR (parent);
+
+  GST_LOG_OBJECT (filt, "Received %s event", GST_EVENT_TYPE_NAME (event));
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+      gboolean res;
+
+      /* sent to each source pad as it's updated */
+      gst_event_parse_caps (event, &caps);
+      res = gst_deinterleave_color_set_caps (filt, caps);
+      gst_event_unref (event);
+      return res;
+    }
+    case GST_EVENT_FLUSH_STOP:
+      GST_OBJECT_LOCK (filt);
+      gst_flow_combiner_reset (filt->flow_combiner);
+      GST_OBJECT_UNLOCK (filt);
+      break;
+    default:
+      break;
+  }
+
+  /* keep sticky events in order on pads that were added or renegotiated
+   * since the last buffer */
+  if (GST_EVENT_IS_STICKY (event) && GST_EVENT_IS_SERIALIZED (event))
+    gst_deinterleave_color_update_pads (filt);
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
+static gboolean
+gst_deinterleave_color_sink_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *filter, *caps;
+
+      gst_query_parse_caps (query, &filter);
+      caps = gst_pad_get_pad_template_caps (pad);
+      if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full (filter, caps,
+            GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (caps);
+        caps = tmp;
+      }
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      return TRUE;
+    }
+    case GST_QUERY_ALLOCATION:
+      /* each source pad has its own downstream, nothing to propose */
+      return FALSE;
+    default:
+      return gst_pad_query_default (pad, parent, query);
+  }
+}
+
+static gboolean
+gst_deinterleave_color_src_query (GstPad * pad, GstObject * parent,
+    GstQuery * query)
+{
+  GstDeinterleaveColor *filt = GST_DEINTERLEAVE_COLOR (parent);
+
+  switch (GST_QUERY_TYPE (query)) {
+    case GST_QUERY_CAPS:
+    {
+      GstCaps *filter, *caps;
+
+      gst_query_parse_caps (query, &filter);
+      caps = gst_deinterleave_color_get_src_caps (filt);
+      if (!caps)
+        caps = gst_pad_get_pad_template_caps (pad);
+      if (filter) {
+        GstCaps *tmp = gst_caps_intersect_full (filter, caps,
+            GST_CAPS_INTERSECT_FIRST);
+        gst_caps_unref (caps);
+        caps = tmp;
+      }
+      gst_query_set_caps_result (query, caps);
+      gst_caps_unref (caps);
+      return TRUE;
+    }
+    default:
+      return gst_pad_query_default (pad, parent, query);
+  }
+}
+
+/* deinterleave one frame into the output frames of the requested
+ * components, out_frames[comp] being NULL for the others */
+static void
+gst_deinterleave_color_process (GstDeinterleaveColor * filt,
+    GstVideoFrame * in_frame, GstVideoFrame * out_frames[])
+{
+  const gint width = GST_VIDEO_FRAME_WIDTH (in_frame);
+  const gint height = GST_VIDEO_FRAME_HEIGHT (in_frame);
+  const gint pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (in_frame, 0);
+  const gint depth = GST_VIDEO_FRAME_COMP_DEPTH (in_frame, 0);
+  const guint8 *src = GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0);
+  const gint sstride = GST_VIDEO_FRAME_PLANE_STRIDE (in_frame, 0);
+  guint8 *dst[4] = { NULL, NULL, NULL, NULL };
+  gint dstride[4] = { 0, 0, 0, 0 };
+  gint comp, x, y;
+
+  /* kernels are indexed by position within the pixel */
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    gint pos;
+
+    if (!out_frames[comp])
+      continue;
+
+    pos = GST_VIDEO_FRAME_COMP_OFFSET (in_frame, comp) / (depth / 8);
+    dst[pos] = GST_VIDEO_FRAME_PLANE_DATA (out_frames[comp], 0);
+    dstride[pos] = GST_VIDEO_FRAME_PLANE_STRIDE (out_frames[comp], 0);
+  }
+
+  for (y = 0; y < height; y++) {
+    if (depth == 16) {
+      filt->deinterleave64 ((guint16 **) dst, (const guint16 *) src, width);
+    } else if (pstride == 4) {
+      filt->deinterleave32 (dst, src, width);
+    } else {
+      /* packed 24-bit */
+      for (comp = 0; comp < 3; comp++) {
+        if (dst[comp]) {
+          for (x = 0; x < width; x++)
+            dst[comp][x] = src[x * pstride + comp];
+        }
+      }
+    }
+
+    src += sstride;
+    for (comp = 0; comp < 4; comp++) {
+      if (dst[comp])
+        dst[comp] += dstride[comp];
+    }
+  }
+}
+
+static GstFlowReturn
+gst_deinterleave_color_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+{
+  GstDeinterleaveColor *filt = GST_DEINTERLEAVE_COLOR (parent);
+  GstPad *srcpads[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  GstBufferPool *pools[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  GstBuffer *outbufs[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  GstVideoFrame out_frames[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  GstVideoFrame *out_frame_ptrs[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  GstVideoFrame in_frame;
+  GstVideoInfo info_in, info_out;
+  GstFlowReturn ret = GST_FLOW_OK;
+  gboolean have_info;
+  gint comp;
+
+  /* caps may be set again from another thread while this buffer is
+   * processed, so work from a copy */
+  GST_OBJECT_LOCK (filt);
+  have_info = filt->have_info;
+  info_in = filt->info_in;
+  info_out = filt->info_out;
+  GST_OBJECT_UNLOCK (filt);
+
+  if (!have_info) {
+    GST_ELEMENT_ERROR (filt, CORE, NEGOTIATION, (NULL),
+        ("No caps set before first buffer"));
+    gst_buffer_unref (buf);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  gst_deinterleave_color_update_pads (filt);
+
+  GST_OBJECT_LOCK (filt);
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    srcpads[comp] = NULL;
+    pools[comp] = NULL;
+    if (filt->srcpads[comp] && filt->pools[comp]) {
+      srcpads[comp] = gst_object_ref (filt->srcpads[comp]);
+      pools[comp] = gst_object_ref (filt->pools[comp]);
+    }
+  }
+  GST_OBJECT_UNLOCK (filt);
+
+  /* renegotiate pools that downstream asked us to reconfigure */
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    if (!srcpads[comp] || !gst_pad_check_reconfigure (srcpads[comp]))
+      continue;
+
+    GST_DEBUG_OBJECT (srcpads[comp], "Reconfiguring pool");
+    gst_object_unref (pools[comp]);
+    pools[comp] = NULL;
+    if (gst_deinterleave_color_update_pad (filt, comp, srcpads[comp], FALSE)) {
+      GST_OBJECT_LOCK (filt);
+      if (filt->pools[comp])
+        pools[comp] = gst_object_ref (filt->pools[comp]);
+      GST_OBJECT_UNLOCK (filt);
+    } else {
+      gst_pad_mark_reconfigure (srcpads[comp]);
+    }
+  }
+
+  if (!gst_video_frame_map (&in_frame, &info_in, buf, GST_MAP_READ)) {
+    GST_ELEMENT_ERROR (filt, RESOURCE, READ, (NULL),
+        ("Failed to map input buffer"));
+    ret = GST_FLOW_ERROR;
+    goto done;
+  }
+
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    GstFlowReturn acquire_ret;
+
+    outbufs[comp] = NULL;
+    out_frame_ptrs[comp] = NULL;
+    if (!pools[comp])
+      continue;
+
+    acquire_ret = gst_buffer_pool_acquire_buffer (pools[comp], &outbufs[comp],
+        NULL);
+    if (acquire_ret != GST_FLOW_OK) {
+      GST_DEBUG_OBJECT (srcpads[comp], "Failed to acquire buffer: %s",
+          gst_flow_get_name (acquire_ret));
+      outbufs[comp] = NULL;
+
+      /* a flushing or failed pool counts like a failed push on that pad */
+      GST_OBJECT_LOCK (filt);
+      ret = gst_flow_combiner_update_pad_flow (filt->flow_combiner,
+          srcpads[comp], acquire_ret);
+      GST_OBJECT_UNLOCK (filt);
+      continue;
+    }
+
+    if (!gst_video_frame_map (&out_frames[comp], &info_out,
+            outbufs[comp], GST_MAP_WRITE)) {
+      GST_WARNING_OBJECT (srcpads[comp], "Failed to map output buffer");
+      gst_buffer_unref (outbufs[comp]);
+      outbufs[comp] = NULL;
+      continue;
+    }
+    out_frame_ptrs[comp] = &out_frames[comp];
+  }
+
+  gst_deinterleave_color_process (filt, &in_frame, out_frame_ptrs);
+
+  gst_video_frame_unmap (&in_frame);
+
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    GstFlowReturn pad_ret;
+
+    if (!outbufs[comp])
+      continue;
+
+    gst_video_frame_unmap (&out_frames[comp]);
+    gst_buffer_copy_into (outbufs[comp], buf,
+        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+    pad_ret = gst_pad_push (srcpads[comp], outbufs[comp]);
+
+    GST_OBJECT_LOCK (filt);
+    ret = gst_flow_combiner_update_pad_flow (filt->flow_combiner,
+        srcpads[comp], pad_ret);
+    GST_OBJECT_UNLOCK (filt);
+  }
+
+done:
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    if (srcpads[comp])
+      gst_object_unref (srcpads[comp]);
+    if (pools[comp])
+      gst_object_unref (pools[comp]);
+  }
+  gst_buffer_unref (buf);
+
+  return ret;
+}
+
+static void
+gst_deinterleave_color_reset (GstDeinterleaveColor * filt)
+{
+  GstBufferPool *pools[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  gint comp;
+
+  GST_OBJECT_LOCK (filt);
+  filt->have_info = FALSE;
+  gst_video_info_init (&filt->info_in);
+  gst_video_info_init (&filt->info_out);
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    pools[comp] = filt->pools[comp];
+    filt->pools[comp] = NULL;
+    filt->pending_events[comp] = TRUE;
+  }
+  gst_flow_combiner_reset (filt->flow_combiner);
+  GST_OBJECT_UNLOCK (filt);
+
+  for (comp = 0; comp < GST_DEINTERLEAVE_COLOR_N_COMPONENTS; comp++) {
+    if (pools[comp]) {
+      gst_buffer_pool_set_active (pools[comp], FALSE);
+      gst_object_unref (pools[comp]);
+    }
+  }
+
+  filt->deinterleave32 =
+      gst_extract_color_simd_get_deinterleave32_func (gst_simd_get_level ());
+  filt->deinterleave64 =
+      gst_extract_color_simd_get_deinterleave64_func (gst_simd_get_level ());
+}
@@ -0,0 +1,85 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_DEINTERLEAVE_COLOR_H__
+#define __GST_DEINTERLEAVE_COLOR_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstflowcombiner.h>
+#include <gst/video/video.h>
+
+#include "gstextractcolor.h"
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_DEINTERLEAVE_COLOR \
+  (gst_deinterleave_color_get_type())
+#define GST_DEINTERLEAVE_COLOR(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_DEINTERLEAVE_COLOR,GstDeinterleaveColor))
+#define GST_DEINTERLEAVE_COLOR_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_DEINTERLEAVE_COLOR,GstDeinterleaveColorClass))
+#define GST_IS_DEINTERLEAVE_COLOR(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_DEINTERLEAVE_COLOR))
+#define GST_IS_DEINTERLEAVE_COLOR_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_DEINTERLEAVE_COLOR))
+
+#define GST_DEINTERLEAVE_COLOR_N_COMPONENTS 3
+
+typedef struct _GstDeinterleaveColor GstDeinterleaveColor;
+typedef struct _GstDeinterleaveColorClass GstDeinterleaveColorClass;
+
+/**
+* GstDeinterleaveColor:
+* @element: the parent element.
+*
+* The opaque GstDeinterleaveColor data structure.
+*/
+struct _GstDeinterleaveColor
+{
+  GstElement element;
+
+  GstPad *sinkpad;
+
+  /* request pads and their state, indexed by GstExtractColorComponent */
+  GstPad *srcpads[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  GstBufferPool *pools[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  gboolean pending_events[GST_DEINTERLEAVE_COLOR_N_COMPONENTS];
+  GstFlowCombiner *flow_combiner;
+
+  /* format */
+  gboolean have_info;
+  GstVideoInfo info_in;
+  GstVideoInfo info_out;
+
+  /* kernels */
+  GstExtractColorDeinterleave32Func deinterleave32;
+  GstExtractColorDeinterleave64Func deinterleave64;
+};
+
+struct _GstDeinterleaveColorClass
+{
+  GstElementClass parent_class;
+};
+
+GType gst_deinterleave_color_get_type(void);
+
+G_END_DECLS
+
+#endif /* __GST_DEINTERLEAVE_COLOR_H__ */
@@ -26,6 +26,15 @@
 *
 * Convert grayscale video from one bpp/depth combination to another.
 *
+* Planar input is extracted without copying: the output buffer shares the
+* memory of the selected plane, with a #GstVideoMeta describing its stride
+* when it differs from the default. For YUV formats the red, green and blue
+* components select the Y, U and V planes.
+*
+* With mode=luma packed RGB input is instead reduced to a weighted sum of
+* its components, using BT.601, BT.709 or custom weights. The weights are
+* normalized to sum to one and applied in fixed point.
+*
 * <refsect2>
 * <title>Example launch line</title>
 * |[
@@ -39,6 +48,7 @@
 #endif
 
 #include "gstextractcolor.h"
+#include "gstdeinterleavecolor.h"
 
 #include <gst/video/video.h>
 
@@ -55,13 +65,25 @@ enum
 {
   PROP_0,
   PROP_COMPONENT,
+  PROP_MODE,
+  PROP_LUMA_MATRIX,
+  PROP_RED_WEIGHT,
+  PROP_GREEN_WEIGHT,
+  PROP_BLUE_WEIGHT,
   PROP_LAST
 };
 
 #define DEFAULT_PROP_COMPONENT GST_EXTRACT_COLOR_COMPONENT_RED
+#define DEFAULT_PROP_MODE GST_EXTRACT_COLOR_MODE_COMPONENT
+#define DEFAULT_PROP_LUMA_MATRIX GST_EXTRACT_COLOR_LUMA_MATRIX_BT709
+#define DEFAULT_PROP_RED_WEIGHT 0.2126
+#define DEFAULT_PROP_GREEN_WEIGHT 0.7152
+#define DEFAULT_PROP_BLUE_WEIGHT 0.0722
 
 #define RGB8_FORMATS "{ RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, RGB, BGR }"
 #define RGB16_FORMATS "ARGB64"
+#define PLANAR8_FORMATS "{ I420, YV12, Y42B, Y444, GBR }"
+#define PLANAR16_FORMATS "{ I420_10LE, Y444_10LE, GBR_10LE, GBR_12LE }"
 
 /* the capabilities of the inputs and outputs */
 static GstStaticPadTemplate gst_extract_color_sink_template =
@@ -69,7 +91,9 @@ static GstStaticPadTemplate gst_extract_color_sink_template =
     GST_PAD_SINK,
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE (RGB8_FORMATS) ";"
-        GST_VIDEO_CAPS_MAKE (RGB16_FORMATS))
+        GST_VIDEO_CAPS_MAKE (RGB16_FORMATS) ";"
+        GST_VIDEO_CAPS_MAKE (PLANAR8_FORMATS) ";"
+        GST_VIDEO_CAPS_MAKE (PLANAR16_FORMATS))
     );
 
 static GstStaticPadTemplate gst_extract_color_src_template =
@@ -101,6 +125,45 @@ gst_extract_color_component_get_type (void)
   return extract_color_component_type;
 }
 
+#define GST_TYPE_EXTRACT_COLOR_MODE (gst_extract_color_mode_get_type())
+static GType
+gst_extract_color_mode_get_type (void)
+{
+  static GType extract_color_mode_type = 0;
+  static const GEnumValue extract_color_mode[] = {
+    {GST_EXTRACT_COLOR_MODE_COMPONENT, "extract a single component",
+        "component"},
+    {GST_EXTRACT_COLOR_MODE_LUMA, "weighted sum of the components", "luma"},
+    {0, NULL, NULL},
+  };
+
+  if (!extract_color_mode_type) {
+    extract_color_mode_type =
+        g_enum_register_static ("GstExtractColorMode", extract_color_mode);
+  }
+  return extract_color_mode_type;
+}
+
+#define GST_TYPE_EXTRACT_COLOR_LUMA_MATRIX (gst_extract_color_luma_matrix_get_type())
+static GType
+gst_extract_color_luma_matrix_get_type (void)
+{
+  static GType extract_color_luma_matrix_type = 0;
+  static const GEnumValue extract_color_luma_matrix[] = {
+    {GST_EXTRACT_COLOR_LUMA_MATRIX_BT601, "ITU-R BT.601", "bt601"},
+    {GST_EXTRACT_COLOR_LUMA_MATRIX_BT709, "ITU-R BT.709", "bt709"},
+    {GST_EXTRACT_COLOR_LUMA_MATRIX_CUSTOM, "custom weights", "custom"},
+    {0, NULL, NULL},
+  };
+
+  if (!extract_color_luma_matrix_type) {
+    extract_color_luma_matrix_type =
+        g_enum_register_static ("GstExtractColorLumaMatrix",
+        extract_color_luma_matrix);
+  }
+  return extract_color_luma_matrix_type;
+}
+
 /* GObject vmethod declarations */
 static void gst_extract_color_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -111,6 +174,12 @@ static void gst_extract_color_dispose (GObject * object);
 /* GstBaseTransform vmethod declarations */
 static GstCaps *gst_extract_color_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps);
+static gboolean gst_extract_color_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query);
+static GstFlowReturn gst_extract_color_prepare_output_buffer (GstBaseTransform
+    * trans, GstBuffer * inbuf, GstBuffer ** outbuf);
+static GstFlowReturn gst_extract_color_transform (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf);
 
 /* GstVideoFilter vmethod declarations */
 static gboolean gst_extract_color_set_info (GstVideoFilter * filter,
@@ -182,6 +251,36 @@ gst_extract_color_class_init (GstExtractColorClass * klass)
           GST_TYPE_EXTRACT_COLOR_COMPONENT, DEFAULT_PROP_COMPONENT,
           G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
           GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (gobject_class, PROP_MODE,
+      g_param_spec_enum ("mode", "Mode",
+          "Extract a single component, or a weighted sum of the components",
+          GST_TYPE_EXTRACT_COLOR_MODE, DEFAULT_PROP_MODE,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (gobject_class, PROP_LUMA_MATRIX,
+      g_param_spec_enum ("luma-matrix", "Luma matrix",
+          "Weights of the components in luma mode",
+          GST_TYPE_EXTRACT_COLOR_LUMA_MATRIX, DEFAULT_PROP_LUMA_MATRIX,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (gobject_class, PROP_RED_WEIGHT,
+      g_param_spec_double ("red-weight", "Red weight",
+          "Weight of red with the custom luma matrix", 0.0, 1.0,
+          DEFAULT_PROP_RED_WEIGHT,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (gobject_class, PROP_GREEN_WEIGHT,
+      g_param_spec_double ("green-weight", "Green weight",
+          "Weight of green with the custom luma matrix", 0.0, 1.0,
+          DEFAULT_PROP_GREEN_WEIGHT,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (gobject_class, PROP_BLUE_WEIGHT,
+      g_param_spec_double ("blue-weight", "Blue weight",
+          "Weight of blue with the custom luma matrix", 0.0, 1.0,
+          DEFAULT_PROP_BLUE_WEIGHT,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_extract_color_sink_template));
@@ -196,6 +295,12 @@ gst_extract_color_class_init (GstExtractColorClass * klass)
   /* Register GstBaseTransform vmethods */
   gstbasetransform_class->transform_caps =
       GST_DEBUG_FUNCPTR (gst_extract_color_transform_caps);
+  gstbasetransform_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_extract_color_decide_allocation);
+  gstbasetransform_class->prepare_output_buffer =
+      GST_DEBUG_FUNCPTR (gst_extract_color_prepare_output_buffer);
+  gstbasetransform_class->transform =
+      GST_DEBUG_FUNCPTR (gst_extract_color_transform);
 
   gstvideofilter_class->set_info =
       GST_DEBUG_FUNCPTR (gst_extract_color_set_info);
@@ -209,6 +314,11 @@ gst_extract_color_init (GstExtractColor * filt)
   GST_DEBUG_OBJECT (filt, "init class instance");
 
   filt->component = DEFAULT_PROP_COMPONENT;
+  filt->mode = DEFAULT_PROP_MODE;
+  filt->luma_matrix = DEFAULT_PROP_LUMA_MATRIX;
+  filt->luma_weights[0] = DEFAULT_PROP_RED_WEIGHT;
+  filt->luma_weights[1] = DEFAULT_PROP_GREEN_WEIGHT;
+  filt->luma_weights[2] = DEFAULT_PROP_BLUE_WEIGHT;
   gst_base_transform_set_in_place (GST_BASE_TRANSFORM (filt), FALSE);
 
   gst_extract_color_reset (filt);
@@ -225,6 +335,25 @@ gst_extract_color_set_property (GObject * object, guint prop_id,
   switch (prop_id) {
     case PROP_COMPONENT:
       filt->component = g_value_get_enum (value);
+      /* chroma planes of subsampled formats have a different size */
+      gst_base_transform_reconfigure_src (GST_BASE_TRANSFORM (filt));
+      break;
+    case PROP_MODE:
+      filt->mode = g_value_get_enum (value);
+      /* planar formats are only supported in component mode */
+      gst_base_transform_reconfigure_src (GST_BASE_TRANSFORM (filt));
+      break;
+    case PROP_LUMA_MATRIX:
+      filt->luma_matrix = g_value_get_enum (value);
+      break;
+    case PROP_RED_WEIGHT:
+      filt->luma_weights[0] = g_value_get_double (value);
+      break;
+    case PROP_GREEN_WEIGHT:
+      filt->luma_weights[1] = g_value_get_double (value);
+      break;
+    case PROP_BLUE_WEIGHT:
+      filt->luma_weights[2] = g_value_get_double (value);
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -244,12 +373,63 @@ gst_extract_color_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_COMPONENT:
       g_value_set_enum (value, filt->component);
       break;
+    case PROP_MODE:
+      g_value_set_enum (value, filt->mode);
+      break;
+    case PROP_LUMA_MATRIX:
+      g_value_set_enum (value, filt->luma_matrix);
+      break;
+    case PROP_RED_WEIGHT:
+      g_value_set_double (value, filt->luma_weights[0]);
+      break;
+    case PROP_GREEN_WEIGHT:
+      g_value_set_double (value, filt->luma_weights[1]);
+      break;
+    case PROP_BLUE_WEIGHT:
+      g_value_set_double (value, filt->luma_weights[2]);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/* scale a width or height between the full frame and one plane, for
+ * chroma planes of subsampled formats */
+static void
+gst_extract_color_scale_dimension (GstStructure * s, const gchar * field,
+    guint sub, gboolean to_plane)
+{
+  const GValue *value = gst_structure_get_value (s, field);
+  gint min, max;
+
+  if (sub == 0 || !value)
+    return;
+
+  if (G_VALUE_HOLDS_INT (value)) {
+    min = max = g_value_get_int (value);
+  } else if (GST_VALUE_HOLDS_INT_RANGE (value)) {
+    min = gst_value_get_int_range_min (value);
+    max = gst_value_get_int_range_max (value);
+  } else {
+    return;
+  }
+
+  if (to_plane) {
+    min = GST_VIDEO_SUB_SCALE (sub, min);
+    max = GST_VIDEO_SUB_SCALE (sub, max);
+  } else {
+    /* several frame sizes have the same plane size */
+    min = ((MAX (min, 1) - 1) << sub) + 1;
+    max = max > (G_MAXINT >> sub) ? G_MAXINT : max << sub;
+  }
+
+  if (min == max)
+    gst_structure_set (s, field, G_TYPE_INT, min, NULL);
+  else
+    gst_structure_set (s, field, GST_TYPE_INT_RANGE, min, max, NULL);
+}
+
 GstCaps *
 gst_extract_color_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter_caps)
@@ -257,6 +437,9 @@ gst_extract_color_transform_caps (GstBaseTransform * trans,
   GstExtractColor *filt = GST_EXTRACT_COLOR (trans);
   GstCaps *normalized_caps, *other_caps;
   GstCaps *rgb8_caps, *rgb16_caps, *gray8_caps, *gray16_caps;
+  GstCaps *planar8_caps, *planar16_caps;
+  guint comp = filt->component;
+  gboolean planar = filt->mode == GST_EXTRACT_COLOR_MODE_COMPONENT;
   guint i, n;
 
   GST_LOG_OBJECT (filt, "transforming caps from %" GST_PTR_FORMAT, caps);
@@ -267,44 +450,94 @@ gst_extract_color_transform_caps (GstBaseTransform * trans,
   gray16_caps = gst_caps_from_string (GST_VIDEO_CAPS_MAKE ("GRAY16_LE"));
   rgb8_caps = gst_caps_from_string (GST_VIDEO_CAPS_MAKE (RGB8_FORMATS));
   rgb16_caps = gst_caps_from_string (GST_VIDEO_CAPS_MAKE (RGB16_FORMATS));
+  planar8_caps = gst_caps_from_string (GST_VIDEO_CAPS_MAKE (PLANAR8_FORMATS));
+  planar16_caps =
+      gst_caps_from_string (GST_VIDEO_CAPS_MAKE (PLANAR16_FORMATS));
 
   n = gst_caps_get_size (normalized_caps);
   for (i = 0; i < n; ++i) {
     GstCaps *c = gst_caps_copy_nth (normalized_caps, i);
-    GstCaps *tgt_caps = NULL;
-    const GValue *format_value;
-    if (i > 0 && gst_caps_is_subset (other_caps, c))
+    GstStructure *s = gst_caps_get_structure (c, 0);
+    const GstVideoFormatInfo *finfo;
+    const gchar *format;
+    GstCaps *planar_other = NULL;
+    gboolean deep;
+
+    if (i > 0 && gst_caps_is_subset (other_caps, c)) {
+      gst_caps_unref (c);
+      continue;
+    }
+
+    format = gst_structure_get_string (s, "format");
+    finfo = gst_video_format_get_info (format ?
+        gst_video_format_from_string (format) : GST_VIDEO_FORMAT_UNKNOWN);
+    if (!finfo || GST_VIDEO_FORMAT_INFO_FORMAT (finfo) ==
+        GST_VIDEO_FORMAT_UNKNOWN) {
+      gst_caps_unref (c);
+      continue;
+    }
+    deep = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0) > 8;
+
+    /* planes are only extracted in component mode */
+    if (!planar && GST_VIDEO_FORMAT_INFO_N_PLANES (finfo) > 1) {
+      gst_caps_unref (c);
       continue;
+    }
 
     if (direction == GST_PAD_SRC) {
-      /* we're on gray side, return color caps */
-      if (gst_caps_is_subset (c, gray8_caps)) {
-        tgt_caps = rgb8_caps;
-      } else {
-        tgt_caps = rgb16_caps;
+      /* we're on gray side, return packed then planar color caps */
+      GstCaps *planar_caps = deep ? planar16_caps : planar8_caps;
+      const GValue *formats;
+      guint j;
+
+      planar_other = gst_caps_new_empty ();
+      formats =
+          gst_structure_get_value (gst_caps_get_structure (planar_caps, 0),
+          "format");
+      for (j = 0; planar && j < gst_value_list_get_size (formats); j++) {
+        const GValue *planar_format = gst_value_list_get_value (formats, j);
+        GstCaps *pc = gst_caps_copy (c);
+        GstStructure *ps = gst_caps_get_structure (pc, 0);
+        const GstVideoFormatInfo *pinfo =
+            gst_video_format_get_info (gst_video_format_from_string
+            (g_value_get_string (planar_format)));
+
+        gst_structure_set_value (ps, "format", planar_format);
+        gst_extract_color_scale_dimension (ps, "width",
+            GST_VIDEO_FORMAT_INFO_W_SUB (pinfo, comp), FALSE);
+        gst_extract_color_scale_dimension (ps, "height",
+            GST_VIDEO_FORMAT_INFO_H_SUB (pinfo, comp), FALSE);
+        gst_caps_merge (planar_other, pc);
       }
+
+      gst_structure_set_value (s, "format",
+          gst_structure_get_value (gst_caps_get_structure (deep ? rgb16_caps :
+                  rgb8_caps, 0), "format"));
     } else {
-      /* we're on color side, return gray caps */
-      if (gst_caps_is_subset (c, rgb8_caps)) {
-        tgt_caps = gray8_caps;
-      } else {
-        tgt_caps = gray16_caps;
+      /* we're on color side, return gray caps the size of the plane */
+      if (GST_VIDEO_FORMAT_INFO_N_PLANES (finfo) > 1) {
+        gst_extract_color_scale_dimension (s, "width",
+            GST_VIDEO_FORMAT_INFO_W_SUB (finfo, comp), TRUE);
+        gst_extract_color_scale_dimension (s, "height",
+            GST_VIDEO_FORMAT_INFO_H_SUB (finfo, comp), TRUE);
       }
-    }
 
-    format_value =
-        gst_structure_get_value (gst_caps_get_structure (tgt_caps, 0),
-        "format");
-    gst_structure_set_value (gst_caps_get_structure (c, 0), "format",
-        format_value);
+      gst_structure_set_value (s, "format",
+          gst_structure_get_value (gst_caps_get_structure (deep ? gray16_caps :
+                  gray8_caps, 0), "format"));
+    }
 
     gst_caps_merge (other_caps, c);
+    if (planar_other)
+      gst_caps_merge (other_caps, planar_other);
   }
 
   gst_caps_unref (gray8_caps);
   gst_caps_unref (gray16_caps);
   gst_caps_unref (rgb8_caps);
   gst_caps_unref (rgb16_caps);
+  gst_caps_unref (planar8_caps);
+  gst_caps_unref (planar16_caps);
   gst_caps_unref (normalized_caps);
 
   if (!gst_caps_is_empty (other_caps) && filter_caps) {
@@ -332,9 +565,165 @@ gst_extract_color_set_info (GstVideoFilter * filter, GstCaps * incaps,
   memcpy (&filt->info_in, in_info, sizeof (GstVideoInfo));
   memcpy (&filt->info_out, out_info, sizeof (GstVideoInfo));
 
+  filt->luma32 = gst_extract_color_simd_get_luma32_func (gst_simd_get_level ());
+  filt->luma64 = gst_extract_color_simd_get_luma64_func (gst_simd_get_level ());
+
+  if (GST_VIDEO_INFO_COMP_DEPTH (in_info, 0) == 16) {
+    filt->copy64 =
+        gst_extract_color_simd_get_copy64_func (gst_simd_get_level ());
+    GST_DEBUG_OBJECT (filt, "Using %s kernels for 16-bit extraction",
+        gst_simd_get_name (gst_simd_get_level ()));
+  }
+
   return res;
 }
 
+static gboolean
+gst_extract_color_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query)
+{
+  GstExtractColor *filt = GST_EXTRACT_COLOR (trans);
+
+  /* planes can only be passed on with their own stride if downstream
+   * understands video meta */
+  filt->downstream_video_meta =
+      gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
+
+  return
+      GST_BASE_TRANSFORM_CLASS (gst_extract_color_parent_class)->decide_allocation
+      (trans, query);
+}
+
+static GstFlowReturn
+gst_extract_color_prepare_output_buffer (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer ** outbuf)
+{
+  GstExtractColor *filt = GST_EXTRACT_COLOR (trans);
+  GstVideoInfo *info_in = &filt->info_in;
+  GstVideoInfo *info_out = &filt->info_out;
+  GstVideoMeta *meta;
+  guint comp = filt->component;
+  guint plane;
+  gsize offset, size, buf_size;
+  gint stride;
+
+  filt->zero_copy = FALSE;
+
+  if (GST_VIDEO_INFO_N_PLANES (info_in) == 1 ||
+      filt->mode != GST_EXTRACT_COLOR_MODE_COMPONENT)
+    goto copy;
+
+  plane = GST_VIDEO_INFO_COMP_PLANE (info_in, comp);
+  meta = gst_buffer_get_video_meta (inbuf);
+  if (meta) {
+    offset = meta->offset[plane];
+    stride = meta->stride[plane];
+  } else {
+    offset = GST_VIDEO_INFO_PLANE_OFFSET (info_in, plane);
+    stride = GST_VIDEO_INFO_PLANE_STRIDE (info_in, plane);
+  }
+
+  if (stride != GST_VIDEO_INFO_PLANE_STRIDE (info_out, 0) &&
+      !filt->downstream_video_meta)
+    goto copy;
+
+  buf_size = gst_buffer_get_size (inbuf);
+  size = (gsize) stride * GST_VIDEO_INFO_HEIGHT (info_out);
+  if (offset >= buf_size)
+    goto copy;
+  size = MIN (size, buf_size - offset);
+
+  /* share the memory of the plane */
+  *outbuf = gst_buffer_copy_region (inbuf, GST_BUFFER_COPY_MEMORY, offset,
+      size);
+  if (!*outbuf)
+    goto copy;
+
+  if (stride != GST_VIDEO_INFO_PLANE_STRIDE (info_out, 0)) {
+    gsize offsets[GST_VIDEO_MAX_PLANES] = { 0, };
+    gint strides[GST_VIDEO_MAX_PLANES] = { stride, };
+
+    gst_buffer_add_video_meta_full (*outbuf, GST_VIDEO_FRAME_FLAG_NONE,
+        GST_VIDEO_INFO_FORMAT (info_out), GST_VIDEO_INFO_WIDTH (info_out),
+        GST_VIDEO_INFO_HEIGHT (info_out), 1, offsets, strides);
+  }
+
+  GST_BASE_TRANSFORM_GET_CLASS (trans)->copy_metadata (trans, inbuf, *outbuf);
+
+  GST_LOG_OBJECT (filt, "Sharing plane %u, offset %" G_GSIZE_FORMAT
+      " stride %d", plane, offset, stride);
+  filt->zero_copy = TRUE;
+
+  return GST_FLOW_OK;
+
+copy:
+  return
+      GST_BASE_TRANSFORM_CLASS
+      (gst_extract_color_parent_class)->prepare_output_buffer (trans, inbuf,
+      outbuf);
+}
+
+static GstFlowReturn
+gst_extract_color_transform (GstBaseTransform * trans, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstExtractColor *filt = GST_EXTRACT_COLOR (trans);
+
+  /* the output already is the plane */
+  if (filt->zero_copy)
+    return GST_FLOW_OK;
+
+  return GST_BASE_TRANSFORM_CLASS (gst_extract_color_parent_class)->transform
+      (trans, inbuf, outbuf);
+}
+
+/* fixed-point luma weights, indexed by position within the pixel */
+static void
+gst_extract_color_get_luma_weights (GstExtractColor * filt,
+    const GstVideoInfo * info, gint weights[4])
+{
+  const gint depth = GST_VIDEO_INFO_COMP_DEPTH (info, 0);
+  const gint one = 1 << (depth == 16 ? GST_EXTRACT_COLOR_LUMA16_SHIFT :
+      GST_EXTRACT_COLOR_LUMA8_SHIFT);
+  gdouble w[3], sum;
+  gint fixed[3], comp, largest = 0;
+
+  switch (filt->luma_matrix) {
+    case GST_EXTRACT_COLOR_LUMA_MATRIX_BT601:
+      w[0] = 0.299;
+      w[1] = 0.587;
+      w[2] = 0.114;
+      break;
+    case GST_EXTRACT_COLOR_LUMA_MATRIX_BT709:
+      w[0] = 0.2126;
+      w[1] = 0.7152;
+      w[2] = 0.0722;
+      break;
+    default:
+      w[0] = filt->luma_weights[0];
+      w[1] = filt->luma_weights[1];
+      w[2] = filt->luma_weights[2];
+      break;
+  }
+
+  sum = w[0] + w[1] + w[2];
+  for (comp = 0; comp < 3; comp++) {
+    fixed[comp] = sum > 0 ? (gint) (w[comp] / sum * one + 0.5) : 0;
+    if (fixed[comp] > fixed[largest])
+      largest = comp;
+  }
+
+  /* make the weights sum to exactly one, so white stays white and the
+   * kernels can't overflow */
+  if (sum > 0)
+    fixed[largest] = one - (fixed[0] + fixed[1] + fixed[2] - fixed[largest]);
+
+  weights[0] = weights[1] = weights[2] = weights[3] = 0;
+  for (comp = 0; comp < 3; comp++)
+    weights[GST_VIDEO_INFO_COMP_OFFSET (info, comp) / (depth / 8)] =
+        fixed[comp];
+}
+
 static GstFlowReturn
 gst_extract_color_transform_frame (GstVideoFilter * filter,
     GstVideoFrame * in_frame, GstVideoFrame * out_frame)
@@ -349,7 +738,48 @@ gst_extract_color_transform_frame (GstVideoFilter * filter,
   timer = g_timer_new ();
 #endif
 
-  if (GST_VIDEO_FRAME_COMP_DEPTH (in_frame, comp) == 8) {
+  if (GST_VIDEO_FRAME_N_PLANES (in_frame) > 1) {
+    /* planar, but the plane couldn't be shared */
+    gint y;
+    guint8 *src = GST_VIDEO_FRAME_COMP_DATA (in_frame, comp);
+    guint8 *dst = GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0);
+    const gint row_size = GST_VIDEO_FRAME_COMP_WIDTH (in_frame, comp) *
+        GST_VIDEO_FRAME_COMP_PSTRIDE (in_frame, comp);
+
+    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (in_frame, comp); y++) {
+      memcpy (dst, src, row_size);
+      src += GST_VIDEO_FRAME_COMP_STRIDE (in_frame, comp);
+      dst += GST_VIDEO_FRAME_PLANE_STRIDE (out_frame, 0);
+    }
+  } else if (filt->mode == GST_EXTRACT_COLOR_MODE_LUMA) {
+    gint x, y;
+    guint8 *src = GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0);
+    guint8 *dst = GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0);
+    const gint width = GST_VIDEO_FRAME_WIDTH (in_frame);
+    const gint pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (in_frame, 0);
+    const gint depth = GST_VIDEO_FRAME_COMP_DEPTH (in_frame, 0);
+    gint weights[4];
+
+    gst_extract_color_get_luma_weights (filt, &in_frame->info, weights);
+
+    for (y = 0; y < GST_VIDEO_FRAME_HEIGHT (out_frame); y++) {
+      if (depth == 16) {
+        filt->luma64 ((guint16 *) dst, (const guint16 *) src, width, weights);
+      } else if (pstride == 4) {
+        filt->luma32 (dst, src, width, weights);
+      } else {
+        /* packed 24-bit */
+        for (x = 0; x < width; x++) {
+          const guint8 *p = src + x * 3;
+          dst[x] = (weights[0] * p[0] + weights[1] * p[1] +
+              weights[2] * p[2] + (1 << (GST_EXTRACT_COLOR_LUMA8_SHIFT - 1)))
+              >> GST_EXTRACT_COLOR_LUMA8_SHIFT;
+        }
+      }
+      src += GST_VIDEO_FRAME_PLANE_STRIDE (in_frame, 0);
+      dst += GST_VIDEO_FRAME_PLANE_STRIDE (out_frame, 0);
+    }
+  } else if (GST_VIDEO_FRAME_COMP_DEPTH (in_frame, comp) == 8) {
     guint8 *src, *dst;
 
     src = GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0);
@@ -397,16 +827,19 @@ gst_extract_color_transform_frame (GstVideoFilter * filter,
     }
 #endif
   } else {
-    gint x, y;
-    guint16 *src = (guint16 *) GST_VIDEO_FRAME_COMP_DATA (in_frame, comp);
-    guint16 *dst = (guint16 *) GST_VIDEO_FRAME_COMP_DATA (out_frame, 0);
-    const guint pstride = GST_VIDEO_FRAME_COMP_PSTRIDE (in_frame, comp) / 2;
-    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (in_frame, comp); y++) {
-      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (in_frame, comp); x++) {
-        dst[x] = src[x * pstride];
-      }
-      src += GST_VIDEO_FRAME_COMP_STRIDE (in_frame, comp) / 2;
-      dst += GST_VIDEO_FRAME_COMP_STRIDE (out_frame, 0) / 2;
+    gint y;
+    guint8 *src = GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0);
+    guint8 *dst = GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0);
+    const gint word = GST_VIDEO_FRAME_COMP_OFFSET (in_frame, comp) / 2;
+
+    /* all 16-bit formats are four words per pixel */
+    g_assert (GST_VIDEO_FRAME_COMP_PSTRIDE (in_frame, comp) == 8);
+
+    for (y = 0; y < GST_VIDEO_FRAME_HEIGHT (out_frame); y++) {
+      filt->copy64 ((guint16 *) dst, (const guint16 *) src,
+          GST_VIDEO_FRAME_WIDTH (in_frame), word);
+      src += GST_VIDEO_FRAME_PLANE_STRIDE (in_frame, 0);
+      dst += GST_VIDEO_FRAME_PLANE_STRIDE (out_frame, 0);
     }
   }
 
@@ -425,6 +858,8 @@ gst_extract_color_reset (GstExtractColor * extract_color)
 {
   gst_video_info_init (&extract_color->info_in);
   gst_video_info_init (&extract_color->info_out);
+  extract_color->copy64 = NULL;
+  extract_color->zero_copy = FALSE;
 }
 
 /* Register filters that make up the gstgl plugin */
@@ -442,6 +877,13 @@ plugin_init (GstPlugin * plugin)
     return FALSE;
   }
 
+  GST_CAT_INFO (GST_CAT_DEFAULT, "registering deinterleavecolor element");
+
+  if (!gst_element_register (plugin, "deinterleavecolor", GST_RANK_NONE,
+          GST_TYPE_DEINTERLEAVE_COLOR)) {
+    return FALSE;
+  }
+
   return TRUE;
 }
 
@@ -28,6 +28,8 @@
 #include <gst/video/gstvideofilter.h>
 #include <gst/video/video.h>
 
+#include "gstextractcolorsimd.h"
+
 G_BEGIN_DECLS
 
 #define GST_TYPE_EXTRACT_COLOR \
@@ -58,6 +60,33 @@ typedef enum {
   GST_EXTRACT_COLOR_COMPONENT_BLUE
 } GstExtractColorComponent;
 
+/**
+* GstExtractColorMode:
+* @GST_EXTRACT_COLOR_MODE_COMPONENT: output a single component
+* @GST_EXTRACT_COLOR_MODE_LUMA: output a weighted sum of the components
+*
+* What to output.
+*/
+typedef enum {
+  GST_EXTRACT_COLOR_MODE_COMPONENT,
+  GST_EXTRACT_COLOR_MODE_LUMA
+} GstExtractColorMode;
+
+/**
+* GstExtractColorLumaMatrix:
+* @GST_EXTRACT_COLOR_LUMA_MATRIX_BT601: ITU-R BT.601 luma weights
+* @GST_EXTRACT_COLOR_LUMA_MATRIX_BT709: ITU-R BT.709 luma weights
+* @GST_EXTRACT_COLOR_LUMA_MATRIX_CUSTOM: weights from the red-weight,
+*     green-weight and blue-weight properties
+*
+* Weights of the components in luma mode.
+*/
+typedef enum {
+  GST_EXTRACT_COLOR_LUMA_MATRIX_BT601,
+  GST_EXTRACT_COLOR_LUMA_MATRIX_BT709,
+  GST_EXTRACT_COLOR_LUMA_MATRIX_CUSTOM
+} GstExtractColorLumaMatrix;
+
 /**
 * GstExtractColor:
 * @element: the parent element.
@@ -75,6 +104,20 @@ struct _GstExtractColor
 
   /* properties */
   GstExtractColorComponent component;
+  GstExtractColorMode mode;
+  GstExtractColorLumaMatrix luma_matrix;
+  gdouble luma_weights[3];
+
+  /* 16-bit extraction kernel */
+  GstExtractColorCopy64Func copy64;
+
+  /* luma kernels */
+  GstExtractColorLuma32Func luma32;
+  GstExtractColorLuma64Func luma64;
+
+  /* planar input */
+  gboolean downstream_video_meta;
+  gboolean zero_copy;
 };
 
 struct _GstExtractColorClass
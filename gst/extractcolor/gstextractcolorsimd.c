@@ -0,0 +1,591 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Vectorized kernels for extractcolor.
+ *
+ * The 16-bit formats have four words per pixel. Each kernel gathers the
+ * requested word of every pixel with byte shuffles, so the output is simply
+ * a copy and identical to the scalar loop.
+ *
+ * The deinterleave kernels split every component at once: a shuffle
+ * transposes the pixels within each 128-bit register so that each 32-bit
+ * slot holds one component, then a 4x4 transpose of those slots across four
+ * registers leaves one component per register.
+ *
+ * The luma kernels use the same fixed-point arithmetic as the scalar loop,
+ * widening to 32-bit lanes for the products, so all paths are bit-exact.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstextractcolorsimd.h"
+
+static void
+copy64_scalar (guint16 * dst, const guint16 * src, gint n, gint word)
+{
+  gint i;
+
+  src += word;
+  for (i = 0; i < n; i++)
+    dst[i] = src[i * 4];
+}
+
+static void
+deinterleave32_scalar (guint8 * dst[4], const guint8 * src, gint n)
+{
+  gint c, i;
+
+  for (c = 0; c < 4; c++) {
+    if (dst[c]) {
+      for (i = 0; i < n; i++)
+        dst[c][i] = src[i * 4 + c];
+    }
+  }
+}
+
+static void
+deinterleave64_scalar (guint16 * dst[4], const guint16 * src, gint n)
+{
+  gint c, i;
+
+  for (c = 0; c < 4; c++) {
+    if (dst[c]) {
+      for (i = 0; i < n; i++)
+        dst[c][i] = src[i * 4 + c];
+    }
+  }
+}
+
+static void
+luma32_scalar (guint8 * dst, const guint8 * src, gint n, const gint weights[4])
+{
+  const guint round = 1 << (GST_EXTRACT_COLOR_LUMA8_SHIFT - 1);
+  gint i;
+
+  for (i = 0; i < n; i++) {
+    const guint8 *p = src + i * 4;
+    dst[i] = (weights[0] * p[0] + weights[1] * p[1] + weights[2] * p[2] +
+        weights[3] * p[3] + round) >> GST_EXTRACT_COLOR_LUMA8_SHIFT;
+  }
+}
+
+static void
+luma64_scalar (guint16 * dst, const guint16 * src, gint n,
+    const gint weights[4])
+{
+  const guint round = 1 << (GST_EXTRACT_COLOR_LUMA16_SHIFT - 1);
+  gint i;
+
+  for (i = 0; i < n; i++) {
+    const guint16 *p = src + i * 4;
+    dst[i] = ((guint) weights[0] * p[0] + (guint) weights[1] * p[1] +
+        (guint) weights[2] * p[2] + (guint) weights[3] * p[3] +
+        round) >> GST_EXTRACT_COLOR_LUMA16_SHIFT;
+  }
+}
+
+#ifdef HAVE_X86_SIMD
+
+/* byte shuffle moving the given word of both pixels in a 128-bit lane into
+ * 32-bit slot @slot, zeroing everything else */
+static void
+copy64_mask (guint8 mask[16], gint word, gint slot)
+{
+  gint i;
+
+  for (i = 0; i < 16; i++)
+    mask[i] = 0x80;
+
+  mask[slot * 4 + 0] = word * 2;
+  mask[slot * 4 + 1] = word * 2 + 1;
+  mask[slot * 4 + 2] = 8 + word * 2;
+  mask[slot * 4 + 3] = 8 + word * 2 + 1;
+}
+
+/* SSE4.1: 8 pixels per iteration, 2 pixels per register */
+
+static TARGET_SSE41 void
+copy64_sse41 (guint16 * dst, const guint16 * src, gint n, gint word)
+{
+  guint8 m[4][16];
+  __m128i m0, m1, m2, m3;
+  gint i;
+
+  for (i = 0; i < 4; i++)
+    copy64_mask (m[i], word, i);
+  m0 = _mm_loadu_si128 ((const __m128i *) m[0]);
+  m1 = _mm_loadu_si128 ((const __m128i *) m[1]);
+  m2 = _mm_loadu_si128 ((const __m128i *) m[2]);
+  m3 = _mm_loadu_si128 ((const __m128i *) m[3]);
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    const __m128i *s = (const __m128i *) (src + i * 4);
+    __m128i r0 = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 0), m0);
+    __m128i r1 = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 1), m1);
+    __m128i r2 = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 2), m2);
+    __m128i r3 = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 3), m3);
+
+    _mm_storeu_si128 ((__m128i *) (dst + i),
+        _mm_or_si128 (_mm_or_si128 (r0, r1), _mm_or_si128 (r2, r3)));
+  }
+
+  copy64_scalar (dst + i, src + i * 4, n - i, word);
+}
+
+/* AVX2: 16 pixels per iteration, 4 pixels per register. Shuffles stay
+ * within 128-bit lanes, so the low lane collects pixels 0-1, 4-5, 8-9 and
+ * 12-13 and a final permute puts the pairs back in order. */
+
+static TARGET_AVX2 void
+copy64_avx2 (guint16 * dst, const guint16 * src, gint n, gint word)
+{
+  guint8 m[4][16];
+  __m256i m0, m1, m2, m3, order;
+  gint i;
+
+  for (i = 0; i < 4; i++)
+    copy64_mask (m[i], word, i);
+  m0 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) m[0]));
+  m1 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) m[1]));
+  m2 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) m[2]));
+  m3 = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) m[3]));
+  order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+
+  for (i = 0; i + 16 <= n; i += 16) {
+    const __m256i *s = (const __m256i *) (src + i * 4);
+    __m256i r0 = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 0), m0);
+    __m256i r1 = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 1), m1);
+    __m256i r2 = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 2), m2);
+    __m256i r3 = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 3), m3);
+    __m256i r = _mm256_or_si256 (_mm256_or_si256 (r0, r1),
+        _mm256_or_si256 (r2, r3));
+
+    _mm256_storeu_si256 ((__m256i *) (dst + i),
+        _mm256_permutevar8x32_epi32 (r, order));
+  }
+
+  copy64_scalar (dst + i, src + i * 4, n - i, word);
+}
+
+/* per 128-bit lane, group four 32-bit pixels or two 64-bit pixels by
+ * component, one component per 32-bit slot */
+#define SHUFFLE_32 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15
+#define SHUFFLE_64 0, 1, 8, 9, 2, 3, 10, 11, 4, 5, 12, 13, 6, 7, 14, 15
+
+/* transpose the 32-bit slots of four registers */
+#define TRANSPOSE_SSE(r0, r1, r2, r3) G_STMT_START {  \
+  __m128i t0 = _mm_unpacklo_epi32 (r0, r1);           \
+  __m128i t1 = _mm_unpackhi_epi32 (r0, r1);           \
+  __m128i t2 = _mm_unpacklo_epi32 (r2, r3);           \
+  __m128i t3 = _mm_unpackhi_epi32 (r2, r3);           \
+  r0 = _mm_unpacklo_epi64 (t0, t2);                   \
+  r1 = _mm_unpackhi_epi64 (t0, t2);                   \
+  r2 = _mm_unpacklo_epi64 (t1, t3);                   \
+  r3 = _mm_unpackhi_epi64 (t1, t3);                   \
+} G_STMT_END
+
+#define TRANSPOSE_AVX2(r0, r1, r2, r3) G_STMT_START { \
+  __m256i t0 = _mm256_unpacklo_epi32 (r0, r1);        \
+  __m256i t1 = _mm256_unpackhi_epi32 (r0, r1);        \
+  __m256i t2 = _mm256_unpacklo_epi32 (r2, r3);        \
+  __m256i t3 = _mm256_unpackhi_epi32 (r2, r3);        \
+  r0 = _mm256_unpacklo_epi64 (t0, t2);                \
+  r1 = _mm256_unpackhi_epi64 (t0, t2);                \
+  r2 = _mm256_unpacklo_epi64 (t1, t3);                \
+  r3 = _mm256_unpackhi_epi64 (t1, t3);                \
+} G_STMT_END
+
+/* one 64-byte block of input, giving 16 8-bit or 8 16-bit pixels per
+ * component */
+static inline TARGET_SSE41 void
+deinterleave_sse41_block (guint8 * dst[4], const guint8 * src, gint offset,
+    __m128i shuffle)
+{
+  const __m128i *s = (const __m128i *) src;
+  __m128i r[4];
+  gint c;
+
+  r[0] = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 0), shuffle);
+  r[1] = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 1), shuffle);
+  r[2] = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 2), shuffle);
+  r[3] = _mm_shuffle_epi8 (_mm_loadu_si128 (s + 3), shuffle);
+  TRANSPOSE_SSE (r[0], r[1], r[2], r[3]);
+
+  for (c = 0; c < 4; c++) {
+    if (dst[c])
+      _mm_storeu_si128 ((__m128i *) (dst[c] + offset), r[c]);
+  }
+}
+
+static TARGET_SSE41 void
+deinterleave32_sse41 (guint8 * dst[4], const guint8 * src, gint n)
+{
+  const __m128i shuffle = _mm_setr_epi8 (SHUFFLE_32);
+  guint8 *tail[4];
+  gint c, i;
+
+  for (i = 0; i + 16 <= n; i += 16)
+    deinterleave_sse41_block (dst, src + i * 4, i, shuffle);
+
+  for (c = 0; c < 4; c++)
+    tail[c] = dst[c] ? dst[c] + i : NULL;
+  deinterleave32_scalar (tail, src + i * 4, n - i);
+}
+
+static TARGET_SSE41 void
+deinterleave64_sse41 (guint16 * dst[4], const guint16 * src, gint n)
+{
+  const __m128i shuffle = _mm_setr_epi8 (SHUFFLE_64);
+  guint16 *tail[4];
+  gint c, i;
+
+  for (i = 0; i + 8 <= n; i += 8)
+    deinterleave_sse41_block ((guint8 **) dst, (const guint8 *) (src + i * 4),
+        i * 2, shuffle);
+
+  for (c = 0; c < 4; c++)
+    tail[c] = dst[c] ? dst[c] + i : NULL;
+  deinterleave64_scalar (tail, src + i * 4, n - i);
+}
+
+/* one 128-byte block of input, giving 32 8-bit or 16 16-bit pixels per
+ * component. In-lane shuffles and transposes leave the 32-bit groups of the
+ * two lanes interleaved, which the final permute undoes. */
+static inline TARGET_AVX2 void
+deinterleave_avx2_block (guint8 * dst[4], const guint8 * src, gint offset,
+    __m256i shuffle, __m256i order)
+{
+  const __m256i *s = (const __m256i *) src;
+  __m256i r[4];
+  gint c;
+
+  r[0] = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 0), shuffle);
+  r[1] = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 1), shuffle);
+  r[2] = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 2), shuffle);
+  r[3] = _mm256_shuffle_epi8 (_mm256_loadu_si256 (s + 3), shuffle);
+  TRANSPOSE_AVX2 (r[0], r[1], r[2], r[3]);
+
+  for (c = 0; c < 4; c++) {
+    if (dst[c])
+      _mm256_storeu_si256 ((__m256i *) (dst[c] + offset),
+          _mm256_permutevar8x32_epi32 (r[c], order));
+  }
+}
+
+static TARGET_AVX2 void
+deinterleave32_avx2 (guint8 * dst[4], const guint8 * src, gint n)
+{
+  const __m256i shuffle = _mm256_setr_epi8 (SHUFFLE_32, SHUFFLE_32);
+  const __m256i order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+  guint8 *tail[4];
+  gint c, i;
+
+  for (i = 0; i + 32 <= n; i += 32)
+    deinterleave_avx2_block (dst, src + i * 4, i, shuffle, order);
+
+  for (c = 0; c < 4; c++)
+    tail[c] = dst[c] ? dst[c] + i : NULL;
+  deinterleave32_scalar (tail, src + i * 4, n - i);
+}
+
+static TARGET_AVX2 void
+deinterleave64_avx2 (guint16 * dst[4], const guint16 * src, gint n)
+{
+  const __m256i shuffle = _mm256_setr_epi8 (SHUFFLE_64, SHUFFLE_64);
+  const __m256i order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+  guint16 *tail[4];
+  gint c, i;
+
+  for (i = 0; i + 16 <= n; i += 16)
+    deinterleave_avx2_block ((guint8 **) dst, (const guint8 *) (src + i * 4),
+        i * 2, shuffle, order);
+
+  for (c = 0; c < 4; c++)
+    tail[c] = dst[c] ? dst[c] + i : NULL;
+  deinterleave64_scalar (tail, src + i * 4, n - i);
+}
+
+/* 8-bit luma: bytes are widened to 16 bits and multiplied and summed in
+ * pairs by madd, weights fitting a signed 16-bit word */
+
+static inline TARGET_SSE41 __m128i
+luma32_sse41_4 (const guint8 * src, __m128i w, __m128i round)
+{
+  __m128i x = _mm_loadu_si128 ((const __m128i *) src);
+  __m128i a = _mm_madd_epi16 (_mm_cvtepu8_epi16 (x), w);
+  __m128i b = _mm_madd_epi16 (_mm_cvtepu8_epi16 (_mm_srli_si128 (x, 8)), w);
+
+  return _mm_srli_epi32 (_mm_add_epi32 (_mm_hadd_epi32 (a, b), round),
+      GST_EXTRACT_COLOR_LUMA8_SHIFT);
+}
+
+static TARGET_SSE41 void
+luma32_sse41 (guint8 * dst, const guint8 * src, gint n, const gint weights[4])
+{
+  const __m128i w = _mm_setr_epi16 (weights[0], weights[1], weights[2],
+      weights[3], weights[0], weights[1], weights[2], weights[3]);
+  const __m128i round = _mm_set1_epi32 (1 << (GST_EXTRACT_COLOR_LUMA8_SHIFT
+          - 1));
+  gint i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i s0 = luma32_sse41_4 (src + i * 4, w, round);
+    __m128i s1 = luma32_sse41_4 (src + i * 4 + 16, w, round);
+    __m128i r = _mm_packus_epi32 (s0, s1);
+
+    _mm_storel_epi64 ((__m128i *) (dst + i), _mm_packus_epi16 (r, r));
+  }
+
+  luma32_scalar (dst + i, src + i * 4, n - i, weights);
+}
+
+/* in-lane horizontal adds leave pixels 0-1, 4-5 in the low lane and 2-3,
+ * 6-7 in the high lane */
+static inline TARGET_AVX2 __m256i
+luma32_avx2_8 (const guint8 * src, __m256i w, __m256i round, __m256i order)
+{
+  __m256i a = _mm256_madd_epi16 (_mm256_cvtepu8_epi16 (_mm_loadu_si128
+          ((const __m128i *) src)), w);
+  __m256i b = _mm256_madd_epi16 (_mm256_cvtepu8_epi16 (_mm_loadu_si128
+          ((const __m128i *) (src + 16))), w);
+  __m256i s = _mm256_add_epi32 (_mm256_hadd_epi32 (a, b), round);
+
+  return _mm256_permutevar8x32_epi32 (_mm256_srli_epi32 (s,
+          GST_EXTRACT_COLOR_LUMA8_SHIFT), order);
+}
+
+static TARGET_AVX2 void
+luma32_avx2 (guint8 * dst, const guint8 * src, gint n, const gint weights[4])
+{
+  const __m256i w = _mm256_setr_epi16 (weights[0], weights[1], weights[2],
+      weights[3], weights[0], weights[1], weights[2], weights[3], weights[0],
+      weights[1], weights[2], weights[3], weights[0], weights[1], weights[2],
+      weights[3]);
+  const __m256i round =
+      _mm256_set1_epi32 (1 << (GST_EXTRACT_COLOR_LUMA8_SHIFT - 1));
+  const __m256i order = _mm256_setr_epi32 (0, 1, 4, 5, 2, 3, 6, 7);
+  gint i;
+
+  for (i = 0; i + 16 <= n; i += 16) {
+    __m256i s0 = luma32_avx2_8 (src + i * 4, w, round, order);
+    __m256i s1 = luma32_avx2_8 (src + i * 4 + 32, w, round, order);
+    __m128i r0 = _mm_packus_epi32 (_mm256_castsi256_si128 (s0),
+        _mm256_extracti128_si256 (s0, 1));
+    __m128i r1 = _mm_packus_epi32 (_mm256_castsi256_si128 (s1),
+        _mm256_extracti128_si256 (s1, 1));
+
+    _mm_storeu_si128 ((__m128i *) (dst + i), _mm_packus_epi16 (r0, r1));
+  }
+
+  luma32_scalar (dst + i, src + i * 4, n - i, weights);
+}
+
+/* 16-bit luma: words are unsigned, so they're widened to 32 bits and
+ * multiplied there. Sums stay below 1 << 31 as the weights sum to at most
+ * one. */
+
+static inline TARGET_SSE41 __m128i
+luma64_sse41_1 (const guint16 * src, __m128i w)
+{
+  return _mm_mullo_epi32 (_mm_cvtepu16_epi32 (_mm_loadl_epi64 ((const __m128i
+                  *) src)), w);
+}
+
+static inline TARGET_SSE41 __m128i
+luma64_sse41_4 (const guint16 * src, __m128i w, __m128i round)
+{
+  __m128i a = _mm_hadd_epi32 (luma64_sse41_1 (src, w),
+      luma64_sse41_1 (src + 4, w));
+  __m128i b = _mm_hadd_epi32 (luma64_sse41_1 (src + 8, w),
+      luma64_sse41_1 (src + 12, w));
+
+  return _mm_srli_epi32 (_mm_add_epi32 (_mm_hadd_epi32 (a, b), round),
+      GST_EXTRACT_COLOR_LUMA16_SHIFT);
+}
+
+static TARGET_SSE41 void
+luma64_sse41 (guint16 * dst, const guint16 * src, gint n,
+    const gint weights[4])
+{
+  const __m128i w = _mm_setr_epi32 (weights[0], weights[1], weights[2],
+      weights[3]);
+  const __m128i round = _mm_set1_epi32 (1 << (GST_EXTRACT_COLOR_LUMA16_SHIFT
+          - 1));
+  gint i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i s0 = luma64_sse41_4 (src + i * 4, w, round);
+    __m128i s1 = luma64_sse41_4 (src + i * 4 + 16, w, round);
+
+    _mm_storeu_si128 ((__m128i *) (dst + i), _mm_packus_epi32 (s0, s1));
+  }
+
+  luma64_scalar (dst + i, src + i * 4, n - i, weights);
+}
+
+static inline TARGET_AVX2 __m256i
+luma64_avx2_2 (const guint16 * src, __m256i w)
+{
+  return _mm256_mullo_epi32 (_mm256_cvtepu16_epi32 (_mm_loadu_si128 ((const
+                  __m128i *) src)), w);
+}
+
+/* in-lane horizontal adds leave even pixels in the low lane and odd pixels
+ * in the high lane */
+static TARGET_AVX2 void
+luma64_avx2 (guint16 * dst, const guint16 * src, gint n,
+    const gint weights[4])
+{
+  const __m256i w = _mm256_setr_epi32 (weights[0], weights[1], weights[2],
+      weights[3], weights[0], weights[1], weights[2], weights[3]);
+  const __m256i round =
+      _mm256_set1_epi32 (1 << (GST_EXTRACT_COLOR_LUMA16_SHIFT - 1));
+  const __m256i order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+  gint i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    const guint16 *p = src + i * 4;
+    __m256i a = _mm256_hadd_epi32 (luma64_avx2_2 (p, w),
+        luma64_avx2_2 (p + 8, w));
+    __m256i b = _mm256_hadd_epi32 (luma64_avx2_2 (p + 16, w),
+        luma64_avx2_2 (p + 24, w));
+    __m256i s = _mm256_add_epi32 (_mm256_hadd_epi32 (a, b), round);
+
+    s = _mm256_permutevar8x32_epi32 (_mm256_srli_epi32 (s,
+            GST_EXTRACT_COLOR_LUMA16_SHIFT), order);
+    _mm_storeu_si128 ((__m128i *) (dst + i),
+        _mm_packus_epi32 (_mm256_castsi256_si128 (s),
+            _mm256_extracti128_si256 (s, 1)));
+  }
+
+  luma64_scalar (dst + i, src + i * 4, n - i, weights);
+}
+
+#endif /* HAVE_X86_SIMD */
+
+/**
+ * gst_extract_color_simd_get_copy64_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 16-bit component extraction kernel for @level, falling back to
+ * a scalar loop
+ */
+GstExtractColorCopy64Func
+gst_extract_color_simd_get_copy64_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return copy64_avx2;
+    case GST_SIMD_SSE41:
+      return copy64_sse41;
+#endif
+    default:
+      return copy64_scalar;
+  }
+}
+
+/**
+ * gst_extract_color_simd_get_deinterleave32_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 8-bit deinterleave kernel for @level, falling back to a scalar
+ * loop
+ */
+GstExtractColorDeinterleave32Func
+gst_extract_color_simd_get_deinterleave32_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return deinterleave32_avx2;
+    case GST_SIMD_SSE41:
+      return deinterleave32_sse41;
+#endif
+    default:
+      return deinterleave32_scalar;
+  }
+}
+
+/**
+ * gst_extract_color_simd_get_deinterleave64_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 16-bit deinterleave kernel for @level, falling back to a
+ * scalar loop
+ */
+GstExtractColorDeinterleave64Func
+gst_extract_color_simd_get_deinterleave64_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return deinterleave64_avx2;
+    case GST_SIMD_SSE41:
+      return deinterleave64_sse41;
+#endif
+    default:
+      return deinterleave64_scalar;
+  }
+}
+
+/**
+ * gst_extract_color_simd_get_luma32_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 8-bit luma kernel for @level, falling back to a scalar loop
+ */
+GstExtractColorLuma32Func
+gst_extract_color_simd_get_luma32_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return luma32_avx2;
+    case GST_SIMD_SSE41:
+      return luma32_sse41;
+#endif
+    default:
+      return luma32_scalar;
+  }
+}
+
+/**
+ * gst_extract_color_simd_get_luma64_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the 16-bit luma kernel for @level, falling back to a scalar loop
+ */
+GstExtractColorLuma64Func
+gst_extract_color_simd_get_luma64_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return luma64_avx2;
+    case GST_SIMD_SSE41:
+      return luma64_sse41;
+#endif
+    default:
+      return luma64_scalar;
+  }
+}
@@ -0,0 +1,109 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_EXTRACT_COLOR_SIMD_H__
+#define __GST_EXTRACT_COLOR_SIMD_H__
+
+#include <glib.h>
+
+#include "simdlevel.h"
+
+G_BEGIN_DECLS
+
+/**
+* GstExtractColorCopy64Func:
+* @dst: output row of 16-bit pixels
+* @src: input row of 64-bit pixels, four 16-bit words each
+* @n: number of pixels
+* @word: index of the word to extract from each pixel, 0 to 3
+*
+* Copy one 16-bit component out of each pixel of a row, the 64-bit
+* counterpart of the extractcolor_orc_copy32 kernels.
+*/
+typedef void (*GstExtractColorCopy64Func) (guint16 * dst, const guint16 * src,
+    gint n, gint word);
+
+/**
+* GstExtractColorDeinterleave32Func:
+* @dst: output rows of 8-bit pixels, one per byte of the input pixel, or
+*     %NULL for bytes that aren't wanted
+* @src: input row of 32-bit pixels
+* @n: number of pixels
+*
+* Split a row of 32-bit pixels into up to four 8-bit rows in one pass.
+*/
+typedef void (*GstExtractColorDeinterleave32Func) (guint8 * dst[4],
+    const guint8 * src, gint n);
+
+/**
+* GstExtractColorDeinterleave64Func:
+* @dst: output rows of 16-bit pixels, one per word of the input pixel, or
+*     %NULL for words that aren't wanted
+* @src: input row of 64-bit pixels
+* @n: number of pixels
+*
+* Split a row of 64-bit pixels into up to four 16-bit rows in one pass.
+*/
+typedef void (*GstExtractColorDeinterleave64Func) (guint16 * dst[4],
+    const guint16 * src, gint n);
+
+#define GST_EXTRACT_COLOR_LUMA8_SHIFT 14
+#define GST_EXTRACT_COLOR_LUMA16_SHIFT 15
+
+/**
+* GstExtractColorLuma32Func:
+* @dst: output row of 8-bit pixels
+* @src: input row of 32-bit pixels
+* @n: number of pixels
+* @weights: weight of each byte of the pixel, in units of
+*     1 / (1 << GST_EXTRACT_COLOR_LUMA8_SHIFT), summing to at most one
+*
+* Compute a rounded weighted sum of the bytes of each pixel.
+*/
+typedef void (*GstExtractColorLuma32Func) (guint8 * dst, const guint8 * src,
+    gint n, const gint weights[4]);
+
+/**
+* GstExtractColorLuma64Func:
+* @dst: output row of 16-bit pixels
+* @src: input row of 64-bit pixels
+* @n: number of pixels
+* @weights: weight of each word of the pixel, in units of
+*     1 / (1 << GST_EXTRACT_COLOR_LUMA16_SHIFT), summing to at most one
+*
+* Compute a rounded weighted sum of the words of each pixel.
+*/
+typedef void (*GstExtractColorLuma64Func) (guint16 * dst, const guint16 * src,
+    gint n, const gint weights[4]);
+
+GstExtractColorCopy64Func
+gst_extract_color_simd_get_copy64_func (GstSimdLevel level);
+GstExtractColorDeinterleave32Func
+gst_extract_color_simd_get_deinterleave32_func (GstSimdLevel level);
+GstExtractColorDeinterleave64Func
+gst_extract_color_simd_get_deinterleave64_func (GstSimdLevel level);
+GstExtractColorLuma32Func
+gst_extract_color_simd_get_luma32_func (GstSimdLevel level);
+GstExtractColorLuma64Func
+gst_extract_color_simd_get_luma64_func (GstSimdLevel level);
+
+G_END_DECLS
+
+#endif /* __GST_EXTRACT_COLOR_SIMD_H__ */
@@ -24,7 +24,7 @@
 /**
 * SECTION:element-misbirpack
 *
-* Pack GRAY16 to MISB IR packed video.
+* Pack GRAY16 to MISB IR packed video, either 10-bit v210 or 8-bit UYVY.
 *
 * <refsect2>
 * <title>Example launch line</title>
@@ -55,10 +55,12 @@ enum
 {
   PROP_0,
   PROP_OFFSET,
+  PROP_N_THREADS,
   PROP_LAST
 };
 
 #define DEFAULT_PROP_OFFSET 64
+#define DEFAULT_PROP_N_THREADS 1
 
 /* the capabilities of the inputs and outputs */
 static GstStaticPadTemplate gst_misb_ir_pack_sink_template =
@@ -72,7 +74,7 @@ static GstStaticPadTemplate gst_misb_ir_pack_src_template =
 GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE ("v210"))
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE ("{ v210, UYVY }"))
     );
 
 
@@ -139,6 +141,9 @@ gst_misb_ir_pack_class_init (GstMisbIrPackClass * klass)
       GST_BASE_TRANSFORM_CLASS (klass);
   GstVideoFilterClass *gstvideofilter_class = GST_VIDEO_FILTER_CLASS (klass);
 
+  GST_DEBUG_CATEGORY_INIT (misb_ir_pack_debug, "misbirpack", 0,
+      "MISB IR pack filter");
+
   GST_DEBUG ("class init");
 
   /* Register GObject vmethods */
@@ -154,6 +159,8 @@ gst_misb_ir_pack_class_init (GstMisbIrPackClass * klass)
           "Offset value",
           "Offset value to apply during packing", 0, 1023,
           DEFAULT_PROP_OFFSET, G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE));
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_N_THREADS,
+      GST_STRIPE_POOL_PARAM_SPEC_N_THREADS (DEFAULT_PROP_N_THREADS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_misb_ir_pack_sink_template));
@@ -181,8 +188,14 @@ gst_misb_ir_pack_init (GstMisbIrPack * filt)
   GST_DEBUG_OBJECT (filt, "init class instance");
 
   filt->offset_value = DEFAULT_PROP_OFFSET;
+  filt->n_threads = DEFAULT_PROP_N_THREADS;
+  filt->simd_level = gst_simd_get_level ();
+  filt->pack = gst_misb_simd_get_v210_pack_func (filt->simd_level);
   gst_base_transform_set_in_place (GST_BASE_TRANSFORM (filt), FALSE);
 
+  GST_DEBUG_OBJECT (filt, "Using %s kernels",
+      gst_simd_get_name (filt->simd_level));
+
   gst_misb_ir_pack_reset (filt);
 }
 
@@ -198,6 +211,9 @@ gst_misb_ir_pack_set_property (GObject * object, guint prop_id,
     case PROP_OFFSET:
       filt->offset_value = g_value_get_int (value);
       break;
+    case PROP_N_THREADS:
+      filt->n_threads = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -216,6 +232,9 @@ gst_misb_ir_pack_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_OFFSET:
       g_value_set_int (value, filt->offset_value);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, filt->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -238,7 +257,8 @@ gst_misb_ir_pack_transform_caps (GstBaseTransform * trans,
   for (i = 0; i < n; ++i) {
     structure = gst_caps_get_structure (caps, i);
     if (direction == GST_PAD_SINK) {
-      newstruct = gst_structure_new_from_string ("video/x-raw,format=v210");
+      newstruct =
+          gst_structure_new_from_string ("video/x-raw,format={v210,UYVY}");
     } else {
       newstruct =
           gst_structure_new_from_string ("video/x-raw,format=GRAY16_LE");
@@ -280,6 +300,15 @@ gst_misb_ir_pack_set_info (GstVideoFilter * filter, GstCaps * incaps,
   memcpy (&filt->info_in, in_info, sizeof (GstVideoInfo));
   memcpy (&filt->info_out, out_info, sizeof (GstVideoInfo));
 
+  if (GST_VIDEO_INFO_FORMAT (out_info) == GST_VIDEO_FORMAT_UYVY)
+    filt->pack = gst_misb_simd_get_uyvy_pack_func (filt->simd_level);
+  else
+    filt->pack = gst_misb_simd_get_v210_pack_func (filt->simd_level);
+
+  if (gst_stripe_pool_ensure (&filt->stripe_pool, filt->n_threads))
+    GST_DEBUG_OBJECT (filt, "Processing with %d threads",
+        filt->stripe_pool->n_threads);
+
   return res;
 }
 
@@ -288,102 +317,20 @@ gst_misb_ir_pack_transform_frame (GstVideoFilter * filter,
     GstVideoFrame * in_frame, GstVideoFrame * out_frame)
 {
   GstMisbIrPack *filt = GST_MISB_IR_PACK (filter);
-  GTimer *timer = NULL;
-  guint offset = filt->offset_value;
-  gint y;
-  guint16 *src, *src_end;
-  guint32 *dst;
-  guint32 word0;
-  guint32 word1;
-  guint16 luma0, chroma0, luma1, chroma1, luma2, chroma2;
+  gint64 start = g_get_monotonic_time ();
 
   GST_LOG_OBJECT (filt, "Performing non-inplace transform");
 
-#if 0
-  timer = g_timer_new ();
-#endif
+  gst_misb_pack_rows (filt->stripe_pool, filt->pack, filt->offset_value,
+      (guint8 *) GST_VIDEO_FRAME_COMP_DATA (out_frame, 0),
+      GST_VIDEO_FRAME_COMP_STRIDE (out_frame, 0),
+      (const guint16 *) GST_VIDEO_FRAME_COMP_DATA (in_frame, 0),
+      GST_VIDEO_FRAME_COMP_STRIDE (in_frame, 0),
+      GST_VIDEO_FRAME_COMP_WIDTH (in_frame, 0),
+      GST_VIDEO_FRAME_COMP_HEIGHT (in_frame, 0));
 
-  for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (in_frame, 0); y++) {
-    src = (guint16 *) (GST_VIDEO_FRAME_COMP_DATA (in_frame, 0) +
-        y * GST_VIDEO_FRAME_COMP_STRIDE (in_frame, 0));
-    src_end = src + GST_VIDEO_FRAME_COMP_WIDTH (in_frame, 0);
-    dst = (guint32 *) (GST_VIDEO_FRAME_COMP_DATA (out_frame, 0) +
-        y * GST_VIDEO_FRAME_COMP_STRIDE (out_frame, 0));
-
-    while (src + 2 < src_end) {
-      chroma0 = (*src & 0xff) + offset;
-      luma0 = ((*src & 0xff00) >> 8) + offset;
-      src++;
-      chroma1 = (*src & 0xff) + offset;
-      luma1 = ((*src & 0xff00) >> 8) + offset;
-      src++;
-      chroma2 = (*src & 0xff) + offset;
-      luma2 = ((*src & 0xff00) >> 8) + offset;
-      src++;
-
-      word0 = chroma0 | luma0 << 10 | chroma1 << 20;
-      word1 = luma1 | chroma2 << 10 | luma2 << 20;
-
-      *dst++ = word0;
-      *dst++ = word1;
-    }
-
-    /* handle the last one or two pixels if they exist */
-    if (src_end - src) {
-      chroma0 = (*src & 0xff) + offset;
-      luma0 = ((*src & 0xff00) >> 8) + offset;
-      src++;
-      if (src_end - src) {
-        chroma1 = (*src & 0xff) + offset;
-        luma1 = ((*src & 0xff00) >> 8) + offset;
-      } else {
-        chroma1 = luma1 = 0;
-      }
-      chroma2 = luma2 = 0;
-
-      word0 = chroma0 | luma0 << 10 | chroma1 << 20;
-      word1 = luma1 | chroma2 << 10 | luma2 << 20;
-
-      *dst++ = word0;
-      *dst++ = word1;
-    }
-  }
-
-  //for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (in_frame, 0); y++) {
-  //    src = (guint16 *) (GST_VIDEO_FRAME_COMP_DATA (in_frame, 0) + 
-  //        y * GST_VIDEO_FRAME_COMP_STRIDE (in_frame, 0));
-  //    dst = (guint32 *) (GST_VIDEO_FRAME_COMP_DATA (out_frame, 0) + 
-  //        y * GST_VIDEO_FRAME_COMP_STRIDE (out_frame, 0));
-  //    for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (in_frame, 0); ) {
-  //        guint32 word0;
-  //        guint32 word1;
-  //        guint16 luma0, chroma0, luma1, chroma1, luma2, chroma2;
-
-  //        chroma0 = *src & 0xff + offset;
-  //        luma0 = (*src & 0xff00) >> 8 + offset;
-  //        src++;
-  //        chroma1 = *src & 0xff + offset;
-  //        luma1 = (*src & 0xff00) >> 8 + offset;
-  //        src++;
-  //        chroma2 = *src & 0xff + offset;
-  //        luma2 = (*src & 0xff00) >> 8 + offset;
-  //        src++;
-
-  //        word0 = 0;
-  //        word0 = chroma0 | luma0 << 10 | chroma1 << 20;
-  //        word1 = 0;
-  //        word1 = luma1 | chroma2 << 10 | luma2 << 20;
-
-  //        dst[x++] = word0;
-  //        dst[x++] = word1;
-  //    }
-  //}
-
-#if 0
-  GST_LOG_OBJECT (filt, "Processing took %.3f ms", g_timer_elapsed (timer,
-          NULL) * 1000);
-  g_timer_destroy (timer);
-#endif
+  GST_LOG_OBJECT (filt, "Processing took %.3f ms",
+      (g_get_monotonic_time () - start) / 1000.0);
 
   return GST_FLOW_OK;
 }
@@ -394,4 +341,7 @@ gst_misb_ir_pack_reset (GstMisbIrPack * misb_ir_pack)
 {
   gst_video_info_init (&misb_ir_pack->info_in);
   gst_video_info_init (&misb_ir_pack->info_out);
+
+  gst_stripe_pool_free (misb_ir_pack->stripe_pool);
+  misb_ir_pack->stripe_pool = NULL;
 }
@@ -28,6 +28,8 @@
 #include <gst/video/gstvideofilter.h>
 #include <gst/video/video.h>
 
+#include "gstmisbrows.h"
+
 G_BEGIN_DECLS
 
 #define GST_TYPE_MISB_IR_PACK \
@@ -61,6 +63,14 @@ struct _GstMisbIrPack
 
   /* properties */
   guint offset_value;
+  guint n_threads;
+
+  /* row kernel for the output format */
+  GstSimdLevel simd_level;
+  GstMisbIrPackFunc pack;
+
+  /* workers converting horizontal bands of rows */
+  GstStripePool *stripe_pool;
 };
 
 struct _GstMisbIrPackClass
@@ -59,6 +59,7 @@ enum
   PROP_SWAP,
   PROP_LUMA_MASK,
   PROP_CHROMA_MASK,
+  PROP_N_THREADS,
   PROP_LAST
 };
 
@@ -67,6 +68,7 @@ enum
 #define DEFAULT_PROP_SWAP FALSE
 #define DEFAULT_PROP_LUMA_MASK 0xff
 #define DEFAULT_PROP_CHROMA_MASK 0xff
+#define DEFAULT_PROP_N_THREADS 1
 
 /* the capabilities of the inputs and outputs */
 static GstStaticPadTemplate gst_misb_ir_unpack_sink_template =
@@ -104,6 +106,7 @@ static GstFlowReturn gst_misb_ir_unpack_transform_frame (GstVideoFilter *
 
 /* GstMisbIrUnpack method declarations */
 static void gst_misb_ir_unpack_reset (GstMisbIrUnpack * filter);
+static void gst_misb_ir_unpack_update_kernel (GstMisbIrUnpack * filt);
 
 /* setup debug */
 GST_DEBUG_CATEGORY_STATIC (misb_ir_unpack_debug);
@@ -147,6 +150,9 @@ gst_misb_ir_unpack_class_init (GstMisbIrUnpackClass * klass)
       GST_BASE_TRANSFORM_CLASS (klass);
   GstVideoFilterClass *gstvideofilter_class = GST_VIDEO_FILTER_CLASS (klass);
 
+  GST_DEBUG_CATEGORY_INIT (misb_ir_unpack_debug, "misbirunpack", 0,
+      "MISB IR unpack filter");
+
   GST_DEBUG ("class init");
 
   /* Register GObject vmethods */
@@ -181,6 +187,8 @@ gst_misb_ir_unpack_class_init (GstMisbIrUnpackClass * klass)
           "Chroma mask",
           "Mask to bitwise AND with chroma after applying offset", 0, 0xffff,
           DEFAULT_PROP_LUMA_MASK, G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE));
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_N_THREADS,
+      GST_STRIPE_POOL_PARAM_SPEC_N_THREADS (DEFAULT_PROP_N_THREADS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_misb_ir_unpack_sink_template));
@@ -212,10 +220,16 @@ gst_misb_ir_unpack_init (GstMisbIrUnpack * filt)
   filt->swap = DEFAULT_PROP_SWAP;
   filt->luma_mask = DEFAULT_PROP_LUMA_MASK;
   filt->chroma_mask = DEFAULT_PROP_CHROMA_MASK;
+  filt->n_threads = DEFAULT_PROP_N_THREADS;
 
+  filt->simd_level = gst_simd_get_level ();
   gst_base_transform_set_in_place (GST_BASE_TRANSFORM (filt), FALSE);
 
+  GST_DEBUG_OBJECT (filt, "Using %s kernels",
+      gst_simd_get_name (filt->simd_level));
+
   gst_misb_ir_unpack_reset (filt);
+  gst_misb_ir_unpack_update_kernel (filt);
 }
 
 static void
@@ -242,10 +256,15 @@ gst_misb_ir_unpack_set_property (GObject * object, guint prop_id,
     case PROP_CHROMA_MASK:
       filt->chroma_mask = g_value_get_uint (value);
       break;
+    case PROP_N_THREADS:
+      filt->n_threads = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
+
+  gst_misb_ir_unpack_update_kernel (filt);
 }
 
 static void
@@ -272,6 +291,9 @@ gst_misb_ir_unpack_get_property (GObject * object, guint prop_id,
     case PROP_CHROMA_MASK:
       g_value_set_uint (value, filt->chroma_mask);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, filt->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -337,6 +359,12 @@ gst_misb_ir_unpack_set_info (GstVideoFilter * filter, GstCaps * incaps,
   memcpy (&filt->info_in, in_info, sizeof (GstVideoInfo));
   memcpy (&filt->info_out, out_info, sizeof (GstVideoInfo));
 
+  gst_misb_ir_unpack_update_kernel (filt);
+
+  if (gst_stripe_pool_ensure (&filt->stripe_pool, filt->n_threads))
+    GST_DEBUG_OBJECT (filt, "Processing with %d threads",
+        filt->stripe_pool->n_threads);
+
   return res;
 }
 
@@ -345,98 +373,63 @@ gst_misb_ir_unpack_transform_frame (GstVideoFilter * filter,
     GstVideoFrame * in_frame, GstVideoFrame * out_frame)
 {
   GstMisbIrUnpack *filt = GST_MISB_IR_UNPACK (filter);
-  GTimer *timer = NULL;
-  gint16 offset = filt->offset_value;
-  guint shift = filt->shift_value;
-  gint x, y;
-  guint16 *dst;
+  GstMisbIrUnpackParams params;
+  GstMisbIrUnpackFunc unpack;
+  gint64 start = g_get_monotonic_time ();
 
   GST_LOG_OBJECT (filt, "Performing non-inplace transform");
 
-#if 0
-  timer = g_timer_new ();
-#endif
+  GST_OBJECT_LOCK (filt);
+  params = filt->params;
+  unpack = filt->unpack;
+  GST_OBJECT_UNLOCK (filt);
 
-  if (filt->info_in.finfo->format == GST_VIDEO_FORMAT_v210) {
-    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (in_frame, 0); y++) {
-      guint32 *src = (guint32 *) (GST_VIDEO_FRAME_COMP_DATA (in_frame, 0) +
-          y * GST_VIDEO_FRAME_COMP_STRIDE (in_frame, 0));
-      dst = (guint16 *) (GST_VIDEO_FRAME_COMP_DATA (out_frame, 0) +
-          y * GST_VIDEO_FRAME_COMP_STRIDE (out_frame, 0));
-      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (in_frame, 0);) {
-        guint32 word0 = *src++;
-        guint32 word1 = *src++;
-        guint16 luma, chroma, temp;
-
-        chroma = word0 & 0x3ff;
-        luma = (word0 & 0xffc00) >> 10;
-        if (filt->swap) {
-          temp = chroma;
-          chroma = luma;
-          luma = temp;
-        }
-        dst[x++] =
-            ((chroma + offset) & filt->chroma_mask) | (((luma +
-                    offset) & filt->luma_mask) << shift);
-
-        chroma = (word0 & 0x3ff00000) >> 20;
-        luma = word1 & 0x3ff;
-        if (filt->swap) {
-          temp = chroma;
-          chroma = luma;
-          luma = temp;
-        }
-        dst[x++] =
-            (chroma + offset) & filt->chroma_mask | ((luma +
-                offset) & filt->luma_mask) << shift;
-
-        chroma = (word1 & 0xffc00) >> 10;
-        luma = (word1 & 0x3ff00000) >> 20;
-        if (filt->swap) {
-          temp = chroma;
-          chroma = luma;
-          luma = temp;
-        }
-        dst[x++] =
-            (chroma + offset) & filt->chroma_mask | ((luma +
-                offset) & filt->luma_mask) << shift;
-      }
-    }
-  } else if (filt->info_in.finfo->format == GST_VIDEO_FORMAT_UYVY) {
-    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (in_frame, 0); y++) {
-      guint8 *src = (guint8 *) (GST_VIDEO_FRAME_COMP_DATA (in_frame, 0) +
-          y * GST_VIDEO_FRAME_COMP_STRIDE (in_frame, 0));
-      dst = (guint16 *) (GST_VIDEO_FRAME_COMP_DATA (out_frame, 0) +
-          y * GST_VIDEO_FRAME_COMP_STRIDE (out_frame, 0));
-      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (in_frame, 0);) {
-        guint8 chroma = *src++;
-        guint8 luma = *src++;
-        guint8 temp;
-
-        if (filt->swap) {
-          temp = chroma;
-          chroma = luma;
-          luma = temp;
-        }
-        dst[x++] =
-            ((chroma + offset) & filt->chroma_mask) | (((luma +
-                    offset) & filt->luma_mask) << shift);
-      }
-    }
-  }
-#if 0
-  GST_LOG_OBJECT (filt, "Processing took %.3f ms", g_timer_elapsed (timer,
-          NULL) * 1000);
-  g_timer_destroy (timer);
-#endif
+  gst_misb_unpack_rows (filt->stripe_pool, unpack, &params,
+      (guint16 *) GST_VIDEO_FRAME_COMP_DATA (out_frame, 0),
+      GST_VIDEO_FRAME_COMP_STRIDE (out_frame, 0),
+      (const guint8 *) GST_VIDEO_FRAME_COMP_DATA (in_frame, 0),
+      GST_VIDEO_FRAME_COMP_STRIDE (in_frame, 0),
+      GST_VIDEO_FRAME_COMP_WIDTH (out_frame, 0),
+      GST_VIDEO_FRAME_COMP_HEIGHT (out_frame, 0));
+
+  GST_LOG_OBJECT (filt, "Processing took %.3f ms",
+      (g_get_monotonic_time () - start) / 1000.0);
 
   return GST_FLOW_OK;
 }
 
+/* pick the row kernel once per format and property change, so nothing is
+ * tested per pixel */
+static void
+gst_misb_ir_unpack_update_kernel (GstMisbIrUnpack * filt)
+{
+  GstMisbIrUnpackParams params;
+  GstMisbIrUnpackFunc unpack;
+
+  params.offset = filt->offset_value;
+  params.shift = filt->shift_value;
+  params.luma_mask = filt->luma_mask;
+  params.chroma_mask = filt->chroma_mask;
+
+  if (GST_VIDEO_INFO_FORMAT (&filt->info_in) == GST_VIDEO_FORMAT_UYVY)
+    unpack = gst_misb_simd_get_uyvy_unpack_func (filt->simd_level,
+        filt->swap);
+  else
+    unpack = gst_misb_simd_get_v210_unpack_func (filt->simd_level,
+        filt->swap);
+
+  GST_OBJECT_LOCK (filt);
+  filt->params = params;
+  filt->unpack = unpack;
+  GST_OBJECT_UNLOCK (filt);
+}
 
 static void
 gst_misb_ir_unpack_reset (GstMisbIrUnpack * misb_ir_unpack)
 {
   gst_video_info_init (&misb_ir_unpack->info_in);
   gst_video_info_init (&misb_ir_unpack->info_out);
+
+  gst_stripe_pool_free (misb_ir_unpack->stripe_pool);
+  misb_ir_unpack->stripe_pool = NULL;
 }
@@ -28,6 +28,8 @@
 #include <gst/video/gstvideofilter.h>
 #include <gst/video/video.h>
 
+#include "gstmisbrows.h"
+
 G_BEGIN_DECLS
 
 #define GST_TYPE_MISB_IR_UNPACK \
@@ -65,6 +67,15 @@ struct _GstMisbIrUnpack
   gboolean swap;
   guint luma_mask;
   guint chroma_mask;
+  guint n_threads;
+
+  /* row kernel specialized for the format and properties */
+  GstSimdLevel simd_level;
+  GstMisbIrUnpackParams params;
+  GstMisbIrUnpackFunc unpack;
+
+  /* workers converting horizontal bands of rows */
+  GstStripePool *stripe_pool;
 };
 
 struct _GstMisbIrUnpackClass
@@ -0,0 +1,151 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Row-band execution shared by the MISB IR elements.
+ *
+ * Each stripe of the pool converts a contiguous band of rows, computing its
+ * first row pointers once and then stepping them by the strides. The row
+ * kernels only depend on the row itself, so bands need no overlap.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstmisbrows.h"
+
+typedef struct
+{
+  GstMisbIrUnpackFunc unpack;
+  GstMisbIrUnpackParams params;
+  GstMisbIrPackFunc pack;
+  guint offset;
+
+  guint8 *dst;
+  gint dst_stride;
+  const guint8 *src;
+  gint src_stride;
+  gint width;
+  gint height;
+} RowJob;
+
+static void
+unpack_stripe (gpointer user_data, guint stripe, guint n_stripes)
+{
+  const RowJob *job = (const RowJob *) user_data;
+  const guint8 *src;
+  guint8 *dst;
+  gint row_start, row_end, y;
+
+  gst_stripe_get_rows (stripe, n_stripes, job->height, &row_start, &row_end);
+
+  src = job->src + (gsize) row_start * job->src_stride;
+  dst = job->dst + (gsize) row_start * job->dst_stride;
+  for (y = row_start; y < row_end; y++) {
+    job->unpack ((guint16 *) dst, src, job->width, &job->params);
+    src += job->src_stride;
+    dst += job->dst_stride;
+  }
+}
+
+static void
+pack_stripe (gpointer user_data, guint stripe, guint n_stripes)
+{
+  const RowJob *job = (const RowJob *) user_data;
+  const guint8 *src;
+  guint8 *dst;
+  gint row_start, row_end, y;
+
+  gst_stripe_get_rows (stripe, n_stripes, job->height, &row_start, &row_end);
+
+  src = job->src + (gsize) row_start * job->src_stride;
+  dst = job->dst + (gsize) row_start * job->dst_stride;
+  for (y = row_start; y < row_end; y++) {
+    job->pack (dst, (const guint16 *) src, job->width, job->offset);
+    src += job->src_stride;
+    dst += job->dst_stride;
+  }
+}
+
+/**
+ * gst_misb_unpack_rows:
+ * @pool: threads sharing the rows
+ * @unpack: row kernel
+ * @params: how components are combined
+ * @dst: first row of 16-bit output
+ * @dst_stride: bytes between output rows
+ * @src: first row of v210 or UYVY input
+ * @src_stride: bytes between input rows
+ * @width: number of pixels in each row
+ * @height: number of rows
+ *
+ * Unpack a frame in horizontal bands, one per thread of @pool.
+ */
+void
+gst_misb_unpack_rows (GstStripePool * pool, GstMisbIrUnpackFunc unpack,
+    const GstMisbIrUnpackParams * params, guint16 * dst, gint dst_stride,
+    const guint8 * src, gint src_stride, gint width, gint height)
+{
+  RowJob job = { 0, };
+
+  job.unpack = unpack;
+  job.params = *params;
+  job.dst = (guint8 *) dst;
+  job.dst_stride = dst_stride;
+  job.src = src;
+  job.src_stride = src_stride;
+  job.width = width;
+  job.height = height;
+
+  gst_stripe_pool_run (pool, unpack_stripe, &job);
+}
+
+/**
+ * gst_misb_pack_rows:
+ * @pool: threads sharing the rows
+ * @pack: row kernel
+ * @offset: value added to both components
+ * @dst: first row of v210 or UYVY output
+ * @dst_stride: bytes between output rows
+ * @src: first row of 16-bit input
+ * @src_stride: bytes between input rows
+ * @width: number of pixels in each row
+ * @height: number of rows
+ *
+ * Pack a frame in horizontal bands, one per thread of @pool.
+ */
+void
+gst_misb_pack_rows (GstStripePool * pool, GstMisbIrPackFunc pack,
+    guint offset, guint8 * dst, gint dst_stride, const guint16 * src,
+    gint src_stride, gint width, gint height)
+{
+  RowJob job = { 0, };
+
+  job.pack = pack;
+  job.offset = offset;
+  job.dst = dst;
+  job.dst_stride = dst_stride;
+  job.src = (const guint8 *) src;
+  job.src_stride = src_stride;
+  job.width = width;
+  job.height = height;
+
+  gst_stripe_pool_run (pool, pack_stripe, &job);
+}
@@ -0,0 +1,39 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_MISB_ROWS_H__
+#define __GST_MISB_ROWS_H__
+
+#include <glib.h>
+
+#include "gstmisbsimd.h"
+#include "stripepool.h"
+
+G_BEGIN_DECLS
+
+void gst_misb_unpack_rows (GstStripePool * pool, GstMisbIrUnpackFunc unpack,
+    const GstMisbIrUnpackParams * params, guint16 * dst, gint dst_stride,
+    const guint8 * src, gint src_stride, gint width, gint height);
+void gst_misb_pack_rows (GstStripePool * pool, GstMisbIrPackFunc pack,
+    guint offset, guint8 * dst, gint dst_stride, const guint16 * src,
+    gint src_stride, gint width, gint height);
+
+G_END_DECLS
+
+#endif /* __GST_MISB_ROWS_H__ */
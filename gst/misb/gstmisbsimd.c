@@ -0,0 +1,654 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Vectorized kernels for the MISB IR elements.
+ *
+ * A 16-byte v210 group holds twelve 10-bit components, six pixels of chroma
+ * and luma. Byte shuffles gather the two bytes holding each component into
+ * a 16-bit lane, one vector for chroma and one for luma, and a multiply
+ * lines up the three possible bit offsets so one shift and mask extract
+ * them all. UYVY components are split with a mask and a shift.
+ *
+ * Packing runs the other way. A little-endian pixel is its chroma byte then
+ * its luma byte, which is already v210 component order, so six pixels are
+ * twelve consecutive bytes. The first two components of each word are
+ * shuffled into the halves of a 32-bit lane and joined with a multiply-add,
+ * and the third is shuffled into its own lane and shifted into place. UYVY
+ * packing is a byte-wise add of the offset.
+ *
+ * Offsets, masks and shifts all wrap or truncate to 16 bits in the scalar
+ * code, so computing them in 16-bit lanes is bit-exact. Swapping luma and
+ * chroma only changes which shuffle feeds which vector, and is specialized
+ * when the kernel is chosen rather than tested per pixel.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstmisbsimd.h"
+
+static inline guint16
+unpack_pixel (gint chroma, gint luma, const GstMisbIrUnpackParams * params)
+{
+  return ((chroma + params->offset) & params->chroma_mask) |
+      (((luma + params->offset) & params->luma_mask) << params->shift);
+}
+
+/* 10-bit component k of a v210 row */
+static inline gint
+v210_component (const guint32 * words, gint k)
+{
+  return (GUINT32_FROM_LE (words[k / 3]) >> (10 * (k % 3))) & 0x3ff;
+}
+
+static inline void
+v210_unpack_scalar_impl (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params, const gboolean swap)
+{
+  const guint32 *words = (const guint32 *) src;
+  gint x = 0;
+
+  /* three pixels from every two words */
+  for (; x + 3 <= width; x += 3, words += 2) {
+    const guint32 word0 = GUINT32_FROM_LE (words[0]);
+    const guint32 word1 = GUINT32_FROM_LE (words[1]);
+    const gint c0 = word0 & 0x3ff, l0 = (word0 >> 10) & 0x3ff;
+    const gint c1 = (word0 >> 20) & 0x3ff, l1 = word1 & 0x3ff;
+    const gint c2 = (word1 >> 10) & 0x3ff, l2 = (word1 >> 20) & 0x3ff;
+
+    dst[x] = swap ? unpack_pixel (l0, c0, params) :
+        unpack_pixel (c0, l0, params);
+    dst[x + 1] = swap ? unpack_pixel (l1, c1, params) :
+        unpack_pixel (c1, l1, params);
+    dst[x + 2] = swap ? unpack_pixel (l2, c2, params) :
+        unpack_pixel (c2, l2, params);
+  }
+
+  for (; x < width; x++) {
+    /* components are counted from the last whole group */
+    const gint k = 2 * (x % 3);
+    const gint chroma = v210_component (words, k);
+    const gint luma = v210_component (words, k + 1);
+
+    dst[x] = swap ? unpack_pixel (luma, chroma, params) :
+        unpack_pixel (chroma, luma, params);
+  }
+}
+
+static void
+v210_unpack_scalar (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  v210_unpack_scalar_impl (dst, src, width, params, FALSE);
+}
+
+static void
+v210_unpack_swap_scalar (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  v210_unpack_scalar_impl (dst, src, width, params, TRUE);
+}
+
+static inline void
+uyvy_unpack_scalar_impl (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params, const gboolean swap)
+{
+  gint x;
+
+  for (x = 0; x < width; x++) {
+    const gint chroma = src[2 * x];
+    const gint luma = src[2 * x + 1];
+
+    dst[x] = swap ? unpack_pixel (luma, chroma, params) :
+        unpack_pixel (chroma, luma, params);
+  }
+}
+
+static void
+uyvy_unpack_scalar (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  uyvy_unpack_scalar_impl (dst, src, width, params, FALSE);
+}
+
+static void
+uyvy_unpack_swap_scalar (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  uyvy_unpack_scalar_impl (dst, src, width, params, TRUE);
+}
+
+/* v210 components are 10 bits, wider values are truncated rather than
+ * spilling into their neighbours */
+static inline guint32
+pack_component (guint8 value, guint offset)
+{
+  return (value + offset) & 0x3ff;
+}
+
+static inline guint32
+v210_word (guint32 first, guint32 second, guint32 third)
+{
+  return first | second << 10 | third << 20;
+}
+
+static void
+v210_pack_scalar (guint8 * dst, const guint16 * src, gint width,
+    guint offset)
+{
+  const guint8 *bytes = (const guint8 *) src;
+  guint32 *words = (guint32 *) dst;
+  gint x;
+
+  /* three pixels into every two words */
+  for (x = 0; x + 3 <= width; x += 3, bytes += 6, words += 2) {
+    words[0] = GUINT32_TO_LE (v210_word (pack_component (bytes[0], offset),
+            pack_component (bytes[1], offset), pack_component (bytes[2],
+                offset)));
+    words[1] = GUINT32_TO_LE (v210_word (pack_component (bytes[3], offset),
+            pack_component (bytes[4], offset), pack_component (bytes[5],
+                offset)));
+  }
+
+  /* components missing from the last group are left zero */
+  if (x < width) {
+    const gboolean second = x + 1 < width;
+    const guint32 c1 = second ? pack_component (bytes[2], offset) : 0;
+    const guint32 l1 = second ? pack_component (bytes[3], offset) : 0;
+
+    words[0] = GUINT32_TO_LE (v210_word (pack_component (bytes[0], offset),
+            pack_component (bytes[1], offset), c1));
+    words[1] = GUINT32_TO_LE (v210_word (l1, 0, 0));
+  }
+}
+
+static void
+uyvy_pack_scalar (guint8 * dst, const guint16 * src, gint width,
+    guint offset)
+{
+  const guint8 *bytes = (const guint8 *) src;
+  gint x;
+
+  for (x = 0; x < 2 * width; x++)
+    dst[x] = (guint8) (bytes[x] + offset);
+}
+
+#ifdef HAVE_X86_SIMD
+
+/* bytes holding the even (chroma) and odd (luma) components of a v210
+ * group, and the multiplier putting each at bit 4 of its lane */
+#define V210_EVEN_SHUFFLE 0, 1, 2, 3, 5, 6, 8, 9, 10, 11, 13, 14, \
+    -1, -1, -1, -1
+#define V210_ODD_SHUFFLE 1, 2, 4, 5, 6, 7, 9, 10, 12, 13, 14, 15, \
+    -1, -1, -1, -1
+#define V210_EVEN_MULTIPLY 16, 1, 4, 16, 1, 4, 0, 0
+#define V210_ODD_MULTIPLY 4, 16, 1, 4, 16, 1, 0, 0
+
+typedef struct
+{
+  __m128i chroma_shuffle;
+  __m128i luma_shuffle;
+  __m128i chroma_multiply;
+  __m128i luma_multiply;
+  __m128i offset;
+  __m128i chroma_mask;
+  __m128i luma_mask;
+  __m128i shift;
+} UnpackConsts;
+
+TARGET_SSSE3 static inline void
+unpack_consts_init (UnpackConsts * k, const GstMisbIrUnpackParams * params,
+    const gboolean swap)
+{
+  const __m128i even_shuffle = _mm_setr_epi8 (V210_EVEN_SHUFFLE);
+  const __m128i odd_shuffle = _mm_setr_epi8 (V210_ODD_SHUFFLE);
+  const __m128i even_multiply = _mm_setr_epi16 (V210_EVEN_MULTIPLY);
+  const __m128i odd_multiply = _mm_setr_epi16 (V210_ODD_MULTIPLY);
+
+  k->chroma_shuffle = swap ? odd_shuffle : even_shuffle;
+  k->luma_shuffle = swap ? even_shuffle : odd_shuffle;
+  k->chroma_multiply = swap ? odd_multiply : even_multiply;
+  k->luma_multiply = swap ? even_multiply : odd_multiply;
+  k->offset = _mm_set1_epi16 ((gint16) params->offset);
+  k->chroma_mask = _mm_set1_epi16 ((gint16) params->chroma_mask);
+  k->luma_mask = _mm_set1_epi16 ((gint16) params->luma_mask);
+  k->shift = _mm_cvtsi32_si128 (params->shift);
+}
+
+TARGET_SSSE3 static inline __m128i
+combine_ssse3 (__m128i chroma, __m128i luma, const UnpackConsts * k)
+{
+  chroma = _mm_and_si128 (_mm_add_epi16 (chroma, k->offset), k->chroma_mask);
+  luma = _mm_and_si128 (_mm_add_epi16 (luma, k->offset), k->luma_mask);
+  return _mm_or_si128 (chroma, _mm_sll_epi16 (luma, k->shift));
+}
+
+/* six pixels of one group in the low lanes */
+TARGET_SSSE3 static inline __m128i
+v210_group_ssse3 (__m128i v, const UnpackConsts * k)
+{
+  const __m128i mask10 = _mm_set1_epi16 (0x3ff);
+  __m128i chroma = _mm_shuffle_epi8 (v, k->chroma_shuffle);
+  __m128i luma = _mm_shuffle_epi8 (v, k->luma_shuffle);
+
+  chroma = _mm_and_si128 (_mm_srli_epi16 (_mm_mullo_epi16 (chroma,
+              k->chroma_multiply), 4), mask10);
+  luma = _mm_and_si128 (_mm_srli_epi16 (_mm_mullo_epi16 (luma,
+              k->luma_multiply), 4), mask10);
+  return combine_ssse3 (chroma, luma, k);
+}
+
+TARGET_SSSE3 static inline void
+v210_unpack_ssse3_impl (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params, const gboolean swap)
+{
+  UnpackConsts k;
+  gint x;
+
+  unpack_consts_init (&k, params, swap);
+
+  /* each store writes two spare lanes, overwritten by the next group */
+  for (x = 0; x + 8 <= width; x += 6, src += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) src);
+    _mm_storeu_si128 ((__m128i *) (dst + x), v210_group_ssse3 (v, &k));
+  }
+
+  v210_unpack_scalar_impl (dst + x, src, width - x, params, swap);
+}
+
+TARGET_SSSE3 static void
+v210_unpack_ssse3 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  v210_unpack_ssse3_impl (dst, src, width, params, FALSE);
+}
+
+TARGET_SSSE3 static void
+v210_unpack_swap_ssse3 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  v210_unpack_ssse3_impl (dst, src, width, params, TRUE);
+}
+
+TARGET_SSSE3 static inline void
+uyvy_unpack_ssse3_impl (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params, const gboolean swap)
+{
+  const __m128i low = _mm_set1_epi16 (0xff);
+  UnpackConsts k;
+  gint x;
+
+  unpack_consts_init (&k, params, swap);
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + 2 * x));
+    __m128i first = _mm_and_si128 (v, low);
+    __m128i second = _mm_srli_epi16 (v, 8);
+    _mm_storeu_si128 ((__m128i *) (dst + x), swap ?
+        combine_ssse3 (second, first, &k) : combine_ssse3 (first, second, &k));
+  }
+
+  uyvy_unpack_scalar_impl (dst + x, src + 2 * x, width - x, params, swap);
+}
+
+TARGET_SSSE3 static void
+uyvy_unpack_ssse3 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  uyvy_unpack_ssse3_impl (dst, src, width, params, FALSE);
+}
+
+TARGET_SSSE3 static void
+uyvy_unpack_swap_ssse3 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  uyvy_unpack_ssse3_impl (dst, src, width, params, TRUE);
+}
+
+/* source bytes of the first two components of each v210 word, one per
+ * 16-bit half of a lane, and of the third in the low half of a lane */
+#define V210_PACK_PAIR_SHUFFLE 0, -1, 1, -1, 3, -1, 4, -1, \
+    6, -1, 7, -1, 9, -1, 10, -1
+#define V210_PACK_THIRD_SHUFFLE 2, -1, -1, -1, 5, -1, -1, -1, \
+    8, -1, -1, -1, 11, -1, -1, -1
+
+/* four v210 words from the first twelve bytes of v */
+TARGET_SSSE3 static inline __m128i
+v210_pack_group_ssse3 (__m128i v, __m128i offset16, __m128i offset32)
+{
+  const __m128i pair_shuffle = _mm_setr_epi8 (V210_PACK_PAIR_SHUFFLE);
+  const __m128i third_shuffle = _mm_setr_epi8 (V210_PACK_THIRD_SHUFFLE);
+  const __m128i pair_multiply = _mm_set1_epi32 (1 | 1024 << 16);
+  const __m128i mask10 = _mm_set1_epi16 (0x3ff);
+  const __m128i mask10_32 = _mm_set1_epi32 (0x3ff);
+  __m128i pair = _mm_shuffle_epi8 (v, pair_shuffle);
+  __m128i third = _mm_shuffle_epi8 (v, third_shuffle);
+
+  pair = _mm_and_si128 (_mm_add_epi16 (pair, offset16), mask10);
+  third = _mm_and_si128 (_mm_add_epi32 (third, offset32), mask10_32);
+  return _mm_or_si128 (_mm_madd_epi16 (pair, pair_multiply),
+      _mm_slli_epi32 (third, 20));
+}
+
+TARGET_SSSE3 static void
+v210_pack_ssse3 (guint8 * dst, const guint16 * src, gint width, guint offset)
+{
+  const __m128i offset16 = _mm_set1_epi16 ((gint16) offset);
+  const __m128i offset32 = _mm_set1_epi32 ((gint) offset);
+  gint x;
+
+  /* each load reads two pixels past the group */
+  for (x = 0; x + 8 <= width; x += 6, dst += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + x));
+    _mm_storeu_si128 ((__m128i *) dst, v210_pack_group_ssse3 (v, offset16,
+            offset32));
+  }
+
+  v210_pack_scalar (dst, src + x, width - x, offset);
+}
+
+TARGET_SSSE3 static void
+uyvy_pack_ssse3 (guint8 * dst, const guint16 * src, gint width, guint offset)
+{
+  const __m128i offset8 = _mm_set1_epi8 ((gint8) offset);
+  gint x;
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + x));
+    _mm_storeu_si128 ((__m128i *) (dst + 2 * x), _mm_add_epi8 (v, offset8));
+  }
+
+  uyvy_pack_scalar (dst + 2 * x, src + x, width - x, offset);
+}
+
+typedef struct
+{
+  __m256i chroma_shuffle;
+  __m256i luma_shuffle;
+  __m256i chroma_multiply;
+  __m256i luma_multiply;
+  __m256i offset;
+  __m256i chroma_mask;
+  __m256i luma_mask;
+  __m128i shift;
+} UnpackConsts256;
+
+TARGET_AVX2 static inline void
+unpack_consts256_init (UnpackConsts256 * k256, const UnpackConsts * k)
+{
+  k256->chroma_shuffle = _mm256_broadcastsi128_si256 (k->chroma_shuffle);
+  k256->luma_shuffle = _mm256_broadcastsi128_si256 (k->luma_shuffle);
+  k256->chroma_multiply = _mm256_broadcastsi128_si256 (k->chroma_multiply);
+  k256->luma_multiply = _mm256_broadcastsi128_si256 (k->luma_multiply);
+  k256->offset = _mm256_broadcastsi128_si256 (k->offset);
+  k256->chroma_mask = _mm256_broadcastsi128_si256 (k->chroma_mask);
+  k256->luma_mask = _mm256_broadcastsi128_si256 (k->luma_mask);
+  k256->shift = k->shift;
+}
+
+TARGET_AVX2 static inline __m256i
+combine_avx2 (__m256i chroma, __m256i luma, const UnpackConsts256 * k)
+{
+  chroma = _mm256_and_si256 (_mm256_add_epi16 (chroma, k->offset),
+      k->chroma_mask);
+  luma = _mm256_and_si256 (_mm256_add_epi16 (luma, k->offset), k->luma_mask);
+  return _mm256_or_si256 (chroma, _mm256_sll_epi16 (luma, k->shift));
+}
+
+TARGET_AVX2 static inline void
+v210_unpack_avx2_impl (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params, const gboolean swap)
+{
+  const __m256i mask10 = _mm256_set1_epi16 (0x3ff);
+  UnpackConsts k;
+  UnpackConsts256 k256;
+  gint x;
+
+  unpack_consts_init (&k, params, swap);
+  unpack_consts256_init (&k256, &k);
+
+  /* two groups at once, one per 128-bit lane */
+  for (x = 0; x + 14 <= width; x += 12, src += 32) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) src);
+    __m256i chroma = _mm256_shuffle_epi8 (v, k256.chroma_shuffle);
+    __m256i luma = _mm256_shuffle_epi8 (v, k256.luma_shuffle);
+
+    chroma = _mm256_and_si256 (_mm256_srli_epi16 (_mm256_mullo_epi16 (chroma,
+                k256.chroma_multiply), 4), mask10);
+    luma = _mm256_and_si256 (_mm256_srli_epi16 (_mm256_mullo_epi16 (luma,
+                k256.luma_multiply), 4), mask10);
+    v = combine_avx2 (chroma, luma, &k256);
+
+    _mm_storeu_si128 ((__m128i *) (dst + x), _mm256_castsi256_si128 (v));
+    _mm_storeu_si128 ((__m128i *) (dst + x + 6),
+        _mm256_extracti128_si256 (v, 1));
+  }
+
+  for (; x + 8 <= width; x += 6, src += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) src);
+    _mm_storeu_si128 ((__m128i *) (dst + x), v210_group_ssse3 (v, &k));
+  }
+
+  v210_unpack_scalar_impl (dst + x, src, width - x, params, swap);
+}
+
+TARGET_AVX2 static void
+v210_unpack_avx2 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  v210_unpack_avx2_impl (dst, src, width, params, FALSE);
+}
+
+TARGET_AVX2 static void
+v210_unpack_swap_avx2 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  v210_unpack_avx2_impl (dst, src, width, params, TRUE);
+}
+
+TARGET_AVX2 static inline void
+uyvy_unpack_avx2_impl (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params, const gboolean swap)
+{
+  const __m256i low = _mm256_set1_epi16 (0xff);
+  UnpackConsts k;
+  UnpackConsts256 k256;
+  gint x;
+
+  unpack_consts_init (&k, params, swap);
+  unpack_consts256_init (&k256, &k);
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) (src + 2 * x));
+    __m256i first = _mm256_and_si256 (v, low);
+    __m256i second = _mm256_srli_epi16 (v, 8);
+    _mm256_storeu_si256 ((__m256i *) (dst + x), swap ?
+        combine_avx2 (second, first, &k256) :
+        combine_avx2 (first, second, &k256));
+  }
+
+  uyvy_unpack_scalar_impl (dst + x, src + 2 * x, width - x, params, swap);
+}
+
+TARGET_AVX2 static void
+uyvy_unpack_avx2 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  uyvy_unpack_avx2_impl (dst, src, width, params, FALSE);
+}
+
+TARGET_AVX2 static void
+uyvy_unpack_swap_avx2 (guint16 * dst, const guint8 * src, gint width,
+    const GstMisbIrUnpackParams * params)
+{
+  uyvy_unpack_avx2_impl (dst, src, width, params, TRUE);
+}
+
+TARGET_AVX2 static void
+v210_pack_avx2 (guint8 * dst, const guint16 * src, gint width, guint offset)
+{
+  const __m256i pair_shuffle =
+      _mm256_broadcastsi128_si256 (_mm_setr_epi8 (V210_PACK_PAIR_SHUFFLE));
+  const __m256i third_shuffle =
+      _mm256_broadcastsi128_si256 (_mm_setr_epi8 (V210_PACK_THIRD_SHUFFLE));
+  const __m256i pair_multiply = _mm256_set1_epi32 (1 | 1024 << 16);
+  const __m256i mask10 = _mm256_set1_epi16 (0x3ff);
+  const __m256i mask10_32 = _mm256_set1_epi32 (0x3ff);
+  const __m256i offset16 = _mm256_set1_epi16 ((gint16) offset);
+  const __m256i offset32 = _mm256_set1_epi32 ((gint) offset);
+  gint x;
+
+  /* two groups at once, one per 128-bit lane, the second load reading two
+   * pixels past the pair of groups */
+  for (x = 0; x + 14 <= width; x += 12, dst += 32) {
+    __m256i v = _mm256_inserti128_si256 (_mm256_castsi128_si256
+        (_mm_loadu_si128 ((const __m128i *) (src + x))),
+        _mm_loadu_si128 ((const __m128i *) (src + x + 6)), 1);
+    __m256i pair = _mm256_shuffle_epi8 (v, pair_shuffle);
+    __m256i third = _mm256_shuffle_epi8 (v, third_shuffle);
+
+    pair = _mm256_and_si256 (_mm256_add_epi16 (pair, offset16), mask10);
+    third = _mm256_and_si256 (_mm256_add_epi32 (third, offset32), mask10_32);
+    _mm256_storeu_si256 ((__m256i *) dst,
+        _mm256_or_si256 (_mm256_madd_epi16 (pair, pair_multiply),
+            _mm256_slli_epi32 (third, 20)));
+  }
+
+  for (; x + 8 <= width; x += 6, dst += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + x));
+    _mm_storeu_si128 ((__m128i *) dst,
+        v210_pack_group_ssse3 (v, _mm256_castsi256_si128 (offset16),
+            _mm256_castsi256_si128 (offset32)));
+  }
+
+  v210_pack_scalar (dst, src + x, width - x, offset);
+}
+
+TARGET_AVX2 static void
+uyvy_pack_avx2 (guint8 * dst, const guint16 * src, gint width, guint offset)
+{
+  const __m256i offset8 = _mm256_set1_epi8 ((gint8) offset);
+  gint x;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    __m256i v = _mm256_loadu_si256 ((const __m256i *) (src + x));
+    _mm256_storeu_si256 ((__m256i *) (dst + 2 * x),
+        _mm256_add_epi8 (v, offset8));
+  }
+
+  uyvy_pack_scalar (dst + 2 * x, src + x, width - x, offset);
+}
+
+#endif /* HAVE_X86_SIMD */
+
+/**
+ * gst_misb_simd_get_v210_unpack_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ * @swap: whether luma comes before chroma
+ *
+ * Returns: the v210 unpack kernel for @level, %GST_SIMD_NONE giving the
+ * scalar loop
+ */
+GstMisbIrUnpackFunc
+gst_misb_simd_get_v210_unpack_func (GstSimdLevel level, gboolean swap)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return swap ? v210_unpack_swap_avx2 : v210_unpack_avx2;
+    case GST_SIMD_SSE41:
+    case GST_SIMD_SSSE3:
+      return swap ? v210_unpack_swap_ssse3 : v210_unpack_ssse3;
+#endif
+    default:
+      return swap ? v210_unpack_swap_scalar : v210_unpack_scalar;
+  }
+}
+
+/**
+ * gst_misb_simd_get_uyvy_unpack_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ * @swap: whether luma comes before chroma
+ *
+ * Returns: the UYVY unpack kernel for @level, %GST_SIMD_NONE giving the
+ * scalar loop
+ */
+GstMisbIrUnpackFunc
+gst_misb_simd_get_uyvy_unpack_func (GstSimdLevel level, gboolean swap)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return swap ? uyvy_unpack_swap_avx2 : uyvy_unpack_avx2;
+    case GST_SIMD_SSE41:
+    case GST_SIMD_SSSE3:
+      return swap ? uyvy_unpack_swap_ssse3 : uyvy_unpack_ssse3;
+#endif
+    default:
+      return swap ? uyvy_unpack_swap_scalar : uyvy_unpack_scalar;
+  }
+}
+
+/**
+ * gst_misb_simd_get_v210_pack_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the v210 pack kernel for @level, %GST_SIMD_NONE giving the scalar
+ * loop
+ */
+GstMisbIrPackFunc
+gst_misb_simd_get_v210_pack_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return v210_pack_avx2;
+    case GST_SIMD_SSE41:
+    case GST_SIMD_SSSE3:
+      return v210_pack_ssse3;
+#endif
+    default:
+      return v210_pack_scalar;
+  }
+}
+
+/**
+ * gst_misb_simd_get_uyvy_pack_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the UYVY pack kernel for @level, %GST_SIMD_NONE giving the scalar
+ * loop
+ */
+GstMisbIrPackFunc
+gst_misb_simd_get_uyvy_pack_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return uyvy_pack_avx2;
+    case GST_SIMD_SSE41:
+    case GST_SIMD_SSSE3:
+      return uyvy_pack_ssse3;
+#endif
+    default:
+      return uyvy_pack_scalar;
+  }
+}
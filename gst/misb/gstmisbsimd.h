@@ -0,0 +1,81 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_MISB_SIMD_H__
+#define __GST_MISB_SIMD_H__
+
+#include <glib.h>
+
+#include "simdlevel.h"
+
+G_BEGIN_DECLS
+
+/**
+* GstMisbIrUnpackParams:
+* @offset: value added to both components
+* @luma_mask: mask applied to luma after the offset
+* @chroma_mask: mask applied to chroma after the offset
+* @shift: left shift of the masked luma
+*
+* How each pair of components becomes one 16-bit pixel, which is
+* ((chroma + offset) & chroma_mask) | (((luma + offset) & luma_mask) << shift)
+*/
+typedef struct {
+  gint offset;
+  guint luma_mask;
+  guint chroma_mask;
+  guint shift;
+} GstMisbIrUnpackParams;
+
+/**
+* GstMisbIrUnpackFunc:
+* @dst: output row of 16-bit pixels
+* @src: input row of v210 or UYVY
+* @width: number of pixels
+* @params: how components are combined
+*
+* Unpack one row of MISB IR video, each pixel taking a chroma and a luma
+* component.
+*/
+typedef void (*GstMisbIrUnpackFunc) (guint16 * dst, const guint8 * src,
+    gint width, const GstMisbIrUnpackParams * params);
+
+/**
+* GstMisbIrPackFunc:
+* @dst: output row of v210 or UYVY
+* @src: input row of little-endian 16-bit pixels
+* @width: number of pixels
+* @offset: value added to both components
+*
+* Pack one row of MISB IR video, the low byte of each pixel becoming the
+* chroma and the high byte the luma component.
+*/
+typedef void (*GstMisbIrPackFunc) (guint8 * dst, const guint16 * src,
+    gint width, guint offset);
+
+GstMisbIrUnpackFunc gst_misb_simd_get_v210_unpack_func (GstSimdLevel level,
+    gboolean swap);
+GstMisbIrUnpackFunc gst_misb_simd_get_uyvy_unpack_func (GstSimdLevel level,
+    gboolean swap);
+GstMisbIrPackFunc gst_misb_simd_get_v210_pack_func (GstSimdLevel level);
+GstMisbIrPackFunc gst_misb_simd_get_uyvy_pack_func (GstSimdLevel level);
+
+G_END_DECLS
+
+#endif /* __GST_MISB_SIMD_H__ */
@@ -3,6 +3,7 @@
 #endif
 
 #include "gstsensorfx3dnoise.h"
+#include "gstsensorfxblur.h"
 
 #define GST_CAT_DEFAULT gst_sensorfx_debug
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
@@ -21,11 +22,17 @@ plugin_init (GstPlugin * plugin)
     return FALSE;
   }
 
+  if (!gst_element_register (plugin, "sfxblur", GST_RANK_NONE,
+          GST_TYPE_SENSORFXBLUR)) {
+    return FALSE;
+  }
+
   return TRUE;
 }
 
 GST_PLUGIN_DEFINE (GST_VERSION_MAJOR,
     GST_VERSION_MINOR,
-    "sensorfx",
+    sensorfx,
     "Filters to simulate the effects of real sensors",
-    plugin_init, VERSION, GST_LICENSE, PACKAGE_NAME, GST_PACKAGE_ORIGIN);
+    plugin_init, GST_PACKAGE_VERSION, GST_PACKAGE_LICENSE, GST_PACKAGE_NAME,
+    GST_PACKAGE_ORIGIN);
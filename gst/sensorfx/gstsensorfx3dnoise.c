@@ -48,13 +48,10 @@
 #include <gst/gst.h>
 #include <gst/video/video.h>
 
-#include "gstopencvutils.h"
 #include "gstsensorfx3dnoise.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_sfx3dnoise_debug);
 #define GST_CAT_DEFAULT gst_sfx3dnoise_debug
-#define DEBUG_INIT(bla) \
-  GST_DEBUG_CATEGORY_INIT (gst_sfx3dnoise_debug, "sfx3dnoise", 0, "ARF 3D-noise sensor effects");
 
 /* Filter signals and args */
 enum
@@ -71,7 +68,11 @@ enum
   PROP_SIGMA_TV,
   PROP_SIGMA_TH,
   PROP_SIGMA_VH,
-  PROP_SIGMA_TVH
+  PROP_SIGMA_TVH,
+  PROP_SEED,
+  PROP_N_THREADS,
+  PROP_NOISE_BANK_SIZE,
+  PROP_NOISE_BANK_REFRESH
 };
 
 #define DEFAULT_SIGMA_T 0.0
@@ -81,31 +82,45 @@ enum
 #define DEFAULT_SIGMA_TH 0.0
 #define DEFAULT_SIGMA_VH 0.0
 #define DEFAULT_SIGMA_TVH 0.0
-
-GST_BOILERPLATE_FULL (GstSfx3DNoise, gst_sfx3dnoise, GstOpencvBaseTransform,
-    GST_TYPE_OPENCV_BASE_TRANSFORM, DEBUG_INIT);
+#define DEFAULT_SEED 0
+#define DEFAULT_N_THREADS 1
+#define DEFAULT_NOISE_BANK_SIZE 0
+#define DEFAULT_NOISE_BANK_REFRESH FALSE
+
+static GstStaticPadTemplate gst_sfx3dnoise_src_template =
+GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE ("GRAY16_LE"))
+    );
+
+static GstStaticPadTemplate gst_sfx3dnoise_sink_template =
+GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE ("GRAY16_LE"))
+    );
+
+G_DEFINE_TYPE (GstSfx3DNoise, gst_sfx3dnoise, GST_TYPE_VIDEO_FILTER);
 
 static void gst_sfx3dnoise_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
 static void gst_sfx3dnoise_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 
-static GstFlowReturn gst_sfx3dnoise_cv_transform (GstOpencvBaseTransform *
-    filter, GstBuffer * buf, IplImage * img, GstBuffer * outbuf,
-    IplImage * outimg);
-static gboolean gst_sfx3dnoise_cv_set_caps (GstOpencvBaseTransform * trans,
-    gint in_width, gint in_height, gint in_depth, gint in_channels,
-    gint out_width, gint out_height, gint out_depth, gint out_channels);
-
-void gst_sfx3dnoise_create_fixed_noise (GstSfx3DNoise * filter, CvMat * arr);
-void gst_sfx3dnoise_add_sigma_t (GstSfx3DNoise * filter, CvMat * arr,
-    double sigma);
-void gst_sfx3dnoise_add_sigma_tv (GstSfx3DNoise * filter, CvMat * arr,
-    double sigma);
-void gst_sfx3dnoise_add_sigma_th (GstSfx3DNoise * filter, CvMat * arr,
-    double sigma);
-void gst_sfx3dnoise_add_sigma_tvh (GstSfx3DNoise * filter, CvMat * arr,
-    double sigma);
+static GstFlowReturn gst_sfx3dnoise_transform_frame (GstVideoFilter *
+    filter, GstVideoFrame * in_frame, GstVideoFrame * out_frame);
+static GstFlowReturn gst_sfx3dnoise_transform_frame_ip (GstVideoFilter *
+    filter, GstVideoFrame * frame);
+static gboolean gst_sfx3dnoise_set_info (GstVideoFilter * filter,
+    GstCaps * incaps, GstVideoInfo * in_info, GstCaps * outcaps,
+    GstVideoInfo * out_info);
+
+void gst_sfx3dnoise_create_fixed_noise (GstSfx3DNoise * filter);
+static void gst_sfx3dnoise_create_bank (GstSfx3DNoise * filter);
+static void gst_sfx3dnoise_free_bank (GstSfx3DNoise * filter);
+static void gst_sfx3dnoise_apply_bank (GstSfx3DNoise * filter,
+    const guint8 * src, gint src_stride, guint8 * dst, gint dst_stride);
 
 /* Clean up */
 static void
@@ -113,61 +128,47 @@ gst_sfx3dnoise_finalize (GObject * obj)
 {
   GstSfx3DNoise *filter = GST_SFX3DNOISE (obj);
 
-  if (filter->fixed_noise)
-    cvReleaseMat (&filter->fixed_noise);
-  filter->fixed_noise = NULL;
+  gst_sfx3dnoise_free_bank (filter);
+  gst_sfx_noise_free (&filter->noise);
+  g_mutex_clear (&filter->bank_lock);
 
-  if (filter->intermediary)
-    cvReleaseMat (&filter->intermediary);
-  filter->intermediary = NULL;
+  gst_stripe_pool_free (filter->stripe_pool);
+  filter->stripe_pool = NULL;
 
-  G_OBJECT_CLASS (parent_class)->finalize (obj);
+  G_OBJECT_CLASS (gst_sfx3dnoise_parent_class)->finalize (obj);
 }
 
 /* GObject vmethod implementations */
 
-static void
-gst_sfx3dnoise_base_init (gpointer gclass)
-{
-  GstElementClass *element_class = GST_ELEMENT_CLASS (gclass);
-  GstCaps *caps;
-  GstPadTemplate *templ;
-
-  /* add sink and source pad templates */
-  caps = gst_caps_from_string (GST_VIDEO_CAPS_GRAY16 ("1234"));
-  templ = gst_pad_template_new ("sink", GST_PAD_SINK, GST_PAD_ALWAYS,
-      gst_caps_ref (caps));
-  gst_element_class_add_pad_template (element_class, templ);
-  templ = gst_pad_template_new ("src", GST_PAD_SRC, GST_PAD_ALWAYS, caps);
-  gst_element_class_add_pad_template (element_class, templ);
-
-  gst_element_class_set_details_simple (element_class,
-      "sfx3dnoise",
-      "Transform/Effect/Video",
-      "Add 3D noise to video", "Joshua M. Doe <oss@nvl.army.mil>");
-}
-
 static void
 gst_sfx3dnoise_class_init (GstSfx3DNoiseClass * klass)
 {
-  GObjectClass *gobject_class;
-  GstBaseTransformClass *gstbasetransform_class;
-  GstOpencvBaseTransformClass *gstopencvbasefilter_class;
-  GstElementClass *gstelement_class;
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *gstelement_class = GST_ELEMENT_CLASS (klass);
+  GstVideoFilterClass *videofilter_class = GST_VIDEO_FILTER_CLASS (klass);
 
-  gobject_class = (GObjectClass *) klass;
-  gstelement_class = (GstElementClass *) klass;
-  gstbasetransform_class = (GstBaseTransformClass *) klass;
-  gstopencvbasefilter_class = (GstOpencvBaseTransformClass *) klass;
-
-  parent_class = g_type_class_peek_parent (klass);
+  GST_DEBUG_CATEGORY_INIT (gst_sfx3dnoise_debug, "sfx3dnoise", 0,
+      "ARF 3D-noise sensor effects");
 
   gobject_class->finalize = GST_DEBUG_FUNCPTR (gst_sfx3dnoise_finalize);
   gobject_class->set_property = gst_sfx3dnoise_set_property;
   gobject_class->get_property = gst_sfx3dnoise_get_property;
 
-  gstopencvbasefilter_class->cv_trans_func = gst_sfx3dnoise_cv_transform;
-  gstopencvbasefilter_class->cv_set_caps = gst_sfx3dnoise_cv_set_caps;
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_sfx3dnoise_sink_template));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&gst_sfx3dnoise_src_template));
+
+  gst_element_class_set_static_metadata (gstelement_class,
+      "sfx3dnoise",
+      "Transform/Effect/Video",
+      "Add 3D noise to video", "Joshua M. Doe <oss@nvl.army.mil>");
+
+  videofilter_class->set_info = GST_DEBUG_FUNCPTR (gst_sfx3dnoise_set_info);
+  videofilter_class->transform_frame =
+      GST_DEBUG_FUNCPTR (gst_sfx3dnoise_transform_frame);
+  videofilter_class->transform_frame_ip =
+      GST_DEBUG_FUNCPTR (gst_sfx3dnoise_transform_frame_ip);
 
   g_object_class_install_property (gobject_class, PROP_SIGMA_T,
       g_param_spec_double ("sigma-t", "sigma-t",
@@ -210,10 +211,38 @@ gst_sfx3dnoise_class_init (GstSfx3DNoiseClass * klass)
           "Adds random spatio-temporal noise",
           0.0, 1.0, DEFAULT_SIGMA_T, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS)
       );
+
+  g_object_class_install_property (gobject_class, PROP_SEED,
+      g_param_spec_uint64 ("seed", "Seed",
+          "Seed of the random noise, the same seed and sigmas give the same "
+          "output frames every run, restarting on caps change",
+          0, G_MAXUINT64, DEFAULT_SEED,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      GST_STRIPE_POOL_PARAM_SPEC_N_THREADS (DEFAULT_N_THREADS));
+
+  g_object_class_install_property (gobject_class, PROP_NOISE_BANK_SIZE,
+      g_param_spec_uint ("noise-bank-size", "Noise bank size",
+          "Number of t, tv, th and tvh noise fields precomputed on caps "
+          "change and cycled with random offsets, instead of drawing new "
+          "noise every frame, each taking a float per pixel (0 disables)",
+          0, G_MAXINT, DEFAULT_NOISE_BANK_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_NOISE_BANK_REFRESH,
+      g_param_spec_boolean ("noise-bank-refresh", "Noise bank refresh",
+          "Replace noise bank fields one at a time from a background thread, "
+          "making the output depend on timing rather than only on the seed",
+          DEFAULT_NOISE_BANK_REFRESH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
 }
 
 static void
-gst_sfx3dnoise_init (GstSfx3DNoise * filter, GstSfx3DNoiseClass * gclass)
+gst_sfx3dnoise_init (GstSfx3DNoise * filter)
 {
   GST_DEBUG ("Initializing");
 
@@ -224,10 +253,26 @@ gst_sfx3dnoise_init (GstSfx3DNoise * filter, GstSfx3DNoiseClass * gclass)
   filter->sigma_th = DEFAULT_SIGMA_TH;
   filter->sigma_vh = filter->sigma_vh_old = DEFAULT_SIGMA_VH;
   filter->sigma_tvh = DEFAULT_SIGMA_TVH;
-
-  filter->rng = cvRNG (-1);
-  filter->fixed_noise = NULL;
-  filter->intermediary = NULL;
+  filter->seed = DEFAULT_SEED;
+  filter->n_threads = DEFAULT_N_THREADS;
+  filter->noise_bank_size = DEFAULT_NOISE_BANK_SIZE;
+  filter->noise_bank_refresh = DEFAULT_NOISE_BANK_REFRESH;
+
+  filter->frame = 0;
+  filter->fixed_generation = 0;
+  filter->stripe_pool = NULL;
+
+  filter->bank = NULL;
+  filter->bank_size = 0;
+  filter->bank_spare = NULL;
+  filter->bank_columns = NULL;
+  filter->bank_rand = NULL;
+  filter->bank_refresher = NULL;
+  g_mutex_init (&filter->bank_lock);
+
+  gst_sfx_noise_init (&filter->noise, gst_simd_get_level ());
+  GST_DEBUG_OBJECT (filter, "Using %s kernels",
+      gst_simd_get_name (gst_simd_get_level ()));
 
   filter->width = 0;
   filter->height = 0;
@@ -263,6 +308,18 @@ gst_sfx3dnoise_set_property (GObject * object, guint prop_id,
     case PROP_SIGMA_TVH:
       filter->sigma_tvh = g_value_get_double (value);
       break;
+    case PROP_SEED:
+      filter->seed = g_value_get_uint64 (value);
+      break;
+    case PROP_N_THREADS:
+      filter->n_threads = g_value_get_uint (value);
+      break;
+    case PROP_NOISE_BANK_SIZE:
+      filter->noise_bank_size = g_value_get_uint (value);
+      break;
+    case PROP_NOISE_BANK_REFRESH:
+      filter->noise_bank_refresh = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -297,93 +354,135 @@ gst_sfx3dnoise_get_property (GObject * object, guint prop_id,
     case PROP_SIGMA_TVH:
       g_value_set_double (value, filter->sigma_tvh);
       break;
+    case PROP_SEED:
+      g_value_set_uint64 (value, filter->seed);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, filter->n_threads);
+      break;
+    case PROP_NOISE_BANK_SIZE:
+      g_value_set_uint (value, filter->noise_bank_size);
+      break;
+    case PROP_NOISE_BANK_REFRESH:
+      g_value_set_boolean (value, filter->noise_bank_refresh);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
-static GstFlowReturn
-gst_sfx3dnoise_cv_transform (GstOpencvBaseTransform * base, GstBuffer * buf,
-    IplImage * img, GstBuffer * outbuf, IplImage * outimg)
+typedef struct
+{
+  GstSfx3DNoise *filter;
+  const guint8 *src;
+  gint src_stride;
+  guint8 *dst;
+  gint dst_stride;
+
+  /* noise bank field and its offset for this frame */
+  const gfloat *field;
+  gint dx;
+  gint dy;
+} GstSfx3DNoiseJob;
+
+/* Add all seven noise components to a 16-bit frame in a single pass, the
+ * per-frame t, tv and th components being drawn first as they are tiny */
+static void
+gst_sfx3dnoise_apply (GstSfx3DNoise * filter, const guint8 * src,
+    gint src_stride, guint8 * dst, gint dst_stride)
 {
-  GstSfx3DNoise *filter = GST_SFX3DNOISE (base);
-
-  GST_DEBUG ("Transforming");
-
-  cvConvert (img, filter->intermediary);
-
   if (filter->sigma_h != filter->sigma_h_old ||
       filter->sigma_v != filter->sigma_v_old ||
       filter->sigma_vh != filter->sigma_vh_old) {
     GST_DEBUG ("Creating new fixed pattern noise image");
-    gst_sfx3dnoise_create_fixed_noise (filter, filter->fixed_noise);
+    gst_sfx3dnoise_create_fixed_noise (filter);
 
     filter->sigma_h_old = filter->sigma_h;
     filter->sigma_v_old = filter->sigma_v;
     filter->sigma_vh_old = filter->sigma_vh;
   }
 
-  if (filter->sigma_h != 0.0 || filter->sigma_v != 0.0
-      || filter->sigma_vh != 0.0) {
-    cvAdd (filter->intermediary, filter->fixed_noise, filter->intermediary, 0);
+  if (filter->bank) {
+    gst_sfx3dnoise_apply_bank (filter, src, src_stride, dst, dst_stride);
+    filter->frame++;
+    return;
   }
 
-  if (filter->sigma_tvh > 0.0) {
-    gst_sfx3dnoise_add_sigma_tvh (filter, filter->intermediary,
-        filter->sigma_tvh);
-  }
+  gst_sfx_noise_apply (&filter->noise, filter->frame, src, src_stride, dst,
+      dst_stride, filter->sigma_t, filter->sigma_tv, filter->sigma_th,
+      filter->sigma_tvh);
 
-  if (filter->sigma_tv > 0.0) {
-    gst_sfx3dnoise_add_sigma_tv (filter, filter->intermediary,
-        filter->sigma_tv);
-  }
+  filter->frame++;
+}
 
-  if (filter->sigma_th > 0.0) {
-    gst_sfx3dnoise_add_sigma_th (filter, filter->intermediary,
-        filter->sigma_th);
-  }
+static GstFlowReturn
+gst_sfx3dnoise_transform_frame (GstVideoFilter * base,
+    GstVideoFrame * in_frame, GstVideoFrame * out_frame)
+{
+  GstSfx3DNoise *filter = GST_SFX3DNOISE (base);
 
-  if (filter->sigma_t > 0.0) {
-    gst_sfx3dnoise_add_sigma_t (filter, filter->intermediary, filter->sigma_t);
-  }
+  GST_DEBUG ("Transforming");
 
-  cvConvert (filter->intermediary, outimg);
+  gst_sfx3dnoise_apply (filter, GST_VIDEO_FRAME_PLANE_DATA (in_frame, 0),
+      GST_VIDEO_FRAME_PLANE_STRIDE (in_frame, 0),
+      GST_VIDEO_FRAME_PLANE_DATA (out_frame, 0),
+      GST_VIDEO_FRAME_PLANE_STRIDE (out_frame, 0));
+
+  return GST_FLOW_OK;
+}
+
+static GstFlowReturn
+gst_sfx3dnoise_transform_frame_ip (GstVideoFilter * base,
+    GstVideoFrame * frame)
+{
+  GstSfx3DNoise *filter = GST_SFX3DNOISE (base);
+
+  GST_DEBUG ("Transforming in place");
+
+  gst_sfx3dnoise_apply (filter, GST_VIDEO_FRAME_PLANE_DATA (frame, 0),
+      GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0),
+      GST_VIDEO_FRAME_PLANE_DATA (frame, 0),
+      GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0));
 
   return GST_FLOW_OK;
 }
 
 static gboolean
-gst_sfx3dnoise_cv_set_caps (GstOpencvBaseTransform * trans, gint in_width,
-    gint in_height, gint in_depth, gint in_channels, gint out_width,
-    gint out_height, gint out_depth, gint out_channels)
+gst_sfx3dnoise_set_info (GstVideoFilter * base, GstCaps * incaps,
+    GstVideoInfo * in_info, GstCaps * outcaps, GstVideoInfo * out_info)
 {
-  GstSfx3DNoise *filter = GST_SFX3DNOISE (trans);
+  GstSfx3DNoise *filter = GST_SFX3DNOISE (base);
 
   GST_DEBUG ("Caps have been set");
 
-  filter->width = in_width;
-  filter->height = in_height;
+  /* stop any background refresh before the frame size changes */
+  gst_sfx3dnoise_free_bank (filter);
 
-  if (filter->intermediary) {
-    cvReleaseMat (&filter->intermediary);
-    filter->intermediary = NULL;
-  }
+  filter->width = GST_VIDEO_INFO_WIDTH (in_info);
+  filter->height = GST_VIDEO_INFO_HEIGHT (in_info);
 
-  if (out_depth != IPL_DEPTH_32F) {
-    filter->intermediary = cvCreateMat (out_height, out_width, CV_32FC1);
-  }
+  if (gst_stripe_pool_ensure (&filter->stripe_pool, filter->n_threads))
+    GST_DEBUG_OBJECT (filter, "Processing with %d threads",
+        filter->stripe_pool->n_threads);
+  filter->noise.pool = filter->stripe_pool;
+  filter->noise.seed = filter->seed;
 
-  if (filter->fixed_noise) {
-    cvReleaseMat (&filter->fixed_noise);
-    filter->fixed_noise = NULL;
-  }
-  filter->fixed_noise = cvCreateMat (out_height, out_width, CV_32FC1);
-  gst_sfx3dnoise_create_fixed_noise (filter, filter->fixed_noise);
+  /* restart the random sequence so a seed always gives the same frames */
+  filter->frame = 0;
+  filter->fixed_generation = 0;
 
+  /* all noise buffers live as long as the caps, nothing is allocated per
+   * frame */
+  gst_sfx_noise_alloc (&filter->noise, filter->width, filter->height);
 
+  gst_sfx3dnoise_create_fixed_noise (filter);
+  filter->sigma_h_old = filter->sigma_h;
+  filter->sigma_v_old = filter->sigma_v;
+  filter->sigma_vh_old = filter->sigma_vh;
 
-  /* TODO create fixed noise here */
+  if (filter->noise_bank_size > 0)
+    gst_sfx3dnoise_create_bank (filter);
 
   return TRUE;
 }
@@ -397,100 +496,257 @@ gst_sfx3dnoise_plugin_init (GstPlugin * plugin)
       GST_TYPE_SFX3DNOISE);
 }
 
+/* Each regeneration draws from a new generation of the random streams */
 void
-gst_sfx3dnoise_create_fixed_noise (GstSfx3DNoise * filter, CvMat * arr)
+gst_sfx3dnoise_create_fixed_noise (GstSfx3DNoise * filter)
 {
-  cvZero (arr);
-  gst_sfx3dnoise_add_sigma_tvh (filter, arr, filter->sigma_vh);
-  gst_sfx3dnoise_add_sigma_th (filter, arr, filter->sigma_h);
-  gst_sfx3dnoise_add_sigma_tv (filter, arr, filter->sigma_v);
+  gst_sfx_noise_create_fixed (&filter->noise, filter->fixed_generation++,
+      filter->sigma_v, filter->sigma_h, filter->sigma_vh);
 }
 
-/* Add sigma-vh or sigma-tvh noise, which adds random noise to every pixel */
-void
-gst_sfx3dnoise_add_sigma_tvh (GstSfx3DNoise * filter, CvMat * arr, double sigma)
+typedef struct
 {
-  CvMat *noise = cvCreateMat (filter->height, filter->width, CV_32F);
+  GstSfx3DNoise *filter;
+  gfloat *field;
+  const gfloat *columns;
+  guint32 generation;
+  guint serial;
+  gdouble sigma_tv;
+  gdouble sigma_tvh;
+} GstSfx3DNoiseFieldJob;
+
+/* Start a new noise bank field, filling columns with the th and t
+ * components, which all rows share */
+static void
+gst_sfx3dnoise_field_init (GstSfx3DNoise * filter,
+    GstSfx3DNoiseFieldJob * job, gfloat * field, gfloat * columns)
+{
+  gdouble sigma_t, sigma_th;
+  gfloat t;
+  gint x;
+
+  g_mutex_lock (&filter->bank_lock);
+  job->generation = filter->bank_generation++;
+  job->serial = filter->bank_serial;
+  job->sigma_tv = filter->bank_sigma_tv;
+  job->sigma_tvh = filter->bank_sigma_tvh;
+  sigma_t = filter->bank_sigma_t;
+  sigma_th = filter->bank_sigma_th;
+  g_mutex_unlock (&filter->bank_lock);
+
+  job->filter = filter;
+  job->field = field;
+  job->columns = columns;
+
+  gst_sfx_noise_fill (&filter->noise, columns, filter->width, 0,
+      job->generation, GST_SFX_NOISE_TH, sigma_th);
+  gst_sfx_noise_fill (&filter->noise, &t, 1, 0, job->generation,
+      GST_SFX_NOISE_T, sigma_t);
+  for (x = 0; x < filter->width; x++)
+    columns[x] = columns[x] + t;
+}
 
-  /* TODO move scaling of sigma somewhere else? */
-  cvRandArr (&filter->rng, noise, CV_RAND_NORMAL, cvScalarAll (0),
-      cvScalarAll (sigma * (G_MAXUINT16 - 1)));
+static void
+gst_sfx3dnoise_field_rows (GstSfx3DNoiseFieldJob * job, gint row_start,
+    gint row_end)
+{
+  GstSfx3DNoise *filter = job->filter;
+  gint x, y;
+
+  for (y = row_start; y < row_end; y++) {
+    gfloat *field = job->field + (gsize) y * filter->width;
+    gfloat tv;
+
+    gst_sfx_noise_fill (&filter->noise, field, filter->width, y,
+        job->generation, GST_SFX_NOISE_TVH, job->sigma_tvh);
+    gst_sfx_noise_fill (&filter->noise, &tv, 1, y, job->generation,
+        GST_SFX_NOISE_TV, job->sigma_tv);
+    for (x = 0; x < filter->width; x++)
+      field[x] = field[x] + job->columns[x] + tv;
+  }
+}
 
-  cvAdd (arr, noise, arr, 0);
+static void
+gst_sfx3dnoise_field_stripe (gpointer user_data, guint stripe,
+    guint n_stripes)
+{
+  GstSfx3DNoiseFieldJob *job = (GstSfx3DNoiseFieldJob *) user_data;
+  gint row_start, row_end;
 
-  cvReleaseMat (&noise);
+  gst_stripe_get_rows (stripe, n_stripes, job->filter->height, &row_start,
+      &row_end);
+  gst_sfx3dnoise_field_rows (job, row_start, row_end);
 }
 
-
-/* Add sigma-v or sigma-tv noise, which adds random horizontal lines */
-void
-gst_sfx3dnoise_add_sigma_tv (GstSfx3DNoise * filter, CvMat * arr, double sigma)
+/* Fill every field of the bank for the current sigmas, discarding any
+ * field being refreshed for the old ones */
+static void
+gst_sfx3dnoise_generate_bank (GstSfx3DNoise * filter)
 {
-  CvMat *noise = cvCreateMat (1, filter->height, CV_32F);
-  gfloat *data;
-  gfloat *noisedata;
-  int step, x, y;
+  GstSfx3DNoiseFieldJob job;
+  guint i;
+
+  GST_DEBUG ("Generating noise bank of %d fields", filter->bank_size);
+
+  g_mutex_lock (&filter->bank_lock);
+  filter->bank_sigma_t = filter->sigma_t;
+  filter->bank_sigma_tv = filter->sigma_tv;
+  filter->bank_sigma_th = filter->sigma_th;
+  filter->bank_sigma_tvh = filter->sigma_tvh;
+  filter->bank_serial++;
+  g_mutex_unlock (&filter->bank_lock);
+
+  for (i = 0; i < filter->bank_size; i++) {
+    gst_sfx3dnoise_field_init (filter, &job, filter->bank[i],
+        filter->noise.columns);
+    gst_stripe_pool_run (filter->stripe_pool, gst_sfx3dnoise_field_stripe,
+        &job);
+  }
+  filter->bank_replace = 0;
+}
 
-  /* TODO move scaling of sigma somewhere else? */
-  cvRandArr (&filter->rng, noise, CV_RAND_NORMAL, cvScalarAll (0),
-      cvScalarAll (sigma * (G_MAXUINT16 - 1)));
+/* Runs in the background, refilling the spare field */
+static void
+gst_sfx3dnoise_bank_refresh (gpointer data, gpointer user_data)
+{
+  GstSfx3DNoise *filter = GST_SFX3DNOISE (data);
+  GstSfx3DNoiseFieldJob job;
 
-  cvGetRawData (arr, (uchar **) & data, &step, NULL);
-  cvGetRawData (noise, (uchar **) & noisedata, NULL, NULL);
+  gst_sfx3dnoise_field_init (filter, &job, filter->bank_spare,
+      filter->bank_columns);
+  gst_sfx3dnoise_field_rows (&job, 0, filter->height);
 
-  step /= sizeof (gfloat);
+  g_mutex_lock (&filter->bank_lock);
+  filter->bank_spare_serial = job.serial;
+  filter->bank_spare_ready = TRUE;
+  g_mutex_unlock (&filter->bank_lock);
+}
 
-  for (y = 0; y < filter->height; y++) {
-    for (x = 0; x < filter->width; x++) {
-      data[y * step + x] += noisedata[y];
-    }
+static void
+gst_sfx3dnoise_create_bank (GstSfx3DNoise * filter)
+{
+  guint i;
+
+  filter->bank_size = filter->noise_bank_size;
+  filter->bank = g_new (gfloat *, filter->bank_size);
+  for (i = 0; i < filter->bank_size; i++)
+    filter->bank[i] = g_new (gfloat, (gsize) filter->width * filter->height);
+
+  filter->bank_rand = g_rand_new_with_seed ((guint32) (filter->seed ^
+          (filter->seed >> 32)));
+  filter->bank_generation = 0;
+  gst_sfx3dnoise_generate_bank (filter);
+
+  if (filter->noise_bank_refresh) {
+    filter->bank_spare = g_new (gfloat, (gsize) filter->width *
+        filter->height);
+    filter->bank_columns = g_new (gfloat, filter->width);
+    filter->bank_spare_ready = FALSE;
+    filter->bank_refresher = g_thread_pool_new (gst_sfx3dnoise_bank_refresh,
+        NULL, 1, FALSE, NULL);
+    if (filter->bank_refresher)
+      g_thread_pool_push (filter->bank_refresher, filter, NULL);
   }
-
-  cvReleaseMat (&noise);
 }
 
-
-/* Add sigma-h and sigma-th noise, which adds random vertical lines */
-void
-gst_sfx3dnoise_add_sigma_th (GstSfx3DNoise * filter, CvMat * arr, double sigma)
+static void
+gst_sfx3dnoise_free_bank (GstSfx3DNoise * filter)
 {
-  CvMat *noise = cvCreateMat (1, filter->width, CV_32F);
-  gfloat *data;
-  gfloat *noisedata;
-  int step, x, y;
+  guint i;
 
-  /* TODO move scaling of sigma somewhere else? */
-  cvRandArr (&filter->rng, noise, CV_RAND_NORMAL, cvScalarAll (0),
-      cvScalarAll (sigma * (G_MAXUINT16 - 1)));
+  /* waits for a refresh in progress */
+  if (filter->bank_refresher)
+    g_thread_pool_free (filter->bank_refresher, TRUE, TRUE);
+  filter->bank_refresher = NULL;
 
-  cvGetRawData (arr, (uchar **) & data, &step, NULL);
-  cvGetRawData (noise, (uchar **) & noisedata, NULL, NULL);
+  g_free (filter->bank_spare);
+  filter->bank_spare = NULL;
 
-  step /= sizeof (gfloat);
+  g_free (filter->bank_columns);
+  filter->bank_columns = NULL;
 
-  for (y = 0; y < filter->height; y++) {
-    for (x = 0; x < filter->width; x++) {
-      data[y * step + x] += noisedata[x];
-    }
-  }
+  if (filter->bank_rand)
+    g_rand_free (filter->bank_rand);
+  filter->bank_rand = NULL;
 
-  cvReleaseMat (&noise);
+  if (filter->bank) {
+    for (i = 0; i < filter->bank_size; i++)
+      g_free (filter->bank[i]);
+    g_free (filter->bank);
+  }
+  filter->bank = NULL;
 }
 
-/* Add Sigma_T noise, which creates a flashing effect */
-void
-gst_sfx3dnoise_add_sigma_t (GstSfx3DNoise * filter, CvMat * arr, double sigma)
+/* Add the fixed noise and a bank field with wrapped offsets, which is just
+ * the fused row kernel without random variates */
+static void
+gst_sfx3dnoise_bank_stripe (gpointer user_data, guint stripe,
+    guint n_stripes)
 {
-  CvMat *noise = cvCreateMat (1, 1, CV_32F);
-  float *data;
-
-  /* TODO move scaling of sigma somewhere else? */
-  cvRandArr (&filter->rng, noise, CV_RAND_NORMAL, cvScalarAll (0),
-      cvScalarAll (sigma * (G_MAXUINT16 - 1)));
-
-  cvGetRawData (noise, (uchar **) & data, NULL, NULL);
+  GstSfx3DNoiseJob *job = (GstSfx3DNoiseJob *) user_data;
+  GstSfx3DNoise *filter = job->filter;
+  GstSfxNoiseStream stream;
+  const gint first = filter->width - job->dx;
+  gint y, row_start, row_end;
+
+  gst_stripe_get_rows (stripe, n_stripes, filter->height, &row_start,
+      &row_end);
+  gst_sfx_noise_set_stream (&filter->noise, &stream, 0, filter->frame,
+      GST_SFX_NOISE_TVH);
+
+  for (y = row_start; y < row_end; y++) {
+    const guint16 *src = (const guint16 *) (job->src + y * job->src_stride);
+    guint16 *dst = (guint16 *) (job->dst + y * job->dst_stride);
+    const gfloat *fixed = filter->noise.fixed + (gsize) y * filter->width;
+    const gfloat *field = job->field +
+        (gsize) ((y + job->dy) % filter->height) * filter->width;
+
+    filter->noise.noise_row (dst, src, fixed, field + job->dx, 0.0f, first,
+        &stream, 0.0f);
+    if (job->dx > 0)
+      filter->noise.noise_row (dst + first, src + first, fixed + first, field,
+          0.0f, job->dx, &stream, 0.0f);
+  }
+}
 
-  cvAddS (arr, cvScalarAll (*data), arr, 0);
+static void
+gst_sfx3dnoise_apply_bank (GstSfx3DNoise * filter, const guint8 * src,
+    gint src_stride, guint8 * dst, gint dst_stride)
+{
+  GstSfx3DNoiseJob job;
+
+  if (filter->sigma_t != filter->bank_sigma_t ||
+      filter->sigma_tv != filter->bank_sigma_tv ||
+      filter->sigma_th != filter->bank_sigma_th ||
+      filter->sigma_tvh != filter->bank_sigma_tvh)
+    gst_sfx3dnoise_generate_bank (filter);
+
+  /* swap in a refreshed field between frames, when no stripe uses it */
+  if (filter->bank_refresher) {
+    g_mutex_lock (&filter->bank_lock);
+    if (filter->bank_spare_ready) {
+      filter->bank_spare_ready = FALSE;
+      if (filter->bank_spare_serial == filter->bank_serial) {
+        gfloat *field = filter->bank[filter->bank_replace];
+        filter->bank[filter->bank_replace] = filter->bank_spare;
+        filter->bank_spare = field;
+        filter->bank_replace =
+            (filter->bank_replace + 1) % filter->bank_size;
+      }
+      g_thread_pool_push (filter->bank_refresher, filter, NULL);
+    }
+    g_mutex_unlock (&filter->bank_lock);
+  }
 
-  cvReleaseMat (&noise);
+  job.filter = filter;
+  job.src = src;
+  job.src_stride = src_stride;
+  job.dst = dst;
+  job.dst_stride = dst_stride;
+  job.field = filter->bank[g_rand_int_range (filter->bank_rand, 0,
+          filter->bank_size)];
+  job.dy = g_rand_int_range (filter->bank_rand, 0, filter->height);
+  job.dx = g_rand_int_range (filter->bank_rand, 0, filter->width);
+
+  gst_stripe_pool_run (filter->stripe_pool, gst_sfx3dnoise_bank_stripe, &job);
 }
@@ -45,8 +45,9 @@
 #define __GST_SFX3DNOISE_H__
 
 #include <gst/gst.h>
-#include <cv.h>
-#include <gstopencvbasetrans.h>
+#include <gst/video/gstvideofilter.h>
+
+#include "gstsensorfxnoise.h"
 
 G_BEGIN_DECLS
 
@@ -67,7 +68,7 @@ typedef struct _GstSfx3DNoiseClass GstSfx3DNoiseClass;
 
 struct _GstSfx3DNoise
 {
-  GstOpencvBaseTransform element;
+  GstVideoFilter element;
 
   gdouble sigma_t;
   gdouble sigma_v;
@@ -81,17 +82,46 @@ struct _GstSfx3DNoise
   gdouble sigma_h_old;
   gdouble sigma_vh_old;
 
+  guint64 seed;
+  guint n_threads;
+  guint noise_bank_size;
+  gboolean noise_bank_refresh;
+
   gint width;
   gint height;
 
-  CvRNG rng;
-  CvMat * fixed_noise;
-  CvMat * intermediary;
+  /* buffers preallocated in set_info, seed and pool set there too */
+  GstSfxNoise noise;
+
+  guint32 frame;
+  guint32 fixed_generation;
+
+  GstStripePool *stripe_pool;
+
+  /* temporal noise bank, each field holding the t, tv, th and tvh
+   * components, bank_spare being refilled by bank_refresher */
+  gfloat ** bank;
+  guint bank_size;
+  gfloat * bank_spare;
+  gfloat * bank_columns;
+  GRand *bank_rand;
+  GThreadPool *bank_refresher;
+  GMutex bank_lock;
+  guint32 bank_generation;
+  guint bank_serial;
+  guint bank_spare_serial;
+  gboolean bank_spare_ready;
+  guint bank_replace;
+
+  gdouble bank_sigma_t;
+  gdouble bank_sigma_tv;
+  gdouble bank_sigma_th;
+  gdouble bank_sigma_tvh;
 };
 
 struct _GstSfx3DNoiseClass 
 {
-  GstOpencvBaseTransformClass parent_class;
+  GstVideoFilterClass parent_class;
 };
 
 GType gst_sfx3dnoise_get_type (void);
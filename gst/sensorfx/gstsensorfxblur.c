@@ -24,12 +24,17 @@
 /**
 * SECTION:element-sfxblur
 *
-* Convert grayscale video from one bpp/depth combination to another.
+* Blurs grayscale video like a sensor: the optics MTF as a Gaussian or a
+* user-supplied 1-D kernel, then the detector footprint as a box. Both are
+* separable, so each runs along rows and then along columns.
+*
+* Large Gaussians are approximated by three sliding-window box filters which,
+* like the detector box, cost the same at any width.
 *
 * <refsect2>
 * <title>Example launch line</title>
 * |[
-* gst-launch videotestsrc ! sfxblur ! ffmpegcolorspace ! autovideosink
+* gst-launch-1.0 videotestsrc ! video/x-raw,format=GRAY16_LE ! sfxblur sigma=2 detector-width=3 detector-height=3 ! videoconvert ! autovideosink
 * ]|
 * </refsect2>
 */
@@ -38,14 +43,8 @@
 #include "config.h"
 #endif
 
-#include <string.h>
-#include <math.h>
-
 #include <gst/video/video.h>
 
-#include <cv.h>
-
-#include "gstopencvutils.h"
 #include "gstsensorfxblur.h"
 
 /* GstSensorFxBlur signals and args */
@@ -58,56 +57,34 @@ enum
 enum
 {
   PROP_0,
-  PROP_LOWIN,
+  PROP_SIGMA,
+  PROP_KERNEL,
+  PROP_DETECTOR_WIDTH,
+  PROP_DETECTOR_HEIGHT,
+  PROP_N_THREADS
 };
 
-#define DEFAULT_PROP_LOWIN  0.0
+#define DEFAULT_PROP_SIGMA 1.0
+#define DEFAULT_PROP_KERNEL NULL
+#define DEFAULT_PROP_DETECTOR_WIDTH 1
+#define DEFAULT_PROP_DETECTOR_HEIGHT 1
+#define DEFAULT_PROP_N_THREADS 1
 
-static const GstElementDetails sfxblur_details =
-GST_ELEMENT_DETAILS ("Blurs video",
-    "Filter/Effect/Video",
-    "Applies a blur kernel to video",
-    "Joshua Doe <oss@nvl.army.mil");
+#define GST_SFXBLUR_CAPS GST_VIDEO_CAPS_MAKE ("{ GRAY8, GRAY16_LE }")
 
 /* the capabilities of the inputs and outputs */
 static GstStaticPadTemplate gst_sfxblur_src_template =
-    GST_STATIC_PAD_TEMPLATE ("sink",
-    GST_PAD_SINK,
+    GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS ("video/x-raw-gray, "
-        "bpp = (int) 16, "
-        "depth = (int) 16, "
-        "endianness = (int) BYTE_ORDER, "
-        "width = " GST_VIDEO_SIZE_RANGE ", "
-        "height = " GST_VIDEO_SIZE_RANGE ", "
-        "framerate = " GST_VIDEO_FPS_RANGE ";"
-        "video/x-raw-gray-float, "
-        "bpp = (int) 32, "
-        "depth = (int) 32, "
-        "endianness = (int) BYTE_ORDER, "
-        "width = " GST_VIDEO_SIZE_RANGE ", "
-        "height = " GST_VIDEO_SIZE_RANGE ", "
-        "framerate = " GST_VIDEO_FPS_RANGE)
+    GST_STATIC_CAPS (GST_SFXBLUR_CAPS)
     );
 
 static GstStaticPadTemplate gst_sfxblur_sink_template =
-    GST_STATIC_PAD_TEMPLATE ("src",
-    GST_PAD_SRC,
+    GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS ("video/x-raw-gray, "
-        "bpp = (int) 16, "
-        "depth = (int) 16, "
-        "endianness = (int) BYTE_ORDER, "
-        "width = " GST_VIDEO_SIZE_RANGE ", "
-        "height = " GST_VIDEO_SIZE_RANGE ", "
-        "framerate = " GST_VIDEO_FPS_RANGE ";"
-        "video/x-raw-gray-float, "
-        "bpp = (int) 32, "
-        "depth = (int) 32, "
-        "endianness = (int) BYTE_ORDER, "
-        "width = " GST_VIDEO_SIZE_RANGE ", "
-        "height = " GST_VIDEO_SIZE_RANGE ", "
-        "framerate = " GST_VIDEO_FPS_RANGE)
+    GST_STATIC_CAPS (GST_SFXBLUR_CAPS)
     );
 
 /* GObject vmethod declarations */
@@ -117,11 +94,12 @@ static void gst_sfxblur_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_sfxblur_finalize (GObject * object);
 
-/* GstBaseTransform vmethod declarations */
-static gboolean gst_sfxblur_set_caps (GstBaseTransform * base,
-    GstCaps * incaps, GstCaps * outcaps);
-static GstFlowReturn gst_sfxblur_transform_ip (GstBaseTransform * base,
-    GstBuffer * buf);
+/* GstVideoFilter vmethod declarations */
+static gboolean gst_sfxblur_set_info (GstVideoFilter * filter,
+    GstCaps * incaps, GstVideoInfo * in_info, GstCaps * outcaps,
+    GstVideoInfo * out_info);
+static GstFlowReturn gst_sfxblur_transform_frame_ip (GstVideoFilter * filter,
+    GstVideoFrame * frame);
 
 /* GstSensorFxBlur method declarations */
 static void gst_sfxblur_reset (GstSensorFxBlur * filter);
@@ -129,38 +107,14 @@ static void gst_sfxblur_reset (GstSensorFxBlur * filter);
 /* setup debug */
 GST_DEBUG_CATEGORY_STATIC (sfxblur_debug);
 #define GST_CAT_DEFAULT sfxblur_debug
-#define DEBUG_INIT(bla) \
-    GST_DEBUG_CATEGORY_INIT (sfxblur_debug, "sfxblur", 0, \
-    "sfxblur");
 
-GST_BOILERPLATE_FULL (GstSensorFxBlur, gst_sfxblur, GstVideoFilter,
-    GST_TYPE_VIDEO_FILTER, DEBUG_INIT);
+G_DEFINE_TYPE (GstSensorFxBlur, gst_sfxblur, GST_TYPE_VIDEO_FILTER);
 
 
 /************************************************************************/
 /* GObject vmethod implementations                                      */
 /************************************************************************/
 
-/**
- * gst_sfxblur_base_init:
- * @klass: #GstElementClass.
- *
- */
-static void
-gst_sfxblur_base_init (gpointer klass)
-{
-  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
-
-  GST_DEBUG ("base init");
-
-  gst_element_class_set_details (element_class, &sfxblur_details);
-
-  gst_element_class_add_pad_template (element_class,
-      gst_static_pad_template_get (&gst_sfxblur_sink_template));
-  gst_element_class_add_pad_template (element_class,
-      gst_static_pad_template_get (&gst_sfxblur_src_template));
-}
-
 /**
  * gst_sfxblur_finalize:
  * @object: #GObject.
@@ -174,9 +128,10 @@ gst_sfxblur_finalize (GObject * object)
   GST_DEBUG ("finalize");
 
   gst_sfxblur_reset (sfxblur);
+  g_free (sfxblur->kernel);
 
   /* chain up to the parent class */
-  G_OBJECT_CLASS (parent_class)->finalize (object);
+  G_OBJECT_CLASS (gst_sfxblur_parent_class)->finalize (object);
 }
 
 /**
@@ -185,13 +140,15 @@ gst_sfxblur_finalize (GObject * object)
  *
  */
 static void
-gst_sfxblur_class_init (GstSensorFxBlurClass * object)
+gst_sfxblur_class_init (GstSensorFxBlurClass * klass)
 {
-  GObjectClass *obj_class = G_OBJECT_CLASS (object);
-  GstBaseTransformClass *trans_class = GST_BASE_TRANSFORM_CLASS (object);
+  GObjectClass *obj_class = G_OBJECT_CLASS (klass);
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+  GstVideoFilterClass *videofilter_class = GST_VIDEO_FILTER_CLASS (klass);
 
-  GST_DEBUG ("class init");
+  GST_DEBUG_CATEGORY_INIT (sfxblur_debug, "sfxblur", 0, "sfxblur");
 
+  GST_DEBUG ("class init");
 
   /* Register GObject vmethods */
   obj_class->finalize = GST_DEBUG_FUNCPTR (gst_sfxblur_finalize);
@@ -199,30 +156,77 @@ gst_sfxblur_class_init (GstSensorFxBlurClass * object)
   obj_class->get_property = GST_DEBUG_FUNCPTR (gst_sfxblur_get_property);
 
   /* Install GObject properties */
-  g_object_class_install_property (obj_class, PROP_LOWIN,
-      g_param_spec_double ("lower-input-level", "Lower Input Level",
-          "Lower Input Level", 0.0, 1.0, DEFAULT_PROP_LOWIN,
-          G_PARAM_READWRITE));
-
-  /* Register GstBaseTransform vmethods */
-  trans_class->set_caps = GST_DEBUG_FUNCPTR (gst_sfxblur_set_caps);
-  trans_class->transform_ip = GST_DEBUG_FUNCPTR (gst_sfxblur_transform_ip);
+  g_object_class_install_property (obj_class, PROP_SIGMA,
+      g_param_spec_double ("sigma", "Sigma",
+          "Standard deviation in pixels of the Gaussian optics blur, wide "
+          "ones being approximated by three box filters (0 disables)",
+          0.0, 1000.0, DEFAULT_PROP_SIGMA,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (obj_class, PROP_KERNEL,
+      g_param_spec_string ("kernel", "Kernel",
+          "Comma-separated 1-D optics kernel applied along rows and columns "
+          "instead of the Gaussian, normalized to unit sum",
+          DEFAULT_PROP_KERNEL,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (obj_class, PROP_DETECTOR_WIDTH,
+      g_param_spec_uint ("detector-width", "Detector width",
+          "Width in pixels of the detector footprint, averaged by a box filter",
+          1, 1024, DEFAULT_PROP_DETECTOR_WIDTH,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (obj_class, PROP_DETECTOR_HEIGHT,
+      g_param_spec_uint ("detector-height", "Detector height",
+          "Height in pixels of the detector footprint, averaged by a box "
+          "filter", 1, 1024, DEFAULT_PROP_DETECTOR_HEIGHT,
+          G_PARAM_STATIC_STRINGS | G_PARAM_READWRITE |
+          GST_PARAM_MUTABLE_PLAYING));
+  g_object_class_install_property (obj_class, PROP_N_THREADS,
+      GST_STRIPE_POOL_PARAM_SPEC_N_THREADS (DEFAULT_PROP_N_THREADS));
+
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&gst_sfxblur_sink_template));
+  gst_element_class_add_pad_template (element_class,
+      gst_static_pad_template_get (&gst_sfxblur_src_template));
+
+  gst_element_class_set_static_metadata (element_class,
+      "Blurs video", "Filter/Effect/Video",
+      "Applies optics and detector blur to video",
+      "Joshua M. Doe <oss@nvl.army.mil>");
+
+  /* Register GstVideoFilter vmethods */
+  videofilter_class->set_info = GST_DEBUG_FUNCPTR (gst_sfxblur_set_info);
+  videofilter_class->transform_frame_ip =
+      GST_DEBUG_FUNCPTR (gst_sfxblur_transform_frame_ip);
 }
 
 /**
 * gst_sfxblur_init:
 * @sfxblur: GstSensorFxBlur
-* @g_class: GstSensorFxBlurClass
 *
 * Initialize the new element
 */
 static void
-gst_sfxblur_init (GstSensorFxBlur * sfxblur, GstSensorFxBlurClass * g_class)
+gst_sfxblur_init (GstSensorFxBlur * sfxblur)
 {
   GST_DEBUG_OBJECT (sfxblur, "init class instance");
 
+  sfxblur->sigma = DEFAULT_PROP_SIGMA;
+  sfxblur->kernel = g_strdup (DEFAULT_PROP_KERNEL);
+  sfxblur->detector_width = DEFAULT_PROP_DETECTOR_WIDTH;
+  sfxblur->detector_height = DEFAULT_PROP_DETECTOR_HEIGHT;
+  sfxblur->n_threads = DEFAULT_PROP_N_THREADS;
+
+  sfxblur->stripe_pool = NULL;
+
+  gst_sfx_psf_init (&sfxblur->psf, gst_simd_get_level ());
+  GST_DEBUG_OBJECT (sfxblur, "Using %s kernels",
+      gst_simd_get_name (gst_simd_get_level ()));
+
   gst_sfxblur_reset (sfxblur);
 
+  gst_base_transform_set_in_place (GST_BASE_TRANSFORM (sfxblur), TRUE);
 }
 
 /**
@@ -241,11 +245,30 @@ gst_sfxblur_set_property (GObject * object, guint prop_id,
 
   GST_DEBUG ("setting property %s", pspec->name);
 
+  GST_OBJECT_LOCK (sfxblur);
   switch (prop_id) {
+    case PROP_SIGMA:
+      sfxblur->sigma = g_value_get_double (value);
+      break;
+    case PROP_KERNEL:
+      g_free (sfxblur->kernel);
+      sfxblur->kernel = g_value_dup_string (value);
+      break;
+    case PROP_DETECTOR_WIDTH:
+      sfxblur->detector_width = g_value_get_uint (value);
+      break;
+    case PROP_DETECTOR_HEIGHT:
+      sfxblur->detector_height = g_value_get_uint (value);
+      break;
+    case PROP_N_THREADS:
+      sfxblur->n_threads = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
+  sfxblur->stages_dirty = TRUE;
+  GST_OBJECT_UNLOCK (sfxblur);
 }
 
 /**
@@ -264,67 +287,116 @@ gst_sfxblur_get_property (GObject * object, guint prop_id, GValue * value,
 
   GST_DEBUG ("getting property %s", pspec->name);
 
+  GST_OBJECT_LOCK (sfxblur);
   switch (prop_id) {
+    case PROP_SIGMA:
+      g_value_set_double (value, sfxblur->sigma);
+      break;
+    case PROP_KERNEL:
+      g_value_set_string (value, sfxblur->kernel);
+      break;
+    case PROP_DETECTOR_WIDTH:
+      g_value_set_uint (value, sfxblur->detector_width);
+      break;
+    case PROP_DETECTOR_HEIGHT:
+      g_value_set_uint (value, sfxblur->detector_height);
+      break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, sfxblur->n_threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
+  GST_OBJECT_UNLOCK (sfxblur);
+}
+
+/************************************************************************/
+/* GstSensorFxBlur stage construction                                   */
+/************************************************************************/
+
+/* Rebuild the stages from the properties */
+static void
+gst_sfxblur_update_stages (GstSensorFxBlur * filt)
+{
+  gdouble sigma;
+  gchar *kernel;
+  guint detector_width, detector_height;
+
+  GST_OBJECT_LOCK (filt);
+  sigma = filt->sigma;
+  kernel = g_strdup (filt->kernel);
+  detector_width = filt->detector_width;
+  detector_height = filt->detector_height;
+  filt->stages_dirty = FALSE;
+  GST_OBJECT_UNLOCK (filt);
+
+  if (!gst_sfx_psf_set_stages (&filt->psf, sigma, kernel, detector_width,
+          detector_height))
+    GST_WARNING_OBJECT (filt, "Ignoring invalid kernel '%s'", kernel);
+  g_free (kernel);
+
+  GST_DEBUG_OBJECT (filt, "%d horizontal and %d vertical stages",
+      filt->psf.n_h_stages, filt->psf.n_v_stages);
 }
 
 /************************************************************************/
-/* GstBaseTransform vmethod implementations                             */
+/* GstVideoFilter vmethod implementations                               */
 /************************************************************************/
 
 /**
- * gst_sfxblur_set_caps:
- * base: #GstBaseTransform
- * incaps: #GstCaps
- * outcaps: #GstCaps
- * 
+ * gst_sfxblur_set_info:
+ * @filter: #GstVideoFilter
+ * @incaps: #GstCaps
+ * @in_info: #GstVideoInfo of the input
+ * @outcaps: #GstCaps
+ * @out_info: #GstVideoInfo of the output
+ *
  * Notification of the actual caps set.
  *
  * Returns: TRUE on acceptance of caps
  */
 static gboolean
-gst_sfxblur_set_caps (GstBaseTransform * base, GstCaps * incaps,
-    GstCaps * outcaps)
+gst_sfxblur_set_info (GstVideoFilter * filter, GstCaps * incaps,
+    GstVideoInfo * in_info, GstCaps * outcaps, GstVideoInfo * out_info)
 {
-  GstSensorFxBlur *levels;
-  GstStructure *structure;
-  gboolean res;
-
-  levels = GST_SENSORFXBLUR (base);
-
-  GST_DEBUG_OBJECT (levels,
-      "set_caps: in %" GST_PTR_FORMAT " out %" GST_PTR_FORMAT, incaps, outcaps);
-
-  GST_DEBUG_OBJECT (incaps, "incaps");
-  GST_DEBUG_OBJECT (outcaps, "outcaps");
+  GstSensorFxBlur *filt = GST_SENSORFXBLUR (filter);
+  gboolean sixteen;
 
-  /* retrieve input caps info */
-  structure = gst_caps_get_structure (incaps, 0);
+  GST_DEBUG_OBJECT (filt,
+      "set_info: in %" GST_PTR_FORMAT " out %" GST_PTR_FORMAT, incaps, outcaps);
 
-  //mime = gst_structure_get_name (structure);
-  //if (g_strcmp0 ("video/x-raw-gray", mime) == 0)
-  //  levels->
+  if (gst_stripe_pool_ensure (&filt->stripe_pool, filt->n_threads))
+    GST_DEBUG_OBJECT (filt, "Processing with %d threads",
+        filt->stripe_pool->n_threads);
 
-  res = gst_structure_get (structure,
-      "width", G_TYPE_INT, &levels->width,
-      "height", G_TYPE_INT, &levels->height,
-      "bpp", G_TYPE_INT, &levels->bpp,
-      "depth", G_TYPE_INT, &levels->depth,
-      "endianness", G_TYPE_INT, &levels->endianness, NULL);
-  if (!res)
-    return FALSE;
+  sixteen = GST_VIDEO_INFO_FORMAT (in_info) == GST_VIDEO_FORMAT_GRAY16_LE;
+  filt->psf.pool = filt->stripe_pool;
+  gst_sfx_psf_alloc (&filt->psf, GST_VIDEO_INFO_WIDTH (in_info),
+      GST_VIDEO_INFO_HEIGHT (in_info), sixteen);
 
-  levels->stride = GST_ROUND_UP_4 (levels->width * levels->depth / 8);
+  GST_OBJECT_LOCK (filt);
+  filt->stages_dirty = TRUE;
+  GST_OBJECT_UNLOCK (filt);
 
-  return res;
+  return TRUE;
 }
 
-GstFlowReturn
-gst_sfxblur_transform_ip (GstBaseTransform * base, GstBuffer * buf)
+static GstFlowReturn
+gst_sfxblur_transform_frame_ip (GstVideoFilter * filter,
+    GstVideoFrame * frame)
 {
+  GstSensorFxBlur *filt = GST_SENSORFXBLUR (filter);
+  gboolean dirty;
+
+  GST_OBJECT_LOCK (filt);
+  dirty = filt->stages_dirty;
+  GST_OBJECT_UNLOCK (filt);
+  if (dirty)
+    gst_sfxblur_update_stages (filt);
+
+  gst_sfx_psf_apply (&filt->psf, GST_VIDEO_FRAME_PLANE_DATA (frame, 0),
+      GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0));
 
   return GST_FLOW_OK;
 }
@@ -342,17 +414,10 @@ gst_sfxblur_transform_ip (GstBaseTransform * base, GstBuffer * buf)
 static void
 gst_sfxblur_reset (GstSensorFxBlur * sfxblur)
 {
-  sfxblur->width = 0;
-  sfxblur->height = 0;
-  sfxblur->stride = 0;
-  sfxblur->bpp = 0;
-  sfxblur->depth = 0;
-  sfxblur->endianness = 0;
-}
+  gst_sfx_psf_free (&sfxblur->psf);
+  sfxblur->stages_dirty = TRUE;
 
-gboolean
-gst_sfxblur_plugin_init (GstPlugin * plugin)
-{
-  return gst_element_register (plugin, "sfxblur", GST_RANK_NONE,
-      GST_TYPE_SENSORFXBLUR);
+  gst_stripe_pool_free (sfxblur->stripe_pool);
+  sfxblur->stripe_pool = NULL;
+  sfxblur->psf.pool = NULL;
 }
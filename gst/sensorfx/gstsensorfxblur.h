@@ -27,6 +27,9 @@
 
 #include <gst/video/gstvideofilter.h>
 
+#include "gstsensorfxpsf.h"
+#include "stripepool.h"
+
 G_BEGIN_DECLS
 
 #define GST_TYPE_SENSORFXBLUR \
@@ -54,16 +57,18 @@ struct _GstSensorFxBlur
 {
   GstVideoFilter element;
 
-  /* format */
-  gint width;
-  gint height;
-  guint stride;
-  gint bpp;
-  gint depth;
-  gint endianness;
-
   /* properties */
+  gdouble sigma;
+  gchar *kernel;
+  guint detector_width;
+  guint detector_height;
+  guint n_threads;
 
+  /* blur stages, rebuilt from the properties when they change */
+  gboolean stages_dirty;
+  GstSfxPsf psf;
+
+  GstStripePool *stripe_pool;
 };
 
 struct _GstSensorFxBlurClass
@@ -73,8 +78,6 @@ struct _GstSensorFxBlurClass
 
 GType gst_sfxblur_get_type(void);
 
-gboolean gst_sfxblur_plugin_init (GstPlugin * plugin);
-
 G_END_DECLS
 
 #endif /* __GST_SENSORFXBLUR_H__ */
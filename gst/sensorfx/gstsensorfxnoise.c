@@ -0,0 +1,255 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * 3D-noise generation for sfx3dnoise, free of GStreamer types so that
+ * sfxnoisetest can check its output at every instruction set and thread
+ * count.
+ *
+ * Every row of every component draws from its own random stream, so rows
+ * can be generated by any thread in any order with the same result.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "gstsensorfxnoise.h"
+
+/**
+ * gst_sfx_noise_init:
+ * @noise: #GstSfxNoise
+ * @level: instruction set of the kernels, at most gst_simd_get_level()
+ *
+ * Select the kernels, leaving the seed, size and pool to the caller.
+ */
+void
+gst_sfx_noise_init (GstSfxNoise * noise, GstSimdLevel level)
+{
+  memset (noise, 0, sizeof (GstSfxNoise));
+  noise->normal = gst_sfx_simd_get_normal_func (level);
+  noise->noise_row = gst_sfx_simd_get_noise_row_func (level);
+}
+
+/**
+ * gst_sfx_noise_alloc:
+ * @noise: #GstSfxNoise
+ * @width: width of the frames
+ * @height: height of the frames
+ *
+ * Allocate the noise buffers for a frame size, so nothing is allocated per
+ * frame.
+ */
+void
+gst_sfx_noise_alloc (GstSfxNoise * noise, gint width, gint height)
+{
+  gst_sfx_noise_free (noise);
+
+  noise->width = width;
+  noise->height = height;
+  noise->fixed = g_new (gfloat, (gsize) width * height);
+  noise->rows = g_new (gfloat, height);
+  noise->columns = g_new (gfloat, width);
+}
+
+void
+gst_sfx_noise_free (GstSfxNoise * noise)
+{
+  g_free (noise->fixed);
+  noise->fixed = NULL;
+
+  g_free (noise->rows);
+  noise->rows = NULL;
+
+  g_free (noise->columns);
+  noise->columns = NULL;
+}
+
+void
+gst_sfx_noise_set_stream (const GstSfxNoise * noise,
+    GstSfxNoiseStream * stream, guint32 row, guint32 frame,
+    GstSfxNoiseComponent component)
+{
+  stream->key[0] = (guint32) noise->seed;
+  stream->key[1] = (guint32) (noise->seed >> 32);
+  stream->row = row;
+  stream->frame = frame;
+  stream->component = component;
+}
+
+/**
+ * gst_sfx_noise_fill:
+ * @noise: #GstSfxNoise
+ * @dst: output vector
+ * @length: number of elements
+ * @row: row of the noise field
+ * @frame: frame number, or generation of fixed noise
+ * @component: a #GstSfxNoiseComponent
+ * @sigma: standard deviation as a fraction of the 16-bit range
+ *
+ * Fill a vector with noise of one component, or zeros if it is disabled.
+ */
+void
+gst_sfx_noise_fill (const GstSfxNoise * noise, gfloat * dst, gint length,
+    guint32 row, guint32 frame, GstSfxNoiseComponent component, gdouble sigma)
+{
+  GstSfxNoiseStream stream;
+
+  if (sigma <= 0.0) {
+    memset (dst, 0, length * sizeof (gfloat));
+    return;
+  }
+
+  gst_sfx_noise_set_stream (noise, &stream, row, frame, component);
+  noise->normal (dst, length, &stream,
+      (gfloat) (sigma * GST_SFX_NOISE_SIGMA_SCALE));
+}
+
+typedef struct
+{
+  GstSfxNoise *noise;
+  guint32 frame;
+  gdouble sigma_vh;
+
+  const guint8 *src;
+  gint src_stride;
+  guint8 *dst;
+  gint dst_stride;
+  gfloat t;
+  gfloat sigma_tvh;
+} GstSfxNoiseJob;
+
+static void
+gst_sfx_noise_fixed_stripe (gpointer user_data, guint stripe, guint n_stripes)
+{
+  GstSfxNoiseJob *job = (GstSfxNoiseJob *) user_data;
+  GstSfxNoise *noise = job->noise;
+  gint x, y, row_start, row_end;
+
+  gst_stripe_get_rows (stripe, n_stripes, noise->height, &row_start,
+      &row_end);
+
+  for (y = row_start; y < row_end; y++) {
+    gfloat *fixed = noise->fixed + (gsize) y * noise->width;
+
+    gst_sfx_noise_fill (noise, fixed, noise->width, y, job->frame,
+        GST_SFX_NOISE_VH, job->sigma_vh);
+    for (x = 0; x < noise->width; x++)
+      fixed[x] = fixed[x] + noise->columns[x] + noise->rows[y];
+  }
+}
+
+/**
+ * gst_sfx_noise_create_fixed:
+ * @noise: #GstSfxNoise
+ * @generation: which random streams to draw from
+ * @sigma_v: standard deviation of the row noise
+ * @sigma_h: standard deviation of the column noise
+ * @sigma_vh: standard deviation of the pixel noise
+ *
+ * Sum the v, h and vh components, using the tv and th buffers as scratch.
+ * Each regeneration should draw from a new generation.
+ */
+void
+gst_sfx_noise_create_fixed (GstSfxNoise * noise, guint32 generation,
+    gdouble sigma_v, gdouble sigma_h, gdouble sigma_vh)
+{
+  GstSfxNoiseJob job;
+
+  job.noise = noise;
+  job.frame = generation;
+  job.sigma_vh = sigma_vh;
+
+  gst_sfx_noise_fill (noise, noise->rows, noise->height, 0, generation,
+      GST_SFX_NOISE_V, sigma_v);
+  gst_sfx_noise_fill (noise, noise->columns, noise->width, 0, generation,
+      GST_SFX_NOISE_H, sigma_h);
+
+  gst_stripe_pool_run (noise->pool, gst_sfx_noise_fixed_stripe, &job);
+}
+
+static void
+gst_sfx_noise_apply_stripe (gpointer user_data, guint stripe, guint n_stripes)
+{
+  GstSfxNoiseJob *job = (GstSfxNoiseJob *) user_data;
+  GstSfxNoise *noise = job->noise;
+  GstSfxNoiseStream stream;
+  gint y, row_start, row_end;
+
+  gst_stripe_get_rows (stripe, n_stripes, noise->height, &row_start,
+      &row_end);
+
+  for (y = row_start; y < row_end; y++) {
+    const guint16 *src = (const guint16 *) (job->src + y * job->src_stride);
+    guint16 *dst = (guint16 *) (job->dst + y * job->dst_stride);
+    const gfloat *fixed = noise->fixed + (gsize) y * noise->width;
+
+    gst_sfx_noise_set_stream (noise, &stream, y, job->frame,
+        GST_SFX_NOISE_TVH);
+    noise->noise_row (dst, src, fixed, noise->columns, noise->rows[y] +
+        job->t, noise->width, &stream, job->sigma_tvh);
+  }
+}
+
+/**
+ * gst_sfx_noise_apply:
+ * @noise: #GstSfxNoise
+ * @frame: frame number
+ * @src: input frame of 16-bit pixels
+ * @src_stride: bytes between input rows
+ * @dst: output frame, may be @src
+ * @dst_stride: bytes between output rows
+ * @sigma_t: standard deviation of the frame noise
+ * @sigma_tv: standard deviation of the temporal row noise
+ * @sigma_th: standard deviation of the temporal column noise
+ * @sigma_tvh: standard deviation of the spatio-temporal noise
+ *
+ * Add the fixed noise and the four temporal components to a frame in a
+ * single pass, the per-frame t, tv and th components being drawn first as
+ * they are tiny.
+ */
+void
+gst_sfx_noise_apply (GstSfxNoise * noise, guint32 frame, const guint8 * src,
+    gint src_stride, guint8 * dst, gint dst_stride, gdouble sigma_t,
+    gdouble sigma_tv, gdouble sigma_th, gdouble sigma_tvh)
+{
+  GstSfxNoiseJob job;
+
+  job.noise = noise;
+  job.frame = frame;
+  job.src = src;
+  job.src_stride = src_stride;
+  job.dst = dst;
+  job.dst_stride = dst_stride;
+  job.t = 0.0f;
+  job.sigma_tvh = 0.0f;
+
+  gst_sfx_noise_fill (noise, noise->rows, noise->height, 0, frame,
+      GST_SFX_NOISE_TV, sigma_tv);
+  gst_sfx_noise_fill (noise, noise->columns, noise->width, 0, frame,
+      GST_SFX_NOISE_TH, sigma_th);
+  gst_sfx_noise_fill (noise, &job.t, 1, 0, frame, GST_SFX_NOISE_T, sigma_t);
+
+  if (sigma_tvh > 0.0)
+    job.sigma_tvh = (gfloat) (sigma_tvh * GST_SFX_NOISE_SIGMA_SCALE);
+
+  gst_stripe_pool_run (noise->pool, gst_sfx_noise_apply_stripe, &job);
+}
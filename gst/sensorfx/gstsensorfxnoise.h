@@ -0,0 +1,82 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_SENSORFX_NOISE_H__
+#define __GST_SENSORFX_NOISE_H__
+
+#include <glib.h>
+
+#include "gstsensorfxsimd.h"
+#include "stripepool.h"
+
+G_BEGIN_DECLS
+
+/* sigmas are given as a fraction of the 16-bit range */
+#define GST_SFX_NOISE_SIGMA_SCALE (G_MAXUINT16 - 1)
+
+/**
+* GstSfxNoise:
+* @seed: seed of every random stream
+* @width: width of the noise field
+* @height: height of the noise field
+* @normal: kernel filling rows with normal variates
+* @noise_row: kernel adding noise to a row of pixels
+* @pool: threads the rows are split between
+* @fixed: sum of the v, h and vh components of each pixel
+* @rows: tv component of each row of the current frame
+* @columns: th component of each column of the current frame
+*
+* Generates 3D noise and adds it to 16-bit frames, the output depending
+* only on the seed, sigmas and frame number and not on the kernels or the
+* number of threads.
+*/
+typedef struct {
+  guint64 seed;
+  gint width;
+  gint height;
+
+  GstSfxNormalFunc normal;
+  GstSfxNoiseRowFunc noise_row;
+  GstStripePool *pool;
+
+  gfloat *fixed;
+  gfloat *rows;
+  gfloat *columns;
+} GstSfxNoise;
+
+void gst_sfx_noise_init (GstSfxNoise * noise, GstSimdLevel level);
+void gst_sfx_noise_alloc (GstSfxNoise * noise, gint width, gint height);
+void gst_sfx_noise_free (GstSfxNoise * noise);
+
+void gst_sfx_noise_set_stream (const GstSfxNoise * noise,
+    GstSfxNoiseStream * stream, guint32 row, guint32 frame,
+    GstSfxNoiseComponent component);
+void gst_sfx_noise_fill (const GstSfxNoise * noise, gfloat * dst,
+    gint length, guint32 row, guint32 frame, GstSfxNoiseComponent component,
+    gdouble sigma);
+
+void gst_sfx_noise_create_fixed (GstSfxNoise * noise, guint32 generation,
+    gdouble sigma_v, gdouble sigma_h, gdouble sigma_vh);
+void gst_sfx_noise_apply (GstSfxNoise * noise, guint32 frame,
+    const guint8 * src, gint src_stride, guint8 * dst, gint dst_stride,
+    gdouble sigma_t, gdouble sigma_tv, gdouble sigma_th, gdouble sigma_tvh);
+
+G_END_DECLS
+
+#endif /* __GST_SENSORFX_NOISE_H__ */
@@ -0,0 +1,447 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Separable sensor blur for sfxblur, free of GStreamer types so that
+ * sfxblurtest can check its output at every instruction set and thread
+ * count.
+ *
+ * Horizontal stages run row by row on padded scratch rows. Vertical stages
+ * accumulate whole rows so every operation is vectorized along the row, box
+ * sums sliding down the frame and restarting every few rows so that any
+ * stripe of rows can be computed on its own with the same result.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include <math.h>
+
+#include "gstsensorfxpsf.h"
+
+/**
+ * gst_sfx_psf_init:
+ * @psf: #GstSfxPsf
+ * @level: instruction set of the kernels, at most gst_simd_get_level()
+ *
+ * Select the filter kernels, leaving the size, stages and pool to the
+ * caller.
+ */
+void
+gst_sfx_psf_init (GstSfxPsf * psf, GstSimdLevel level)
+{
+  memset (psf, 0, sizeof (GstSfxPsf));
+  psf->level = level;
+  psf->blur_taps = gst_sfx_simd_get_blur_taps_func (level);
+  psf->blur_axpy = gst_sfx_simd_get_blur_axpy_func (level);
+}
+
+/**
+ * gst_sfx_psf_alloc:
+ * @psf: #GstSfxPsf
+ * @width: width of the frames
+ * @height: height of the frames
+ * @sixteen: whether pixels are GRAY16_LE rather than GRAY8
+ *
+ * Select the pixel conversions and allocate the float planes for a frame
+ * size. The stages must be set again afterwards.
+ */
+void
+gst_sfx_psf_alloc (GstSfxPsf * psf, gint width, gint height,
+    gboolean sixteen)
+{
+  gst_sfx_psf_free (psf);
+
+  psf->width = width;
+  psf->height = height;
+  psf->load = gst_sfx_simd_get_blur_load_func (psf->level, sixteen);
+  psf->store = gst_sfx_simd_get_blur_store_func (psf->level, sixteen);
+  psf->planes[0] = g_new (gfloat, (gsize) width * height);
+  psf->planes[1] = g_new (gfloat, (gsize) width * height);
+}
+
+void
+gst_sfx_psf_free (GstSfxPsf * psf)
+{
+  g_free (psf->taps);
+  psf->taps = NULL;
+  psf->n_h_stages = 0;
+  psf->n_v_stages = 0;
+
+  g_free (psf->planes[0]);
+  g_free (psf->planes[1]);
+  psf->planes[0] = NULL;
+  psf->planes[1] = NULL;
+
+  g_free (psf->scratch);
+  psf->scratch = NULL;
+  psf->pad = 0;
+  psf->scratch_stride = 0;
+}
+
+/* Parse a comma-separated kernel into normalized taps, returning the number
+ * of taps or 0 if it isn't valid */
+static gint
+gst_sfx_psf_parse_kernel (const gchar * kernel, gfloat ** taps)
+{
+  gchar **tokens = g_strsplit_set (kernel, ", \t", -1);
+  gdouble *values = g_new (gdouble, g_strv_length (tokens));
+  gdouble sum = 0.0;
+  gint i, n = 0;
+
+  for (i = 0; tokens[i]; i++) {
+    gchar *end;
+
+    if (tokens[i][0] == '\0')
+      continue;
+    values[n] = g_ascii_strtod (tokens[i], &end);
+    if (*end != '\0') {
+      n = 0;
+      break;
+    }
+    sum += values[n++];
+  }
+
+  if (n > 0) {
+    *taps = g_new (gfloat, n);
+    for (i = 0; i < n; i++)
+      (*taps)[i] = (gfloat) (sum != 0.0 ? values[i] / sum : values[i]);
+  }
+
+  g_free (values);
+  g_strfreev (tokens);
+
+  return n;
+}
+
+/* Sampled Gaussian out to three sigma, normalized to unit sum */
+static gint
+gst_sfx_psf_gaussian (gdouble sigma, gfloat ** taps)
+{
+  const gint radius = (gint) ceil (3.0 * sigma);
+  const gint n = 2 * radius + 1;
+  gdouble sum = 0.0;
+  gint i;
+
+  *taps = g_new (gfloat, n);
+  for (i = 0; i < n; i++)
+    sum += exp (-0.5 * (i - radius) * (i - radius) / (sigma * sigma));
+  for (i = 0; i < n; i++)
+    (*taps)[i] = (gfloat) (exp (-0.5 * (i - radius) * (i - radius) /
+            (sigma * sigma)) / sum);
+
+  return n;
+}
+
+/* Widths of three boxes whose convolution has the variance of a Gaussian,
+ * two narrower boxes and one wider by two pixels as needed */
+static void
+gst_sfx_psf_gaussian_boxes (gdouble sigma, gint widths[3])
+{
+  const gdouble ideal = sqrt (12.0 * sigma * sigma / 3 + 1);
+  gint lower = (gint) floor (ideal);
+  gint n_lower, i;
+
+  if (lower % 2 == 0)
+    lower--;
+  n_lower = (gint) floor ((12.0 * sigma * sigma - 3 * lower * lower -
+          12 * lower - 9) / (-4.0 * lower - 4) + 0.5);
+
+  for (i = 0; i < 3; i++)
+    widths[i] = i < n_lower ? lower : lower + 2;
+}
+
+static void
+gst_sfx_psf_add_box (GstSfxPsfStage * stages, guint * n_stages, gint width)
+{
+  stages[*n_stages].taps = NULL;
+  stages[*n_stages].left = (width - 1) / 2;
+  stages[*n_stages].right = width / 2;
+  (*n_stages)++;
+}
+
+/**
+ * gst_sfx_psf_set_stages:
+ * @psf: #GstSfxPsf
+ * @sigma: standard deviation in pixels of the Gaussian optics blur, 0 for
+ *   none
+ * @kernel: comma-separated 1-D optics kernel used instead of the Gaussian,
+ *   or NULL
+ * @detector_width: width in pixels of the detector box
+ * @detector_height: height in pixels of the detector box
+ *
+ * Rebuild the stages of both axes, and the scratch rows, which depend on
+ * the widest stage and the number of threads of the pool.
+ *
+ * Returns: FALSE if @kernel was given but isn't valid, in which case there
+ * is no optics blur
+ */
+gboolean
+gst_sfx_psf_set_stages (GstSfxPsf * psf, gdouble sigma, const gchar * kernel,
+    guint detector_width, guint detector_height)
+{
+  gint n_taps = 0, max_extent = 0;
+  gboolean valid = TRUE;
+  guint i;
+
+  g_free (psf->taps);
+  psf->taps = NULL;
+  psf->n_h_stages = 0;
+  psf->n_v_stages = 0;
+
+  if (kernel && kernel[0] != '\0') {
+    n_taps = gst_sfx_psf_parse_kernel (kernel, &psf->taps);
+    valid = n_taps > 0;
+  } else if (sigma > GST_SFX_PSF_MAX_GAUSSIAN_SIGMA) {
+    gint widths[3];
+
+    gst_sfx_psf_gaussian_boxes (sigma, widths);
+    for (i = 0; i < 3; i++) {
+      gst_sfx_psf_add_box (psf->h_stages, &psf->n_h_stages, widths[i]);
+      gst_sfx_psf_add_box (psf->v_stages, &psf->n_v_stages, widths[i]);
+    }
+  } else if (sigma > 0.0) {
+    n_taps = gst_sfx_psf_gaussian (sigma, &psf->taps);
+  }
+
+  if (n_taps > 1) {
+    GstSfxPsfStage stage;
+
+    stage.taps = psf->taps;
+    stage.left = (n_taps - 1) / 2;
+    stage.right = n_taps / 2;
+    psf->h_stages[psf->n_h_stages++] = stage;
+    psf->v_stages[psf->n_v_stages++] = stage;
+  }
+
+  if (detector_width > 1)
+    gst_sfx_psf_add_box (psf->h_stages, &psf->n_h_stages, detector_width);
+  if (detector_height > 1)
+    gst_sfx_psf_add_box (psf->v_stages, &psf->n_v_stages, detector_height);
+
+  for (i = 0; i < psf->n_h_stages; i++)
+    max_extent = MAX (max_extent, MAX (psf->h_stages[i].left,
+            psf->h_stages[i].right));
+
+  /* box filters read one sample past their window */
+  psf->pad = max_extent + 1;
+  psf->scratch_stride = psf->width + 2 * psf->pad;
+  g_free (psf->scratch);
+  psf->scratch = g_new (gfloat,
+      (gsize) psf->scratch_stride * 2 * psf->pool->n_threads);
+
+  return valid;
+}
+
+typedef struct
+{
+  GstSfxPsf *psf;
+  guint8 *data;
+  gint stride;
+  const GstSfxPsfStage *stage;
+  const gfloat *src;
+  gfloat *dst;
+} GstSfxPsfJob;
+
+/* Sliding-window box filter of a row padded by at least right + 1 */
+static void
+gst_sfx_psf_box_row (gfloat * dst, const gfloat * src, gint left, gint right,
+    gint width)
+{
+  const gdouble scale = 1.0 / (left + right + 1);
+  gdouble sum = 0.0;
+  gint x;
+
+  for (x = -left; x <= right; x++)
+    sum += src[x];
+
+  for (x = 0; x < width; x++) {
+    dst[x] = (gfloat) (sum * scale);
+    sum += src[x + right + 1] - src[x - left];
+  }
+}
+
+/* Run the horizontal stages over rows, writing the first plane, or the
+ * frame itself when there are no vertical stages */
+static void
+gst_sfx_psf_horizontal_stripe (gpointer user_data, guint stripe,
+    guint n_stripes)
+{
+  GstSfxPsfJob *job = (GstSfxPsfJob *) user_data;
+  GstSfxPsf *psf = job->psf;
+  const gint width = psf->width;
+  const gint pad = psf->pad;
+  guint8 *data = job->data;
+  const gint stride = job->stride;
+  gfloat *a = psf->scratch + (gsize) stripe * 2 * psf->scratch_stride;
+  gfloat *b = a + psf->scratch_stride;
+  gint x, y, row_start, row_end;
+  guint s;
+
+  gst_stripe_get_rows (stripe, n_stripes, psf->height, &row_start, &row_end);
+
+  for (y = row_start; y < row_end; y++) {
+    gfloat *row = a;
+    gfloat *out = b;
+
+    psf->load (row + pad, data + y * stride, width);
+
+    for (s = 0; s < psf->n_h_stages; s++) {
+      const GstSfxPsfStage *stage = &psf->h_stages[s];
+      gfloat *tmp;
+
+      /* replicate the edges */
+      for (x = 0; x < pad; x++) {
+        row[x] = row[pad];
+        row[pad + width + x] = row[pad + width - 1];
+      }
+
+      if (stage->taps)
+        psf->blur_taps (out + pad, row + pad - stage->left, stage->taps,
+            stage->left + stage->right + 1, width);
+      else
+        gst_sfx_psf_box_row (out + pad, row + pad, stage->left, stage->right,
+            width);
+
+      tmp = row;
+      row = out;
+      out = tmp;
+    }
+
+    if (psf->n_v_stages > 0)
+      memcpy (psf->planes[0] + (gsize) y * width, row + pad,
+          width * sizeof (gfloat));
+    else
+      psf->store (data + y * stride, row + pad, width);
+  }
+}
+
+static inline const gfloat *
+gst_sfx_psf_plane_row (const GstSfxPsfJob * job, gint y)
+{
+  const gint width = job->psf->width;
+  const gint height = job->psf->height;
+
+  return job->src + (gsize) CLAMP (y, 0, height - 1) * width;
+}
+
+/* Output row y of a vertical stage, to the next plane or the frame */
+static inline gfloat *
+gst_sfx_psf_output_row (const GstSfxPsfJob * job, gfloat * scratch, gint y)
+{
+  const gint width = job->psf->width;
+
+  return job->dst ? job->dst + (gsize) y * width : scratch;
+}
+
+static inline void
+gst_sfx_psf_finish_row (const GstSfxPsfJob * job, const gfloat * row, gint y)
+{
+  if (!job->dst)
+    job->psf->store (job->data + y * job->stride, row, job->psf->width);
+}
+
+/* Run one vertical stage, accumulating whole rows so every operation is
+ * vectorized along the row */
+static void
+gst_sfx_psf_vertical_stripe (gpointer user_data, guint stripe,
+    guint n_stripes)
+{
+  GstSfxPsfJob *job = (GstSfxPsfJob *) user_data;
+  GstSfxPsf *psf = job->psf;
+  const GstSfxPsfStage *stage = job->stage;
+  const gint width = psf->width;
+  gfloat *sum = psf->scratch + (gsize) stripe * 2 * psf->scratch_stride;
+  gfloat *scratch = sum + psf->scratch_stride;
+  gint i, y, row_start, row_end;
+
+  gst_stripe_get_rows (stripe, n_stripes, psf->height, &row_start, &row_end);
+
+  if (stage->taps) {
+    for (y = row_start; y < row_end; y++) {
+      gfloat *out = gst_sfx_psf_output_row (job, scratch, y);
+
+      memset (out, 0, width * sizeof (gfloat));
+      for (i = -stage->left; i <= stage->right; i++)
+        psf->blur_axpy (out, gst_sfx_psf_plane_row (job, y + i),
+            stage->taps[i + stage->left], width);
+      gst_sfx_psf_finish_row (job, out, y);
+    }
+  } else {
+    const gfloat scale = 1.0f / (stage->left + stage->right + 1);
+
+    /* start from the restart row at or above the stripe */
+    for (y = row_start - row_start % GST_SFX_PSF_BOX_RESTART_ROWS;
+        y < row_end; y++) {
+      if (y % GST_SFX_PSF_BOX_RESTART_ROWS == 0) {
+        memset (sum, 0, width * sizeof (gfloat));
+        for (i = -stage->left; i <= stage->right; i++)
+          psf->blur_axpy (sum, gst_sfx_psf_plane_row (job, y + i), 1.0f,
+              width);
+      } else {
+        psf->blur_axpy (sum, gst_sfx_psf_plane_row (job, y + stage->right),
+            1.0f, width);
+        psf->blur_axpy (sum, gst_sfx_psf_plane_row (job,
+                y - stage->left - 1), -1.0f, width);
+      }
+
+      if (y >= row_start) {
+        gfloat *out = gst_sfx_psf_output_row (job, scratch, y);
+
+        memset (out, 0, width * sizeof (gfloat));
+        psf->blur_axpy (out, sum, scale, width);
+        gst_sfx_psf_finish_row (job, out, y);
+      }
+    }
+  }
+}
+
+/**
+ * gst_sfx_psf_apply:
+ * @psf: #GstSfxPsf
+ * @data: frame of GRAY8 or GRAY16_LE pixels, blurred in place
+ * @stride: bytes between rows
+ *
+ * Run the horizontal stages and then each vertical stage over the frame,
+ * the rows of every pass split between the threads of the pool.
+ */
+void
+gst_sfx_psf_apply (GstSfxPsf * psf, guint8 * data, gint stride)
+{
+  GstSfxPsfJob job;
+  guint s;
+
+  if (psf->n_h_stages == 0 && psf->n_v_stages == 0)
+    return;
+
+  job.psf = psf;
+  job.data = data;
+  job.stride = stride;
+  gst_stripe_pool_run (psf->pool, gst_sfx_psf_horizontal_stripe, &job);
+
+  /* every vertical stage needs all rows of the previous one */
+  for (s = 0; s < psf->n_v_stages; s++) {
+    job.stage = &psf->v_stages[s];
+    job.src = psf->planes[s % 2];
+    job.dst = s + 1 < psf->n_v_stages ? psf->planes[(s + 1) % 2] : NULL;
+    gst_stripe_pool_run (psf->pool, gst_sfx_psf_vertical_stripe, &job);
+  }
+}
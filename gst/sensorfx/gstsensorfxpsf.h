@@ -0,0 +1,112 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_SENSORFX_PSF_H__
+#define __GST_SENSORFX_PSF_H__
+
+#include <glib.h>
+
+#include "gstsensorfxsimd.h"
+#include "stripepool.h"
+
+G_BEGIN_DECLS
+
+/* optics as one FIR or three boxes, then the detector box */
+#define GST_SFX_PSF_MAX_STAGES 4
+
+/* Gaussians wider than this are approximated by three boxes */
+#define GST_SFX_PSF_MAX_GAUSSIAN_SIGMA 4.0
+
+/* vertical box sums restart on rows that are multiples of this, bounding
+ * rounding drift and keeping the output independent of the stripes */
+#define GST_SFX_PSF_BOX_RESTART_ROWS 32
+
+/**
+* GstSfxPsfStage:
+* @taps: FIR coefficients, or NULL for a box filter
+* @left: samples before the center
+* @right: samples after the center
+*
+* One 1-D filter applied along rows or columns.
+*/
+typedef struct {
+  const gfloat *taps;
+  gint left;
+  gint right;
+} GstSfxPsfStage;
+
+/**
+* GstSfxPsf:
+* @level: instruction set of the kernels
+* @width: width of the frames
+* @height: height of the frames
+* @blur_taps: FIR kernel
+* @blur_axpy: row accumulation kernel
+* @load: pixel to float conversion
+* @store: float to pixel conversion
+* @pool: threads the rows are split between
+* @taps: coefficients of the FIR stage
+* @h_stages: stages along rows
+* @n_h_stages: number of stages along rows
+* @v_stages: stages along columns
+* @n_v_stages: number of stages along columns
+* @planes: float frames the vertical stages ping-pong between
+* @scratch: two rows of scratch per stripe
+* @pad: samples replicated on both sides of each scratch row
+* @scratch_stride: floats between scratch rows
+*
+* Blurs 8- or 16-bit frames in place like a sensor, the output depending
+* only on the stages and not on the kernels or the number of threads.
+*/
+typedef struct {
+  GstSimdLevel level;
+  gint width;
+  gint height;
+
+  GstSfxBlurTapsFunc blur_taps;
+  GstSfxBlurAxpyFunc blur_axpy;
+  GstSfxBlurLoadFunc load;
+  GstSfxBlurStoreFunc store;
+  GstStripePool *pool;
+
+  gfloat *taps;
+  GstSfxPsfStage h_stages[GST_SFX_PSF_MAX_STAGES];
+  guint n_h_stages;
+  GstSfxPsfStage v_stages[GST_SFX_PSF_MAX_STAGES];
+  guint n_v_stages;
+
+  gfloat *planes[2];
+  gfloat *scratch;
+  gint pad;
+  gint scratch_stride;
+} GstSfxPsf;
+
+void gst_sfx_psf_init (GstSfxPsf * psf, GstSimdLevel level);
+void gst_sfx_psf_alloc (GstSfxPsf * psf, gint width, gint height,
+    gboolean sixteen);
+void gst_sfx_psf_free (GstSfxPsf * psf);
+
+gboolean gst_sfx_psf_set_stages (GstSfxPsf * psf, gdouble sigma,
+    const gchar * kernel, guint detector_width, guint detector_height);
+void gst_sfx_psf_apply (GstSfxPsf * psf, guint8 * data, gint stride);
+
+G_END_DECLS
+
+#endif /* __GST_SENSORFX_PSF_H__ */
@@ -0,0 +1,1140 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Vectorized noise and blur kernels for the sensorfx elements.
+ *
+ * Random numbers come from Philox4x32-10, a counter-based generator: each
+ * 128-bit counter is hashed with the key into four independent 32-bit
+ * words, with no state carried between calls. Lanes of a vector simply hold
+ * consecutive counters, and any row of a noise field can be produced on its
+ * own, in any order, by any thread.
+ *
+ * Each pair of words becomes two normal variates by the Box-Muller
+ * transform. Its logarithm, sine and cosine are short polynomials built
+ * only from multiplies and adds, evaluated in the same order by the scalar
+ * and vector kernels, so every kernel produces bit-identical noise. The
+ * angle is reduced to a quarter turn with integer arithmetic on the random
+ * bits, which is exact.
+ *
+ * The row kernel adds all noise components and the spatio-temporal variates
+ * to 16-bit pixels in one pass, rounding to nearest even and saturating
+ * like cvConvert.
+ *
+ * The blur kernels work on float rows: a horizontal FIR over a padded row,
+ * a weighted row accumulation that vertical FIR and box passes are built
+ * from, and conversions from and to 8- and 16-bit pixels. They also keep
+ * the scalar operation order, so the blur is the same at every level.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstsensorfxsimd.h"
+
+#include <math.h>
+
+/* fused multiply-adds would round differently in each kernel */
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+/* 24 random bits scaled to [0, 1) */
+#define INV_2_24 5.9604644775390625e-8f
+/* a quarter turn in units of 2^-22 of a turn */
+#define ANGLE_SCALE 3.7450702e-7f
+
+/* cephes logf */
+#define LOG_SQRTHF 0.707106781186547524f
+#define LOG_P0 7.0376836292e-2f
+#define LOG_P1 -1.1514610310e-1f
+#define LOG_P2 1.1676998740e-1f
+#define LOG_P3 -1.2420140846e-1f
+#define LOG_P4 1.4249322787e-1f
+#define LOG_P5 -1.6668057665e-1f
+#define LOG_P6 2.0000714765e-1f
+#define LOG_P7 -2.4999993993e-1f
+#define LOG_P8 3.3333331174e-1f
+#define LOG_Q1 -2.12194440e-4f
+#define LOG_Q2 0.693359375f
+
+/* cephes sinf and cosf on [-pi/4, pi/4] */
+#define SIN_P0 -1.9515295891e-4f
+#define SIN_P1 8.3321608736e-3f
+#define SIN_P2 -1.6666654611e-1f
+#define COS_P0 2.443315711809948e-5f
+#define COS_P1 -1.388731625493765e-3f
+#define COS_P2 4.166664568298827e-2f
+
+/* adding and subtracting 1.5 * 2^23 rounds to nearest even */
+#define ROUND_MAGIC 12582912.0f
+
+typedef union
+{
+  gfloat f;
+  guint32 i;
+} FloatBits;
+
+static inline void
+philox_scalar (guint32 ctr[4], const guint32 key[2])
+{
+  guint32 k0 = key[0], k1 = key[1];
+  gint i;
+
+  for (i = 0; i < PHILOX_ROUNDS; i++) {
+    const guint64 p0 = (guint64) PHILOX_M0 * ctr[0];
+    const guint64 p1 = (guint64) PHILOX_M1 * ctr[2];
+
+    ctr[0] = (guint32) (p1 >> 32) ^ ctr[1] ^ k0;
+    ctr[1] = (guint32) p1;
+    ctr[2] = (guint32) (p0 >> 32) ^ ctr[3] ^ k1;
+    ctr[3] = (guint32) p0;
+    k0 += PHILOX_W0;
+    k1 += PHILOX_W1;
+  }
+}
+
+/* natural logarithm of a positive normal float */
+static inline gfloat
+log_scalar (gfloat v)
+{
+  FloatBits bits;
+  gfloat e, m, x, y, z;
+
+  bits.f = v;
+  e = (gfloat) ((gint) (bits.i >> 23) - 126);
+  bits.i = (bits.i & 0x007fffff) | 0x3f000000;
+  m = bits.f;
+
+  x = m - 1.0f;
+  if (m < LOG_SQRTHF) {
+    e = e - 1.0f;
+    x = x + m;
+  }
+
+  z = x * x;
+  y = LOG_P0;
+  y = y * x + LOG_P1;
+  y = y * x + LOG_P2;
+  y = y * x + LOG_P3;
+  y = y * x + LOG_P4;
+  y = y * x + LOG_P5;
+  y = y * x + LOG_P6;
+  y = y * x + LOG_P7;
+  y = y * x + LOG_P8;
+  y = y * x;
+  y = y * z;
+  y = y + e * LOG_Q1;
+  y = y + z * -0.5f;
+  x = x + y;
+  return x + e * LOG_Q2;
+}
+
+/* two normal variates from two random words */
+static inline void
+box_muller_scalar (gfloat out[2], guint32 radius_bits, guint32 angle_bits)
+{
+  const gfloat u = (gfloat) ((gint) (radius_bits >> 8) + 1) * INV_2_24;
+  const gfloat radius = sqrtf (-2.0f * log_scalar (u));
+  const gint k = (gint) (angle_bits >> 8);
+  const gint q = (k + (1 << 21)) >> 22;
+  const gfloat a = (gfloat) (k - (q << 22)) * ANGLE_SCALE;
+  const gfloat z = a * a;
+  gfloat s, c, cos_t, sin_t;
+
+  s = SIN_P0;
+  s = s * z + SIN_P1;
+  s = s * z + SIN_P2;
+  s = s * z;
+  s = s * a;
+  s = s + a;
+
+  c = COS_P0;
+  c = c * z + COS_P1;
+  c = c * z + COS_P2;
+  c = c * z;
+  c = c * z;
+  c = c - z * 0.5f;
+  c = c + 1.0f;
+
+  /* rotate by q quarter turns */
+  cos_t = (q & 1) ? s : c;
+  sin_t = (q & 1) ? c : s;
+  if ((q + 1) & 2)
+    cos_t = -cos_t;
+  if (q & 2)
+    sin_t = -sin_t;
+
+  out[0] = radius * cos_t;
+  out[1] = radius * sin_t;
+}
+
+/* the four variates of one counter */
+static inline void
+normals_scalar (gfloat out[4], guint32 block, const GstSfxNoiseStream * stream)
+{
+  guint32 ctr[4];
+
+  ctr[0] = block;
+  ctr[1] = stream->row;
+  ctr[2] = stream->frame;
+  ctr[3] = stream->component;
+  philox_scalar (ctr, stream->key);
+
+  box_muller_scalar (out, ctr[0], ctr[1]);
+  box_muller_scalar (out + 2, ctr[2], ctr[3]);
+}
+
+static inline guint16
+saturate_round (gfloat v, gfloat max)
+{
+  v = CLAMP (v, 0.0f, max);
+  return (guint16) ((v + ROUND_MAGIC) - ROUND_MAGIC);
+}
+
+/* x must be a multiple of four, as are the vector loops */
+static inline void
+normal_scalar_from (gfloat * dst, gint x, gint width,
+    const GstSfxNoiseStream * stream, gfloat sigma)
+{
+  for (; x < width; x += 4) {
+    gfloat n[4];
+    gint i;
+
+    normals_scalar (n, x / 4, stream);
+    for (i = 0; i < 4 && x + i < width; i++)
+      dst[x + i] = n[i] * sigma;
+  }
+}
+
+static inline void
+noise_row_scalar_from (guint16 * dst, const guint16 * src,
+    const gfloat * fixed, const gfloat * columns, gfloat row, gint x,
+    gint width, const GstSfxNoiseStream * stream, gfloat sigma)
+{
+  const gboolean random = sigma != 0.0f;
+
+  for (; x < width; x += 4) {
+    gfloat n[4];
+    gint i;
+
+    if (random)
+      normals_scalar (n, x / 4, stream);
+
+    for (i = 0; i < 4 && x + i < width; i++) {
+      gfloat v = (gfloat) src[x + i] + fixed[x + i];
+      v = v + columns[x + i];
+      v = v + row;
+      if (random)
+        v = v + n[i] * sigma;
+      dst[x + i] = saturate_round (v, 65535.0f);
+    }
+  }
+}
+
+static void
+normal_scalar (gfloat * dst, gint width, const GstSfxNoiseStream * stream,
+    gfloat sigma)
+{
+  normal_scalar_from (dst, 0, width, stream, sigma);
+}
+
+static void
+noise_row_scalar (guint16 * dst, const guint16 * src, const gfloat * fixed,
+    const gfloat * columns, gfloat row, gint width,
+    const GstSfxNoiseStream * stream, gfloat sigma)
+{
+  noise_row_scalar_from (dst, src, fixed, columns, row, 0, width, stream,
+      sigma);
+}
+
+static inline void
+blur_taps_scalar_from (gfloat * dst, const gfloat * src, const gfloat * taps,
+    gint n_taps, gint x, gint width)
+{
+  gint i;
+
+  for (; x < width; x++) {
+    gfloat acc = 0.0f;
+    for (i = 0; i < n_taps; i++)
+      acc = acc + taps[i] * src[x + i];
+    dst[x] = acc;
+  }
+}
+
+static inline void
+blur_axpy_scalar_from (gfloat * dst, const gfloat * src, gfloat weight, gint x,
+    gint width)
+{
+  for (; x < width; x++)
+    dst[x] = dst[x] + weight * src[x];
+}
+
+static void
+blur_taps_scalar (gfloat * dst, const gfloat * src, const gfloat * taps,
+    gint n_taps, gint width)
+{
+  blur_taps_scalar_from (dst, src, taps, n_taps, 0, width);
+}
+
+static void
+blur_axpy_scalar (gfloat * dst, const gfloat * src, gfloat weight,
+    gint width)
+{
+  blur_axpy_scalar_from (dst, src, weight, 0, width);
+}
+
+static void
+blur_load8_scalar (gfloat * dst, const guint8 * src, gint width)
+{
+  gint x;
+
+  for (x = 0; x < width; x++)
+    dst[x] = (gfloat) src[x];
+}
+
+static void
+blur_load16_scalar (gfloat * dst, const guint8 * src, gint width)
+{
+  const guint16 *src16 = (const guint16 *) src;
+  gint x;
+
+  for (x = 0; x < width; x++)
+    dst[x] = (gfloat) src16[x];
+}
+
+static void
+blur_store8_scalar (guint8 * dst, const gfloat * src, gint width)
+{
+  gint x;
+
+  for (x = 0; x < width; x++)
+    dst[x] = (guint8) saturate_round (src[x], 255.0f);
+}
+
+static void
+blur_store16_scalar (guint8 * dst, const gfloat * src, gint width)
+{
+  guint16 *dst16 = (guint16 *) dst;
+  gint x;
+
+  for (x = 0; x < width; x++)
+    dst16[x] = saturate_round (src[x], 65535.0f);
+}
+
+#ifdef HAVE_X86_SIMD
+
+/* 32x32 -> 64-bit multiply of every lane, split into high and low words */
+TARGET_SSE41 static inline void
+mulhilo_sse41 (__m128i a, __m128i m, __m128i * hi, __m128i * lo)
+{
+  const __m128i even = _mm_mul_epu32 (a, m);
+  const __m128i odd = _mm_mul_epu32 (_mm_srli_epi64 (a, 32), m);
+
+  *hi = _mm_blend_epi16 (_mm_srli_epi64 (even, 32), odd, 0xcc);
+  *lo = _mm_blend_epi16 (even, _mm_slli_epi64 (odd, 32), 0xcc);
+}
+
+TARGET_SSE41 static inline void
+philox_sse41 (__m128i ctr[4], const guint32 key[2])
+{
+  const __m128i m0 = _mm_set1_epi32 ((gint) PHILOX_M0);
+  const __m128i m1 = _mm_set1_epi32 ((gint) PHILOX_M1);
+  const __m128i w0 = _mm_set1_epi32 ((gint) PHILOX_W0);
+  const __m128i w1 = _mm_set1_epi32 ((gint) PHILOX_W1);
+  __m128i k0 = _mm_set1_epi32 ((gint) key[0]);
+  __m128i k1 = _mm_set1_epi32 ((gint) key[1]);
+  gint i;
+
+  for (i = 0; i < PHILOX_ROUNDS; i++) {
+    __m128i hi0, lo0, hi1, lo1;
+
+    mulhilo_sse41 (ctr[0], m0, &hi0, &lo0);
+    mulhilo_sse41 (ctr[2], m1, &hi1, &lo1);
+    ctr[0] = _mm_xor_si128 (_mm_xor_si128 (hi1, ctr[1]), k0);
+    ctr[1] = lo1;
+    ctr[2] = _mm_xor_si128 (_mm_xor_si128 (hi0, ctr[3]), k1);
+    ctr[3] = lo0;
+    k0 = _mm_add_epi32 (k0, w0);
+    k1 = _mm_add_epi32 (k1, w1);
+  }
+}
+
+TARGET_SSE41 static inline __m128
+log_sse41 (__m128 v)
+{
+  const __m128 one = _mm_set1_ps (1.0f);
+  const __m128i bits = _mm_castps_si128 (v);
+  __m128 e, m, x, y, z, mask;
+
+  e = _mm_cvtepi32_ps (_mm_sub_epi32 (_mm_srli_epi32 (bits, 23),
+          _mm_set1_epi32 (126)));
+  m = _mm_castsi128_ps (_mm_or_si128 (_mm_and_si128 (bits,
+              _mm_set1_epi32 (0x007fffff)), _mm_set1_epi32 (0x3f000000)));
+
+  mask = _mm_cmplt_ps (m, _mm_set1_ps (LOG_SQRTHF));
+  x = _mm_sub_ps (m, one);
+  e = _mm_sub_ps (e, _mm_and_ps (mask, one));
+  x = _mm_add_ps (x, _mm_and_ps (mask, m));
+
+  z = _mm_mul_ps (x, x);
+  y = _mm_set1_ps (LOG_P0);
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P1));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P2));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P3));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P4));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P5));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P6));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P7));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (LOG_P8));
+  y = _mm_mul_ps (y, x);
+  y = _mm_mul_ps (y, z);
+  y = _mm_add_ps (y, _mm_mul_ps (e, _mm_set1_ps (LOG_Q1)));
+  y = _mm_add_ps (y, _mm_mul_ps (z, _mm_set1_ps (-0.5f)));
+  x = _mm_add_ps (x, y);
+  return _mm_add_ps (x, _mm_mul_ps (e, _mm_set1_ps (LOG_Q2)));
+}
+
+TARGET_SSE41 static inline void
+box_muller_sse41 (__m128 * out0, __m128 * out1, __m128i radius_bits,
+    __m128i angle_bits)
+{
+  const __m128i k = _mm_srli_epi32 (angle_bits, 8);
+  const __m128i q = _mm_srai_epi32 (_mm_add_epi32 (k,
+          _mm_set1_epi32 (1 << 21)), 22);
+  const __m128 u = _mm_mul_ps (_mm_cvtepi32_ps (_mm_add_epi32
+          (_mm_srli_epi32 (radius_bits, 8), _mm_set1_epi32 (1))),
+      _mm_set1_ps (INV_2_24));
+  const __m128 radius = _mm_sqrt_ps (_mm_mul_ps (_mm_set1_ps (-2.0f),
+          log_sse41 (u)));
+  const __m128 a = _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (k,
+              _mm_slli_epi32 (q, 22))), _mm_set1_ps (ANGLE_SCALE));
+  const __m128 z = _mm_mul_ps (a, a);
+  const __m128i two = _mm_set1_epi32 (2);
+  __m128 s, c, swap, cos_t, sin_t;
+
+  s = _mm_set1_ps (SIN_P0);
+  s = _mm_add_ps (_mm_mul_ps (s, z), _mm_set1_ps (SIN_P1));
+  s = _mm_add_ps (_mm_mul_ps (s, z), _mm_set1_ps (SIN_P2));
+  s = _mm_mul_ps (s, z);
+  s = _mm_mul_ps (s, a);
+  s = _mm_add_ps (s, a);
+
+  c = _mm_set1_ps (COS_P0);
+  c = _mm_add_ps (_mm_mul_ps (c, z), _mm_set1_ps (COS_P1));
+  c = _mm_add_ps (_mm_mul_ps (c, z), _mm_set1_ps (COS_P2));
+  c = _mm_mul_ps (c, z);
+  c = _mm_mul_ps (c, z);
+  c = _mm_sub_ps (c, _mm_mul_ps (z, _mm_set1_ps (0.5f)));
+  c = _mm_add_ps (c, _mm_set1_ps (1.0f));
+
+  /* rotate by q quarter turns, flipping signs through the sign bit */
+  swap = _mm_castsi128_ps (_mm_cmpeq_epi32 (_mm_and_si128 (q,
+              _mm_set1_epi32 (1)), _mm_set1_epi32 (1)));
+  cos_t = _mm_blendv_ps (c, s, swap);
+  sin_t = _mm_blendv_ps (s, c, swap);
+  cos_t = _mm_xor_ps (cos_t, _mm_castsi128_ps (_mm_slli_epi32 (_mm_and_si128
+              (_mm_add_epi32 (q, _mm_set1_epi32 (1)), two), 30)));
+  sin_t = _mm_xor_ps (sin_t, _mm_castsi128_ps (_mm_slli_epi32 (_mm_and_si128
+              (q, two), 30)));
+
+  *out0 = _mm_mul_ps (radius, cos_t);
+  *out1 = _mm_mul_ps (radius, sin_t);
+}
+
+/* the variates of four consecutive counters, in element order */
+TARGET_SSE41 static inline void
+normals_sse41 (__m128 out[4], guint32 block,
+    const GstSfxNoiseStream * stream)
+{
+  __m128i ctr[4];
+
+  ctr[0] = _mm_add_epi32 (_mm_set1_epi32 ((gint) block),
+      _mm_setr_epi32 (0, 1, 2, 3));
+  ctr[1] = _mm_set1_epi32 ((gint) stream->row);
+  ctr[2] = _mm_set1_epi32 ((gint) stream->frame);
+  ctr[3] = _mm_set1_epi32 ((gint) stream->component);
+  philox_sse41 (ctr, stream->key);
+
+  box_muller_sse41 (&out[0], &out[1], ctr[0], ctr[1]);
+  box_muller_sse41 (&out[2], &out[3], ctr[2], ctr[3]);
+  _MM_TRANSPOSE4_PS (out[0], out[1], out[2], out[3]);
+}
+
+TARGET_SSE41 static void
+normal_sse41 (gfloat * dst, gint width, const GstSfxNoiseStream * stream,
+    gfloat sigma)
+{
+  const __m128 sigmav = _mm_set1_ps (sigma);
+  gint x, i;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    __m128 n[4];
+
+    normals_sse41 (n, x / 4, stream);
+    for (i = 0; i < 4; i++)
+      _mm_storeu_ps (dst + x + 4 * i, _mm_mul_ps (n[i], sigmav));
+  }
+
+  normal_scalar_from (dst, x, width, stream, sigma);
+}
+
+/* four pixels of a row with everything but the random variates added */
+TARGET_SSE41 static inline __m128
+noise_sum_sse41 (const guint16 * src, const gfloat * fixed,
+    const gfloat * columns, __m128 row)
+{
+  __m128 v = _mm_cvtepi32_ps (_mm_cvtepu16_epi32 (_mm_loadl_epi64 ((const
+                  __m128i *) src)));
+
+  v = _mm_add_ps (v, _mm_loadu_ps (fixed));
+  v = _mm_add_ps (v, _mm_loadu_ps (columns));
+  return _mm_add_ps (v, row);
+}
+
+TARGET_SSE41 static inline __m128i
+saturate_round_sse41 (__m128 v)
+{
+  v = _mm_min_ps (_mm_max_ps (v, _mm_setzero_ps ()), _mm_set1_ps (65535.0f));
+  return _mm_cvtps_epi32 (v);
+}
+
+TARGET_SSE41 static void
+noise_row_sse41 (guint16 * dst, const guint16 * src, const gfloat * fixed,
+    const gfloat * columns, gfloat row, gint width,
+    const GstSfxNoiseStream * stream, gfloat sigma)
+{
+  const __m128 rowv = _mm_set1_ps (row);
+  const __m128 sigmav = _mm_set1_ps (sigma);
+  const gboolean random = sigma != 0.0f;
+  gint x, i;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    __m128 n[4];
+    __m128i out[4];
+
+    if (random)
+      normals_sse41 (n, x / 4, stream);
+
+    for (i = 0; i < 4; i++) {
+      const gint xi = x + 4 * i;
+      __m128 v = noise_sum_sse41 (src + xi, fixed + xi, columns + xi, rowv);
+      if (random)
+        v = _mm_add_ps (v, _mm_mul_ps (n[i], sigmav));
+      out[i] = saturate_round_sse41 (v);
+    }
+
+    _mm_storeu_si128 ((__m128i *) (dst + x), _mm_packus_epi32 (out[0],
+            out[1]));
+    _mm_storeu_si128 ((__m128i *) (dst + x + 8), _mm_packus_epi32 (out[2],
+            out[3]));
+  }
+
+  noise_row_scalar_from (dst, src, fixed, columns, row, x, width, stream,
+      sigma);
+}
+
+TARGET_SSE41 static void
+blur_taps_sse41 (gfloat * dst, const gfloat * src, const gfloat * taps,
+    gint n_taps, gint width)
+{
+  gint x, i;
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    __m128 acc0 = _mm_setzero_ps ();
+    __m128 acc1 = _mm_setzero_ps ();
+
+    for (i = 0; i < n_taps; i++) {
+      const __m128 tap = _mm_set1_ps (taps[i]);
+      acc0 = _mm_add_ps (acc0, _mm_mul_ps (tap, _mm_loadu_ps (src + x + i)));
+      acc1 = _mm_add_ps (acc1, _mm_mul_ps (tap, _mm_loadu_ps (src + x + i +
+                  4)));
+    }
+    _mm_storeu_ps (dst + x, acc0);
+    _mm_storeu_ps (dst + x + 4, acc1);
+  }
+
+  blur_taps_scalar_from (dst, src, taps, n_taps, x, width);
+}
+
+TARGET_SSE41 static void
+blur_axpy_sse41 (gfloat * dst, const gfloat * src, gfloat weight, gint width)
+{
+  const __m128 w = _mm_set1_ps (weight);
+  gint x;
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    _mm_storeu_ps (dst + x, _mm_add_ps (_mm_loadu_ps (dst + x),
+            _mm_mul_ps (w, _mm_loadu_ps (src + x))));
+    _mm_storeu_ps (dst + x + 4, _mm_add_ps (_mm_loadu_ps (dst + x + 4),
+            _mm_mul_ps (w, _mm_loadu_ps (src + x + 4))));
+  }
+
+  blur_axpy_scalar_from (dst, src, weight, x, width);
+}
+
+TARGET_SSE41 static void
+blur_load8_sse41 (gfloat * dst, const guint8 * src, gint width)
+{
+  gint x;
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    const __m128i v = _mm_loadl_epi64 ((const __m128i *) (src + x));
+    _mm_storeu_ps (dst + x, _mm_cvtepi32_ps (_mm_cvtepu8_epi32 (v)));
+    _mm_storeu_ps (dst + x + 4, _mm_cvtepi32_ps (_mm_cvtepu8_epi32
+            (_mm_srli_si128 (v, 4))));
+  }
+
+  for (; x < width; x++)
+    dst[x] = (gfloat) src[x];
+}
+
+TARGET_SSE41 static void
+blur_load16_sse41 (gfloat * dst, const guint8 * src, gint width)
+{
+  const guint16 *src16 = (const guint16 *) src;
+  gint x;
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    const __m128i v = _mm_loadu_si128 ((const __m128i *) (src16 + x));
+    _mm_storeu_ps (dst + x, _mm_cvtepi32_ps (_mm_cvtepu16_epi32 (v)));
+    _mm_storeu_ps (dst + x + 4, _mm_cvtepi32_ps (_mm_cvtepu16_epi32
+            (_mm_srli_si128 (v, 8))));
+  }
+
+  for (; x < width; x++)
+    dst[x] = (gfloat) src16[x];
+}
+
+TARGET_SSE41 static inline __m128i
+blur_round_sse41 (const gfloat * src, __m128 max)
+{
+  return _mm_cvtps_epi32 (_mm_min_ps (_mm_max_ps (_mm_loadu_ps (src),
+              _mm_setzero_ps ()), max));
+}
+
+TARGET_SSE41 static void
+blur_store8_sse41 (guint8 * dst, const gfloat * src, gint width)
+{
+  const __m128 max = _mm_set1_ps (255.0f);
+  gint x;
+
+  for (x = 0; x + 8 <= width; x += 8) {
+    const __m128i v = _mm_packus_epi32 (blur_round_sse41 (src + x, max),
+        blur_round_sse41 (src + x + 4, max));
+    _mm_storel_epi64 ((__m128i *) (dst + x), _mm_packus_epi16 (v, v));
+  }
+
+  for (; x < width; x++)
+    dst[x] = (guint8) saturate_round (src[x], 255.0f);
+}
+
+TARGET_SSE41 static void
+blur_store16_sse41 (guint8 * dst, const gfloat * src, gint width)
+{
+  const __m128 max = _mm_set1_ps (65535.0f);
+  guint16 *dst16 = (guint16 *) dst;
+  gint x;
+
+  for (x = 0; x + 8 <= width; x += 8)
+    _mm_storeu_si128 ((__m128i *) (dst16 + x),
+        _mm_packus_epi32 (blur_round_sse41 (src + x, max),
+            blur_round_sse41 (src + x + 4, max)));
+
+  for (; x < width; x++)
+    dst16[x] = saturate_round (src[x], 65535.0f);
+}
+
+TARGET_AVX2 static inline void
+mulhilo_avx2 (__m256i a, __m256i m, __m256i * hi, __m256i * lo)
+{
+  const __m256i even = _mm256_mul_epu32 (a, m);
+  const __m256i odd = _mm256_mul_epu32 (_mm256_srli_epi64 (a, 32), m);
+
+  *hi = _mm256_blend_epi32 (_mm256_srli_epi64 (even, 32), odd, 0xaa);
+  *lo = _mm256_blend_epi32 (even, _mm256_slli_epi64 (odd, 32), 0xaa);
+}
+
+TARGET_AVX2 static inline void
+philox_avx2 (__m256i ctr[4], const guint32 key[2])
+{
+  const __m256i m0 = _mm256_set1_epi32 ((gint) PHILOX_M0);
+  const __m256i m1 = _mm256_set1_epi32 ((gint) PHILOX_M1);
+  const __m256i w0 = _mm256_set1_epi32 ((gint) PHILOX_W0);
+  const __m256i w1 = _mm256_set1_epi32 ((gint) PHILOX_W1);
+  __m256i k0 = _mm256_set1_epi32 ((gint) key[0]);
+  __m256i k1 = _mm256_set1_epi32 ((gint) key[1]);
+  gint i;
+
+  for (i = 0; i < PHILOX_ROUNDS; i++) {
+    __m256i hi0, lo0, hi1, lo1;
+
+    mulhilo_avx2 (ctr[0], m0, &hi0, &lo0);
+    mulhilo_avx2 (ctr[2], m1, &hi1, &lo1);
+    ctr[0] = _mm256_xor_si256 (_mm256_xor_si256 (hi1, ctr[1]), k0);
+    ctr[1] = lo1;
+    ctr[2] = _mm256_xor_si256 (_mm256_xor_si256 (hi0, ctr[3]), k1);
+    ctr[3] = lo0;
+    k0 = _mm256_add_epi32 (k0, w0);
+    k1 = _mm256_add_epi32 (k1, w1);
+  }
+}
+
+TARGET_AVX2 static inline __m256
+log_avx2 (__m256 v)
+{
+  const __m256 one = _mm256_set1_ps (1.0f);
+  const __m256i bits = _mm256_castps_si256 (v);
+  __m256 e, m, x, y, z, mask;
+
+  e = _mm256_cvtepi32_ps (_mm256_sub_epi32 (_mm256_srli_epi32 (bits, 23),
+          _mm256_set1_epi32 (126)));
+  m = _mm256_castsi256_ps (_mm256_or_si256 (_mm256_and_si256 (bits,
+              _mm256_set1_epi32 (0x007fffff)),
+          _mm256_set1_epi32 (0x3f000000)));
+
+  mask = _mm256_cmp_ps (m, _mm256_set1_ps (LOG_SQRTHF), _CMP_LT_OQ);
+  x = _mm256_sub_ps (m, one);
+  e = _mm256_sub_ps (e, _mm256_and_ps (mask, one));
+  x = _mm256_add_ps (x, _mm256_and_ps (mask, m));
+
+  z = _mm256_mul_ps (x, x);
+  y = _mm256_set1_ps (LOG_P0);
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P1));
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P2));
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P3));
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P4));
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P5));
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P6));
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P7));
+  y = _mm256_add_ps (_mm256_mul_ps (y, x), _mm256_set1_ps (LOG_P8));
+  y = _mm256_mul_ps (y, x);
+  y = _mm256_mul_ps (y, z);
+  y = _mm256_add_ps (y, _mm256_mul_ps (e, _mm256_set1_ps (LOG_Q1)));
+  y = _mm256_add_ps (y, _mm256_mul_ps (z, _mm256_set1_ps (-0.5f)));
+  x = _mm256_add_ps (x, y);
+  return _mm256_add_ps (x, _mm256_mul_ps (e, _mm256_set1_ps (LOG_Q2)));
+}
+
+TARGET_AVX2 static inline void
+box_muller_avx2 (__m256 * out0, __m256 * out1, __m256i radius_bits,
+    __m256i angle_bits)
+{
+  const __m256i k = _mm256_srli_epi32 (angle_bits, 8);
+  const __m256i q = _mm256_srai_epi32 (_mm256_add_epi32 (k,
+          _mm256_set1_epi32 (1 << 21)), 22);
+  const __m256 u = _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_add_epi32
+          (_mm256_srli_epi32 (radius_bits, 8), _mm256_set1_epi32 (1))),
+      _mm256_set1_ps (INV_2_24));
+  const __m256 radius = _mm256_sqrt_ps (_mm256_mul_ps (_mm256_set1_ps (-2.0f),
+          log_avx2 (u)));
+  const __m256 a = _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_sub_epi32 (k,
+              _mm256_slli_epi32 (q, 22))), _mm256_set1_ps (ANGLE_SCALE));
+  const __m256 z = _mm256_mul_ps (a, a);
+  const __m256i two = _mm256_set1_epi32 (2);
+  __m256 s, c, swap, cos_t, sin_t;
+
+  s = _mm256_set1_ps (SIN_P0);
+  s = _mm256_add_ps (_mm256_mul_ps (s, z), _mm256_set1_ps (SIN_P1));
+  s = _mm256_add_ps (_mm256_mul_ps (s, z), _mm256_set1_ps (SIN_P2));
+  s = _mm256_mul_ps (s, z);
+  s = _mm256_mul_ps (s, a);
+  s = _mm256_add_ps (s, a);
+
+  c = _mm256_set1_ps (COS_P0);
+  c = _mm256_add_ps (_mm256_mul_ps (c, z), _mm256_set1_ps (COS_P1));
+  c = _mm256_add_ps (_mm256_mul_ps (c, z), _mm256_set1_ps (COS_P2));
+  c = _mm256_mul_ps (c, z);
+  c = _mm256_mul_ps (c, z);
+  c = _mm256_sub_ps (c, _mm256_mul_ps (z, _mm256_set1_ps (0.5f)));
+  c = _mm256_add_ps (c, _mm256_set1_ps (1.0f));
+
+  swap = _mm256_castsi256_ps (_mm256_cmpeq_epi32 (_mm256_and_si256 (q,
+              _mm256_set1_epi32 (1)), _mm256_set1_epi32 (1)));
+  cos_t = _mm256_blendv_ps (c, s, swap);
+  sin_t = _mm256_blendv_ps (s, c, swap);
+  cos_t = _mm256_xor_ps (cos_t, _mm256_castsi256_ps (_mm256_slli_epi32
+          (_mm256_and_si256 (_mm256_add_epi32 (q, _mm256_set1_epi32 (1)),
+                  two), 30)));
+  sin_t = _mm256_xor_ps (sin_t, _mm256_castsi256_ps (_mm256_slli_epi32
+          (_mm256_and_si256 (q, two), 30)));
+
+  *out0 = _mm256_mul_ps (radius, cos_t);
+  *out1 = _mm256_mul_ps (radius, sin_t);
+}
+
+/* the variates of eight consecutive counters, in element order */
+TARGET_AVX2 static inline void
+normals_avx2 (__m256 out[4], guint32 block, const GstSfxNoiseStream * stream)
+{
+  __m256i ctr[4];
+  __m256 n[4], t[4];
+
+  ctr[0] = _mm256_add_epi32 (_mm256_set1_epi32 ((gint) block),
+      _mm256_setr_epi32 (0, 1, 2, 3, 4, 5, 6, 7));
+  ctr[1] = _mm256_set1_epi32 ((gint) stream->row);
+  ctr[2] = _mm256_set1_epi32 ((gint) stream->frame);
+  ctr[3] = _mm256_set1_epi32 ((gint) stream->component);
+  philox_avx2 (ctr, stream->key);
+
+  box_muller_avx2 (&n[0], &n[1], ctr[0], ctr[1]);
+  box_muller_avx2 (&n[2], &n[3], ctr[2], ctr[3]);
+
+  /* transpose within each 128-bit lane, giving the four variates of one
+   * counter per quarter, then gather the quarters in counter order */
+  t[0] = _mm256_unpacklo_ps (n[0], n[1]);
+  t[1] = _mm256_unpackhi_ps (n[0], n[1]);
+  t[2] = _mm256_unpacklo_ps (n[2], n[3]);
+  t[3] = _mm256_unpackhi_ps (n[2], n[3]);
+  n[0] = _mm256_shuffle_ps (t[0], t[2], _MM_SHUFFLE (1, 0, 1, 0));
+  n[1] = _mm256_shuffle_ps (t[0], t[2], _MM_SHUFFLE (3, 2, 3, 2));
+  n[2] = _mm256_shuffle_ps (t[1], t[3], _MM_SHUFFLE (1, 0, 1, 0));
+  n[3] = _mm256_shuffle_ps (t[1], t[3], _MM_SHUFFLE (3, 2, 3, 2));
+  out[0] = _mm256_permute2f128_ps (n[0], n[1], 0x20);
+  out[1] = _mm256_permute2f128_ps (n[2], n[3], 0x20);
+  out[2] = _mm256_permute2f128_ps (n[0], n[1], 0x31);
+  out[3] = _mm256_permute2f128_ps (n[2], n[3], 0x31);
+}
+
+TARGET_AVX2 static void
+normal_avx2 (gfloat * dst, gint width, const GstSfxNoiseStream * stream,
+    gfloat sigma)
+{
+  const __m256 sigmav = _mm256_set1_ps (sigma);
+  gint x, i;
+
+  for (x = 0; x + 32 <= width; x += 32) {
+    __m256 n[4];
+
+    normals_avx2 (n, x / 4, stream);
+    for (i = 0; i < 4; i++)
+      _mm256_storeu_ps (dst + x + 8 * i, _mm256_mul_ps (n[i], sigmav));
+  }
+
+  normal_scalar_from (dst, x, width, stream, sigma);
+}
+
+TARGET_AVX2 static void
+noise_row_avx2 (guint16 * dst, const guint16 * src, const gfloat * fixed,
+    const gfloat * columns, gfloat row, gint width,
+    const GstSfxNoiseStream * stream, gfloat sigma)
+{
+  const __m256 rowv = _mm256_set1_ps (row);
+  const __m256 sigmav = _mm256_set1_ps (sigma);
+  const __m256 zero = _mm256_setzero_ps ();
+  const __m256 max = _mm256_set1_ps (65535.0f);
+  const gboolean random = sigma != 0.0f;
+  gint x, i;
+
+  for (x = 0; x + 32 <= width; x += 32) {
+    __m256 n[4];
+    __m256i out[4];
+
+    if (random)
+      normals_avx2 (n, x / 4, stream);
+
+    for (i = 0; i < 4; i++) {
+      const gint xi = x + 8 * i;
+      __m256 v = _mm256_cvtepi32_ps (_mm256_cvtepu16_epi32 (_mm_loadu_si128
+              ((const __m128i *) (src + xi))));
+
+      v = _mm256_add_ps (v, _mm256_loadu_ps (fixed + xi));
+      v = _mm256_add_ps (v, _mm256_loadu_ps (columns + xi));
+      v = _mm256_add_ps (v, rowv);
+      if (random)
+        v = _mm256_add_ps (v, _mm256_mul_ps (n[i], sigmav));
+      out[i] = _mm256_cvtps_epi32 (_mm256_min_ps (_mm256_max_ps (v, zero),
+              max));
+    }
+
+    /* packus works within 128-bit lanes, so undo its interleave */
+    _mm256_storeu_si256 ((__m256i *) (dst + x),
+        _mm256_permute4x64_epi64 (_mm256_packus_epi32 (out[0], out[1]),
+            _MM_SHUFFLE (3, 1, 2, 0)));
+    _mm256_storeu_si256 ((__m256i *) (dst + x + 16),
+        _mm256_permute4x64_epi64 (_mm256_packus_epi32 (out[2], out[3]),
+            _MM_SHUFFLE (3, 1, 2, 0)));
+  }
+
+  noise_row_scalar_from (dst, src, fixed, columns, row, x, width, stream,
+      sigma);
+}
+
+TARGET_AVX2 static void
+blur_taps_avx2 (gfloat * dst, const gfloat * src, const gfloat * taps,
+    gint n_taps, gint width)
+{
+  gint x, i;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    __m256 acc0 = _mm256_setzero_ps ();
+    __m256 acc1 = _mm256_setzero_ps ();
+
+    for (i = 0; i < n_taps; i++) {
+      const __m256 tap = _mm256_set1_ps (taps[i]);
+      acc0 = _mm256_add_ps (acc0, _mm256_mul_ps (tap,
+              _mm256_loadu_ps (src + x + i)));
+      acc1 = _mm256_add_ps (acc1, _mm256_mul_ps (tap,
+              _mm256_loadu_ps (src + x + i + 8)));
+    }
+    _mm256_storeu_ps (dst + x, acc0);
+    _mm256_storeu_ps (dst + x + 8, acc1);
+  }
+
+  blur_taps_scalar_from (dst, src, taps, n_taps, x, width);
+}
+
+TARGET_AVX2 static void
+blur_axpy_avx2 (gfloat * dst, const gfloat * src, gfloat weight, gint width)
+{
+  const __m256 w = _mm256_set1_ps (weight);
+  gint x;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    _mm256_storeu_ps (dst + x, _mm256_add_ps (_mm256_loadu_ps (dst + x),
+            _mm256_mul_ps (w, _mm256_loadu_ps (src + x))));
+    _mm256_storeu_ps (dst + x + 8, _mm256_add_ps (_mm256_loadu_ps (dst + x +
+                8), _mm256_mul_ps (w, _mm256_loadu_ps (src + x + 8))));
+  }
+
+  blur_axpy_scalar_from (dst, src, weight, x, width);
+}
+
+TARGET_AVX2 static void
+blur_load8_avx2 (gfloat * dst, const guint8 * src, gint width)
+{
+  gint x;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    const __m128i v = _mm_loadu_si128 ((const __m128i *) (src + x));
+    _mm256_storeu_ps (dst + x, _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (v)));
+    _mm256_storeu_ps (dst + x + 8,
+        _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (_mm_srli_si128 (v, 8))));
+  }
+
+  for (; x < width; x++)
+    dst[x] = (gfloat) src[x];
+}
+
+TARGET_AVX2 static void
+blur_load16_avx2 (gfloat * dst, const guint8 * src, gint width)
+{
+  const guint16 *src16 = (const guint16 *) src;
+  gint x;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    _mm256_storeu_ps (dst + x, _mm256_cvtepi32_ps (_mm256_cvtepu16_epi32
+            (_mm_loadu_si128 ((const __m128i *) (src16 + x)))));
+    _mm256_storeu_ps (dst + x + 8, _mm256_cvtepi32_ps (_mm256_cvtepu16_epi32
+            (_mm_loadu_si128 ((const __m128i *) (src16 + x + 8)))));
+  }
+
+  for (; x < width; x++)
+    dst[x] = (gfloat) src16[x];
+}
+
+/* sixteen rounded and clamped values as unsigned 16-bit in element order */
+TARGET_AVX2 static inline __m256i
+blur_round16_avx2 (const gfloat * src, __m256 max)
+{
+  const __m256 zero = _mm256_setzero_ps ();
+  const __m256i lo = _mm256_cvtps_epi32 (_mm256_min_ps (_mm256_max_ps
+          (_mm256_loadu_ps (src), zero), max));
+  const __m256i hi = _mm256_cvtps_epi32 (_mm256_min_ps (_mm256_max_ps
+          (_mm256_loadu_ps (src + 8), zero), max));
+
+  return _mm256_permute4x64_epi64 (_mm256_packus_epi32 (lo, hi),
+      _MM_SHUFFLE (3, 1, 2, 0));
+}
+
+TARGET_AVX2 static void
+blur_store8_avx2 (guint8 * dst, const gfloat * src, gint width)
+{
+  const __m256 max = _mm256_set1_ps (255.0f);
+  gint x;
+
+  for (x = 0; x + 16 <= width; x += 16) {
+    const __m256i v = blur_round16_avx2 (src + x, max);
+    _mm_storeu_si128 ((__m128i *) (dst + x),
+        _mm_packus_epi16 (_mm256_castsi256_si128 (v),
+            _mm256_extracti128_si256 (v, 1)));
+  }
+
+  for (; x < width; x++)
+    dst[x] = (guint8) saturate_round (src[x], 255.0f);
+}
+
+TARGET_AVX2 static void
+blur_store16_avx2 (guint8 * dst, const gfloat * src, gint width)
+{
+  const __m256 max = _mm256_set1_ps (65535.0f);
+  guint16 *dst16 = (guint16 *) dst;
+  gint x;
+
+  for (x = 0; x + 16 <= width; x += 16)
+    _mm256_storeu_si256 ((__m256i *) (dst16 + x), blur_round16_avx2 (src + x,
+            max));
+
+  for (; x < width; x++)
+    dst16[x] = saturate_round (src[x], 65535.0f);
+}
+
+#endif /* HAVE_X86_SIMD */
+
+/**
+ * gst_sfx_simd_get_normal_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the normal variate kernel for @level, falling back to a scalar
+ * loop
+ */
+GstSfxNormalFunc
+gst_sfx_simd_get_normal_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return normal_avx2;
+    case GST_SIMD_SSE41:
+      return normal_sse41;
+#endif
+    default:
+      return normal_scalar;
+  }
+}
+
+/**
+ * gst_sfx_simd_get_noise_row_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the noise row kernel for @level, falling back to a scalar loop
+ */
+GstSfxNoiseRowFunc
+gst_sfx_simd_get_noise_row_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return noise_row_avx2;
+    case GST_SIMD_SSE41:
+      return noise_row_sse41;
+#endif
+    default:
+      return noise_row_scalar;
+  }
+}
+
+/**
+ * gst_sfx_simd_get_blur_taps_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the horizontal FIR kernel for @level, falling back to a scalar
+ * loop
+ */
+GstSfxBlurTapsFunc
+gst_sfx_simd_get_blur_taps_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return blur_taps_avx2;
+    case GST_SIMD_SSE41:
+      return blur_taps_sse41;
+#endif
+    default:
+      return blur_taps_scalar;
+  }
+}
+
+/**
+ * gst_sfx_simd_get_blur_axpy_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ *
+ * Returns: the row accumulation kernel for @level, falling back to a scalar
+ * loop
+ */
+GstSfxBlurAxpyFunc
+gst_sfx_simd_get_blur_axpy_func (GstSimdLevel level)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return blur_axpy_avx2;
+    case GST_SIMD_SSE41:
+      return blur_axpy_sse41;
+#endif
+    default:
+      return blur_axpy_scalar;
+  }
+}
+
+/**
+ * gst_sfx_simd_get_blur_load_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ * @sixteen: whether pixels are 16-bit rather than 8-bit
+ *
+ * Returns: the pixel to float conversion for @level, falling back to a scalar
+ * loop
+ */
+GstSfxBlurLoadFunc
+gst_sfx_simd_get_blur_load_func (GstSimdLevel level, gboolean sixteen)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return sixteen ? blur_load16_avx2 : blur_load8_avx2;
+    case GST_SIMD_SSE41:
+      return sixteen ? blur_load16_sse41 : blur_load8_sse41;
+#endif
+    default:
+      return sixteen ? blur_load16_scalar : blur_load8_scalar;
+  }
+}
+
+/**
+ * gst_sfx_simd_get_blur_store_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ * @sixteen: whether pixels are 16-bit rather than 8-bit
+ *
+ * Returns: the float to pixel conversion for @level, falling back to a scalar
+ * loop
+ */
+GstSfxBlurStoreFunc
+gst_sfx_simd_get_blur_store_func (GstSimdLevel level, gboolean sixteen)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return sixteen ? blur_store16_avx2 : blur_store8_avx2;
+    case GST_SIMD_SSE41:
+      return sixteen ? blur_store16_sse41 : blur_store8_sse41;
+#endif
+    default:
+      return sixteen ? blur_store16_scalar : blur_store8_scalar;
+  }
+}
@@ -0,0 +1,152 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __GST_SENSORFX_SIMD_H__
+#define __GST_SENSORFX_SIMD_H__
+
+#include <glib.h>
+
+#include "simdlevel.h"
+
+G_BEGIN_DECLS
+
+/**
+* GstSfxNoiseComponent:
+*
+* The seven 3D-noise components, each drawing from its own random stream.
+*/
+typedef enum
+{
+  GST_SFX_NOISE_T,
+  GST_SFX_NOISE_V,
+  GST_SFX_NOISE_H,
+  GST_SFX_NOISE_TV,
+  GST_SFX_NOISE_TH,
+  GST_SFX_NOISE_VH,
+  GST_SFX_NOISE_TVH
+} GstSfxNoiseComponent;
+
+/**
+* GstSfxNoiseStream:
+* @key: seed of the generator
+* @row: row of the noise field
+* @frame: frame number, or generation of fixed noise
+* @component: a #GstSfxNoiseComponent
+*
+* Names one row of normal variates. Element x of the row comes from the
+* Philox counter (x / 4, row, frame, component), so a row is the same no
+* matter which kernel or thread generates it.
+*/
+typedef struct
+{
+  guint32 key[2];
+  guint32 row;
+  guint32 frame;
+  guint32 component;
+} GstSfxNoiseStream;
+
+/**
+* GstSfxNormalFunc:
+* @dst: output row
+* @width: number of elements
+* @stream: which variates to generate
+* @sigma: standard deviation
+*
+* Fill a row with normal variates.
+*/
+typedef void (*GstSfxNormalFunc) (gfloat * dst, gint width,
+    const GstSfxNoiseStream * stream, gfloat sigma);
+
+/**
+* GstSfxNoiseRowFunc:
+* @dst: output row, may be @src
+* @src: input row
+* @fixed: fixed pattern noise of the row
+* @columns: temporal noise of each column
+* @row: temporal noise of the whole row
+* @width: number of pixels
+* @stream: spatio-temporal noise of the row
+* @sigma: standard deviation of the spatio-temporal noise, 0 to skip it
+*
+* Add every noise component to one row, rounding and saturating the sum to
+* 16 bits.
+*/
+typedef void (*GstSfxNoiseRowFunc) (guint16 * dst, const guint16 * src,
+    const gfloat * fixed, const gfloat * columns, gfloat row, gint width,
+    const GstSfxNoiseStream * stream, gfloat sigma);
+
+/**
+* GstSfxBlurTapsFunc:
+* @dst: output row
+* @src: input row, padded so that @src[x + i] is valid for every tap
+* @taps: filter coefficients
+* @n_taps: number of coefficients
+* @width: number of outputs
+*
+* Filter one row, dst[x] being the sum of taps[i] * src[x + i].
+*/
+typedef void (*GstSfxBlurTapsFunc) (gfloat * dst, const gfloat * src,
+    const gfloat * taps, gint n_taps, gint width);
+
+/**
+* GstSfxBlurAxpyFunc:
+* @dst: accumulated row
+* @src: row to add
+* @weight: weight of @src
+* @width: number of elements
+*
+* Add a weighted row, dst[x] += weight * src[x].
+*/
+typedef void (*GstSfxBlurAxpyFunc) (gfloat * dst, const gfloat * src,
+    gfloat weight, gint width);
+
+/**
+* GstSfxBlurLoadFunc:
+* @dst: output row
+* @src: row of GRAY8 or GRAY16_LE pixels
+* @width: number of pixels
+*
+* Convert a row of pixels to float.
+*/
+typedef void (*GstSfxBlurLoadFunc) (gfloat * dst, const guint8 * src,
+    gint width);
+
+/**
+* GstSfxBlurStoreFunc:
+* @dst: row of GRAY8 or GRAY16_LE pixels
+* @src: input row
+* @width: number of pixels
+*
+* Convert a float row to pixels, rounding to nearest even and saturating.
+*/
+typedef void (*GstSfxBlurStoreFunc) (guint8 * dst, const gfloat * src,
+    gint width);
+
+GstSfxNormalFunc gst_sfx_simd_get_normal_func (GstSimdLevel level);
+GstSfxNoiseRowFunc gst_sfx_simd_get_noise_row_func (GstSimdLevel level);
+GstSfxBlurTapsFunc gst_sfx_simd_get_blur_taps_func (GstSimdLevel level);
+GstSfxBlurAxpyFunc gst_sfx_simd_get_blur_axpy_func (GstSimdLevel level);
+GstSfxBlurLoadFunc gst_sfx_simd_get_blur_load_func (GstSimdLevel level,
+    gboolean sixteen);
+GstSfxBlurStoreFunc gst_sfx_simd_get_blur_store_func (GstSimdLevel level,
+    gboolean sixteen);
+
+G_END_DECLS
+
+#endif /* __GST_SENSORFX_SIMD_H__ */
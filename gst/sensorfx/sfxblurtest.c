@@ -0,0 +1,281 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Bit-exactness test for the sfxblur filtering.
+ *
+ * Blurs GRAY8 and GRAY16_LE frames through the Gaussian, user kernel,
+ * three-box and detector box paths at every instruction set the CPU
+ * supports, on one thread and on several whose stripes start away from the
+ * rows where vertical box sums restart. Every run must match the scalar
+ * kernels on one thread exactly, and those must be within one code value of
+ * a direct double precision convolution, which catches drift or a bad
+ * restart in the sliding sums. Bytes past each row must stay untouched.
+ * Returns nonzero on any mismatch.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "gstsensorfxpsf.h"
+
+/* odd sizes so every kernel has a tail, and tall enough for several box
+ * restarts */
+#define WIDTH 83
+#define HEIGHT (3 * GST_SFX_PSF_BOX_RESTART_ROWS + 5)
+/* bytes past each row, left untouched by the blur */
+#define GUARD 6
+#define GUARD_BYTE 0xa5
+
+typedef struct
+{
+  const gchar *name;
+  gdouble sigma;
+  const gchar *kernel;
+  guint detector_width;
+  guint detector_height;
+} Case;
+
+static const Case cases[] = {
+  {"gaussian", 1.5, NULL, 1, 1},
+  {"gaussian and detector", 2.5, NULL, 3, 2},
+  {"kernel", 0.0, "1, 4, 6, 4, 1", 1, 1},
+  {"asymmetric kernel", 0.0, "0.5,2,3,1", 2, 1},
+  {"three boxes", GST_SFX_PSF_MAX_GAUSSIAN_SIGMA + 2.0, NULL, 1, 1},
+  {"three boxes and detector", 11.0, NULL, 4, 5},
+  {"detector", 0.0, NULL, 5, 7},
+};
+
+/* 3 and 4 threads start stripes at rows 33, 67 and 25, 50, 75, inside the
+ * blocks between restarts */
+static const guint thread_counts[] = { 1, 3, 4 };
+
+static gint
+frame_stride (gboolean sixteen)
+{
+  return WIDTH * (sixteen ? 2 : 1) + GUARD;
+}
+
+static guint8 *
+blur (const Case * c, GstSimdLevel level, GstStripePool * pool,
+    const guint8 * src, gboolean sixteen, GstSfxPsf * stages)
+{
+  const gsize size = (gsize) frame_stride (sixteen) * HEIGHT;
+  guint8 *frame = g_new (guint8, size);
+  GstSfxPsf psf;
+
+  memcpy (frame, src, size);
+  gst_sfx_psf_init (&psf, level);
+  psf.pool = pool;
+  gst_sfx_psf_alloc (&psf, WIDTH, HEIGHT, sixteen);
+  if (!gst_sfx_psf_set_stages (&psf, c->sigma, c->kernel, c->detector_width,
+          c->detector_height))
+    fprintf (stderr, "%s: kernel rejected\n", c->name);
+  gst_sfx_psf_apply (&psf, frame, frame_stride (sixteen));
+
+  /* hand the stages to the caller for the direct convolution */
+  if (stages)
+    *stages = psf;
+  else
+    gst_sfx_psf_free (&psf);
+
+  return frame;
+}
+
+static gdouble
+get_pixel (const guint8 * frame, gboolean sixteen, gint x, gint y)
+{
+  const guint8 *row = frame + y * frame_stride (sixteen);
+
+  return sixteen ? ((const guint16 *) row)[x] : row[x];
+}
+
+/* one stage along rows or columns with replicated edges */
+static void
+convolve (gdouble * dst, const gdouble * src, const GstSfxPsfStage * stage,
+    gboolean vertical)
+{
+  const gint n = stage->left + stage->right + 1;
+  gint i, x, y;
+
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH; x++) {
+      gdouble acc = 0.0;
+
+      for (i = -stage->left; i <= stage->right; i++) {
+        const gdouble weight =
+            stage->taps ? stage->taps[i + stage->left] : 1.0 / n;
+        gdouble value;
+
+        if (vertical)
+          value = src[CLAMP (y + i, 0, HEIGHT - 1) * WIDTH + x];
+        else
+          value = src[y * WIDTH + CLAMP (x + i, 0, WIDTH - 1)];
+        acc += weight * value;
+      }
+      dst[y * WIDTH + x] = acc;
+    }
+  }
+}
+
+/* the scalar result against a direct convolution by the same stages */
+static gint
+check_direct (const Case * c, const GstSfxPsf * psf, const guint8 * src,
+    const guint8 * frame, gboolean sixteen)
+{
+  const gdouble max = sixteen ? G_MAXUINT16 : G_MAXUINT8;
+  gdouble *a = g_new (gdouble, WIDTH * HEIGHT);
+  gdouble *b = g_new (gdouble, WIDTH * HEIGHT);
+  gdouble *tmp;
+  gint failures = 0;
+  gint x, y;
+  guint s;
+
+  for (y = 0; y < HEIGHT; y++)
+    for (x = 0; x < WIDTH; x++)
+      a[y * WIDTH + x] = get_pixel (src, sixteen, x, y);
+
+  for (s = 0; s < psf->n_h_stages; s++) {
+    convolve (b, a, &psf->h_stages[s], FALSE);
+    tmp = a;
+    a = b;
+    b = tmp;
+  }
+  for (s = 0; s < psf->n_v_stages; s++) {
+    convolve (b, a, &psf->v_stages[s], TRUE);
+    tmp = a;
+    a = b;
+    b = tmp;
+  }
+
+  for (y = 0; y < HEIGHT && !failures; y++) {
+    for (x = 0; x < WIDTH; x++) {
+      const gdouble expected = CLAMP (floor (a[y * WIDTH + x] + 0.5), 0, max);
+
+      if (fabs (get_pixel (frame, sixteen, x, y) - expected) > 1.0) {
+        fprintf (stderr, "%s %s: pixel %d,%d is %g instead of %g\n",
+            c->name, sixteen ? "GRAY16_LE" : "GRAY8", x, y,
+            get_pixel (frame, sixteen, x, y), expected);
+        failures++;
+        break;
+      }
+    }
+  }
+
+  for (y = 0; y < HEIGHT; y++) {
+    const gsize end = (gsize) y * frame_stride (sixteen) +
+        frame_stride (sixteen) - GUARD;
+
+    if (memcmp (frame + end, src + end, GUARD) != 0) {
+      fprintf (stderr, "%s %s: wrote past row %d\n", c->name,
+          sixteen ? "GRAY16_LE" : "GRAY8", y);
+      failures++;
+      break;
+    }
+  }
+
+  g_free (a);
+  g_free (b);
+
+  return failures;
+}
+
+int
+main (int argc, char **argv)
+{
+  GstSimdLevel level, detected;
+  GstStripePool *pools[G_N_ELEMENTS (thread_counts)];
+  GRand *rand;
+  guint8 *src[2];
+  gint failures = 0;
+  gint sixteen;
+  guint i, j;
+  gsize k;
+
+  /* random pixels, with saturated and black runs so the stores clip at
+   * both ends */
+  rand = g_rand_new_with_seed (0);
+  for (sixteen = 0; sixteen < 2; sixteen++) {
+    const gsize size = (gsize) frame_stride (sixteen) * HEIGHT;
+
+    src[sixteen] = g_new (guint8, size);
+    for (k = 0; k < size; k++) {
+      if (k % frame_stride (sixteen) >= frame_stride (sixteen) - GUARD)
+        src[sixteen][k] = GUARD_BYTE;
+      else if (k / frame_stride (sixteen) % 16 == 3)
+        src[sixteen][k] = 0xff;
+      else if (k / frame_stride (sixteen) % 16 == 9)
+        src[sixteen][k] = 0;
+      else
+        src[sixteen][k] = (guint8) g_rand_int (rand);
+    }
+  }
+  g_rand_free (rand);
+
+  for (j = 0; j < G_N_ELEMENTS (thread_counts); j++)
+    pools[j] = gst_stripe_pool_new (thread_counts[j]);
+
+  detected = gst_simd_get_level ();
+  for (i = 0; i < G_N_ELEMENTS (cases); i++) {
+    for (sixteen = 0; sixteen < 2; sixteen++) {
+      const gsize size = (gsize) frame_stride (sixteen) * HEIGHT;
+      GstSfxPsf stages;
+      guint8 *expected;
+      gint case_failures;
+
+      expected = blur (&cases[i], GST_SIMD_NONE, pools[0], src[sixteen],
+          sixteen, &stages);
+      case_failures = check_direct (&cases[i], &stages, src[sixteen],
+          expected, sixteen);
+      gst_sfx_psf_free (&stages);
+
+      for (level = GST_SIMD_NONE; level <= detected; level++) {
+        /* SSSE3 selects the scalar kernels */
+        if (level == GST_SIMD_SSSE3)
+          continue;
+
+        for (j = 0; j < G_N_ELEMENTS (thread_counts); j++) {
+          guint8 *actual = blur (&cases[i], level, pools[j], src[sixteen],
+              sixteen, NULL);
+
+          if (memcmp (expected, actual, size) != 0) {
+            fprintf (stderr, "%s %s: %s with %u threads differs from "
+                "scalar\n", cases[i].name, sixteen ? "GRAY16_LE" : "GRAY8",
+                gst_simd_get_name (level), thread_counts[j]);
+            case_failures++;
+          }
+          g_free (actual);
+        }
+      }
+
+      printf ("%-24s %-9s %d mismatches\n", cases[i].name,
+          sixteen ? "GRAY16_LE" : "GRAY8", case_failures);
+      failures += case_failures;
+      g_free (expected);
+    }
+  }
+
+  for (j = 0; j < G_N_ELEMENTS (thread_counts); j++)
+    gst_stripe_pool_free (pools[j]);
+  g_free (src[0]);
+  g_free (src[1]);
+
+  return failures > 0;
+}
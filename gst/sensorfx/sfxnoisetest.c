@@ -0,0 +1,154 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Determinism test for the sfx3dnoise noise generation.
+ *
+ * Creates fixed pattern noise and adds noise to a sequence of frames with
+ * a fixed seed at every instruction set the CPU supports, on one thread
+ * and on several, hashing the fixed noise and every output frame. All runs
+ * must give the known hash, so a seed reproduces the same frames on any
+ * machine and with any thread count. Returns nonzero on any mismatch.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gstsensorfxnoise.h"
+
+/* odd sizes so rows are split unevenly and every kernel has a tail */
+#define WIDTH 77
+#define HEIGHT 31
+#define STRIDE (WIDTH * 2 + 6)
+#define N_FRAMES 6
+#define SEED G_GUINT64_CONSTANT (0x0123456789abcdef)
+
+/* FNV-1a of the fixed noise and all frames, update when the noise
+ * generation changes on purpose */
+#define KNOWN_HASH G_GUINT64_CONSTANT (0xb42cc571fa4d6bd3)
+
+static const guint thread_counts[] = { 1, 3 };
+
+static guint64
+hash_bytes (guint64 hash, const guint8 * data, gsize size)
+{
+  gsize i;
+
+  for (i = 0; i < size; i++) {
+    hash ^= data[i];
+    hash *= G_GUINT64_CONSTANT (0x100000001b3);
+  }
+
+  return hash;
+}
+
+static guint64
+hash_frame (guint64 hash, const guint8 * frame)
+{
+  gint y;
+
+  for (y = 0; y < HEIGHT; y++)
+    hash = hash_bytes (hash, frame + y * STRIDE, WIDTH * 2);
+
+  return hash;
+}
+
+static guint64
+run (GstSimdLevel level, GstStripePool * pool, const guint8 * src)
+{
+  GstSfxNoise noise;
+  guint8 *dst;
+  guint64 hash = G_GUINT64_CONSTANT (0xcbf29ce484222325);
+  guint32 frame;
+
+  gst_sfx_noise_init (&noise, level);
+  gst_sfx_noise_alloc (&noise, WIDTH, HEIGHT);
+  noise.seed = SEED;
+  noise.pool = pool;
+
+  gst_sfx_noise_create_fixed (&noise, 0, 0.004, 0.003, 0.01);
+  hash = hash_bytes (hash, (const guint8 *) noise.fixed,
+      WIDTH * HEIGHT * sizeof (gfloat));
+
+  dst = g_new (guint8, STRIDE * HEIGHT);
+  for (frame = 0; frame < N_FRAMES; frame++) {
+    /* a new fixed pattern half way, as when its sigmas change */
+    if (frame == N_FRAMES / 2)
+      gst_sfx_noise_create_fixed (&noise, 1, 0.002, 0.005, 0.0);
+
+    /* alternate the sampled tvh component with only the per-row ones */
+    gst_sfx_noise_apply (&noise, frame, src, STRIDE, dst, STRIDE, 0.01,
+        0.005, 0.004, frame % 2 ? 0.0 : 0.02);
+    hash = hash_frame (hash, dst);
+  }
+
+  g_free (dst);
+  gst_sfx_noise_free (&noise);
+
+  return hash;
+}
+
+int
+main (int argc, char **argv)
+{
+  GstSimdLevel level, detected;
+  GstStripePool *pool;
+  guint8 *src;
+  guint64 hash;
+  gint failures = 0;
+  guint i;
+  gint x, y;
+
+  /* a gradient over the whole 16-bit range so the noise clips at both
+   * ends */
+  src = g_new0 (guint8, STRIDE * HEIGHT);
+  for (y = 0; y < HEIGHT; y++) {
+    guint16 *row = (guint16 *) (src + y * STRIDE);
+
+    for (x = 0; x < WIDTH; x++)
+      row[x] = (guint16) ((x * HEIGHT + y) * G_MAXUINT16 /
+          (WIDTH * HEIGHT - 1));
+  }
+
+  detected = gst_simd_get_level ();
+  for (level = GST_SIMD_NONE; level <= detected; level++) {
+    /* SSSE3 selects the scalar kernels */
+    if (level == GST_SIMD_SSSE3)
+      continue;
+
+    for (i = 0; i < G_N_ELEMENTS (thread_counts); i++) {
+      pool = gst_stripe_pool_new (thread_counts[i]);
+      hash = run (level, pool, src);
+      gst_stripe_pool_free (pool);
+
+      printf ("%-6s %u threads %016" G_GINT64_MODIFIER "x\n",
+          gst_simd_get_name (level), thread_counts[i], hash);
+      if (hash != KNOWN_HASH) {
+        fprintf (stderr, "%s with %u threads: hash %016" G_GINT64_MODIFIER
+            "x, expected %016" G_GINT64_MODIFIER "x\n",
+            gst_simd_get_name (level), thread_counts[i], hash, KNOWN_HASH);
+        failures++;
+      }
+    }
+  }
+
+  g_free (src);
+
+  return failures > 0;
+}
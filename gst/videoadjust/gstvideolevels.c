@@ -67,6 +67,18 @@ enum
   PROP_ROI_Y,
   PROP_ROI_WIDTH,
   PROP_ROI_HEIGHT,
+  PROP_N_THREADS,
+  PROP_AUTO_MODE,
+  PROP_HISTOGRAM_SUBSAMPLE_X,
+  PROP_HISTOGRAM_SUBSAMPLE_Y,
+  PROP_MODE,
+  PROP_CLAHE_TILES_X,
+  PROP_CLAHE_TILES_Y,
+  PROP_CLAHE_CLIP_LIMIT,
+  PROP_CLAHE_SMOOTHING,
+  PROP_AUTO_SMOOTHING,
+  PROP_AUTO_THRESHOLD,
+  PROP_HISTOGRAM_MESSAGE_INTERVAL,
   PROP_LAST
 };
 
@@ -75,7 +87,7 @@ static GParamSpec *properties[PROP_LAST];
 #define DEFAULT_PROP_LOWIN  0
 #define DEFAULT_PROP_HIGHIN  65535
 #define DEFAULT_PROP_LOWOUT  0
-#define DEFAULT_PROP_HIGHOUT  255
+#define DEFAULT_PROP_HIGHOUT  65535
 #define DEFAULT_PROP_AUTO 0
 #define DEFAULT_PROP_INTERVAL (GST_SECOND / 2)
 #define DEFAULT_PROP_LOW_SAT 0.01
@@ -84,6 +96,18 @@ static GParamSpec *properties[PROP_LAST];
 #define DEFAULT_PROP_ROI_Y -1
 #define DEFAULT_PROP_ROI_WIDTH 0
 #define DEFAULT_PROP_ROI_HEIGHT 0
+#define DEFAULT_PROP_N_THREADS 1
+#define DEFAULT_PROP_AUTO_MODE GST_VIDEOLEVELS_AUTO_MODE_IMMEDIATE
+#define DEFAULT_PROP_HISTOGRAM_SUBSAMPLE_X 1
+#define DEFAULT_PROP_HISTOGRAM_SUBSAMPLE_Y 1
+#define DEFAULT_PROP_MODE GST_VIDEOLEVELS_MODE_LINEAR
+#define DEFAULT_PROP_CLAHE_TILES_X 8
+#define DEFAULT_PROP_CLAHE_TILES_Y 8
+#define DEFAULT_PROP_CLAHE_CLIP_LIMIT 4.0
+#define DEFAULT_PROP_CLAHE_SMOOTHING 0.8
+#define DEFAULT_PROP_AUTO_SMOOTHING 0.0
+#define DEFAULT_PROP_AUTO_THRESHOLD 0
+#define DEFAULT_PROP_HISTOGRAM_MESSAGE_INTERVAL 0
 
 /* the capabilities of the inputs and outputs */
 static GstStaticPadTemplate gst_videolevels_src_template =
@@ -101,8 +125,8 @@ static GstStaticPadTemplate gst_videolevels_sink_template =
     GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE ("GRAY8") ";"
-        GST_GENICAM_PIXEL_FORMAT_MAKE_BAYER8 ("{ bggr, grbg, rggb, gbrg }")
+    GST_STATIC_CAPS (GST_VIDEO_CAPS_MAKE ("{ GRAY8, GRAY16_LE, GRAY16_BE }")
+        ";" GST_GENICAM_PIXEL_FORMAT_MAKE_BAYER8 ("{ bggr, grbg, rggb, gbrg }")
     )
     );
 
@@ -125,6 +149,44 @@ gst_videolevels_auto_get_type (void)
   return videolevels_auto_type;
 }
 
+#define GST_TYPE_VIDEOLEVELS_AUTO_MODE (gst_videolevels_auto_mode_get_type())
+static GType
+gst_videolevels_auto_mode_get_type (void)
+{
+  static GType videolevels_auto_mode_type = 0;
+  static const GEnumValue videolevels_auto_mode[] = {
+    {GST_VIDEOLEVELS_AUTO_MODE_IMMEDIATE, "immediate", "immediate"},
+    {GST_VIDEOLEVELS_AUTO_MODE_LAGGED, "lagged", "lagged"},
+    {GST_VIDEOLEVELS_AUTO_MODE_ASYNC, "async", "async"},
+    {0, NULL, NULL},
+  };
+
+  if (!videolevels_auto_mode_type) {
+    videolevels_auto_mode_type =
+        g_enum_register_static ("GstVideoLevelsAutoMode",
+        videolevels_auto_mode);
+  }
+  return videolevels_auto_mode_type;
+}
+
+#define GST_TYPE_VIDEOLEVELS_MODE (gst_videolevels_mode_get_type())
+static GType
+gst_videolevels_mode_get_type (void)
+{
+  static GType videolevels_mode_type = 0;
+  static const GEnumValue videolevels_mode[] = {
+    {GST_VIDEOLEVELS_MODE_LINEAR, "linear", "linear"},
+    {GST_VIDEOLEVELS_MODE_CLAHE, "clahe", "clahe"},
+    {0, NULL, NULL},
+  };
+
+  if (!videolevels_mode_type) {
+    videolevels_mode_type =
+        g_enum_register_static ("GstVideoLevelsMode", videolevels_mode);
+  }
+  return videolevels_mode_type;
+}
+
 /* GObject vmethod declarations */
 static void gst_videolevels_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -139,15 +201,61 @@ static gboolean gst_videolevels_set_caps (GstBaseTransform * trans,
     GstCaps * incaps, GstCaps * outcaps);
 static GstFlowReturn gst_videolevels_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
+static GstFlowReturn gst_videolevels_transform_ip (GstBaseTransform * trans,
+    GstBuffer * buf);
+static gboolean gst_videolevels_get_unit_size (GstBaseTransform * trans,
+    GstCaps * caps, gsize * size);
+static gboolean gst_videolevels_sink_event (GstBaseTransform * trans,
+    GstEvent * event);
+
+/* frame shared by all stripes of a parallel pass */
+typedef struct
+{
+  GstVideoLevels *levels;
+  guint8 *in_data;
+  guint8 *out_data;
+  gboolean histogram;
+} GstVideoLevelsStripeJob;
 
 /* GstVideoLevels method declarations */
 static void gst_videolevels_reset (GstVideoLevels * filter);
 static gboolean gst_videolevels_calculate_lut (GstVideoLevels * videolevels);
+static void gst_videolevels_request_lut (GstVideoLevels * videolevels);
+static void gst_videolevels_update_lut (GstVideoLevels * videolevels);
+static void gst_videolevels_lut_worker (gpointer data, gpointer user_data);
 static gboolean gst_videolevels_calculate_histogram (GstVideoLevels *
     videolevels, guint16 * data);
+static void gst_videolevels_calculate_histogram_rows (GstVideoLevels *
+    videolevels, guint16 * data, gint * hist, gint row_start, gint row_end);
+static void gst_videolevels_merge_histograms (GstVideoLevels * videolevels);
+static void gst_videolevels_check_roi (GstVideoLevels * videolevels);
 static gboolean gst_videolevels_auto_adjust (GstVideoLevels * videolevels,
     guint16 * data);
+static gboolean gst_videolevels_levels_from_histogram (GstVideoLevels *
+    videolevels, const gint * histogram, GstVideoLevelsAgcState * state,
+    gint * lower, gint * upper);
+static void gst_videolevels_adjust_from_histogram (GstVideoLevels *
+    videolevels);
+static void gst_videolevels_agc_snapshot (GstVideoLevels * videolevels,
+    GstVideoLevelsAgcState * state);
+static void gst_videolevels_agc_store (GstVideoLevels * videolevels,
+    const GstVideoLevelsAgcState * state);
+static void gst_videolevels_reset_setpoints (GstVideoLevels * videolevels);
+static void gst_videolevels_agc_worker (gpointer data, gpointer user_data);
+static void gst_videolevels_wait_agc (GstVideoLevels * videolevels);
+static void gst_videolevels_update_in_place (GstVideoLevels * videolevels);
 static void gst_videolevels_check_passthrough (GstVideoLevels * videolevels);
+static void gst_videolevels_get_output_range (GstVideoLevels * videolevels,
+    gint * lower, gint * upper);
+static void gst_videolevels_post_histogram (GstVideoLevels * videolevels,
+    GstBuffer * buf, const gint * histogram, gint lower_input,
+    gint upper_input);
+static gboolean gst_videolevels_input_is_swapped (GstVideoLevels *
+    videolevels);
+static gboolean gst_videolevels_output_is_swapped (GstVideoLevels *
+    videolevels);
+static void gst_videolevels_transform_clahe (GstVideoLevels * videolevels,
+    guint8 * in_data, guint8 * out_data);
 
 /* setup debug */
 GST_DEBUG_CATEGORY_STATIC (videolevels_debug);
@@ -171,7 +279,26 @@ gst_videolevels_dispose (GObject * object)
 
   GST_DEBUG ("dispose");
 
-  g_free (videolevels->lookup_table);
+  if (videolevels->agc_worker) {
+    /* let a queued frame be analyzed, so its buffer is released */
+    g_thread_pool_free (videolevels->agc_worker, FALSE, TRUE);
+    videolevels->agc_worker = NULL;
+  }
+  if (videolevels->lut_worker) {
+    /* drop queued requests, but wait for the one being built */
+    g_thread_pool_free (videolevels->lut_worker, TRUE, TRUE);
+    videolevels->lut_worker = NULL;
+  }
+  gst_videolevels_lut_free (videolevels->lut);
+  videolevels->lut = NULL;
+  gst_videolevels_lut_free (videolevels->pending_lut);
+  videolevels->pending_lut = NULL;
+
+  gst_stripe_pool_free (videolevels->stripe_pool);
+  videolevels->stripe_pool = NULL;
+
+  gst_videolevels_clahe_free (videolevels->clahe);
+  videolevels->clahe = NULL;
 
   gst_videolevels_reset (videolevels);
 
@@ -179,6 +306,17 @@ gst_videolevels_dispose (GObject * object)
   G_OBJECT_CLASS (gst_videolevels_parent_class)->dispose (object);
 }
 
+static void
+gst_videolevels_finalize (GObject * object)
+{
+  GstVideoLevels *videolevels = GST_VIDEOLEVELS (object);
+
+  g_mutex_clear (&videolevels->agc_lock);
+  g_cond_clear (&videolevels->agc_cond);
+
+  G_OBJECT_CLASS (gst_videolevels_parent_class)->finalize (object);
+}
+
 /**
  * gst_videolevels_class_init:
  * @object: #GstVideoLevelsClass.
@@ -199,6 +337,7 @@ gst_videolevels_class_init (GstVideoLevelsClass * klass)
 
   /* Register GObject vmethods */
   gobject_class->dispose = GST_DEBUG_FUNCPTR (gst_videolevels_dispose);
+  gobject_class->finalize = GST_DEBUG_FUNCPTR (gst_videolevels_finalize);
   gobject_class->set_property =
       GST_DEBUG_FUNCPTR (gst_videolevels_set_property);
   gobject_class->get_property =
@@ -260,6 +399,77 @@ gst_videolevels_class_init (GstVideoLevelsClass * klass)
       g_param_spec_int ("roi-height", "ROI height",
           "Height of the ROI when auto is enabled (0 uses 1/2 of the image height)",
           0, G_MAXINT, DEFAULT_PROP_ROI_HEIGHT, G_PARAM_READWRITE));
+  g_object_class_install_property (gobject_class, PROP_N_THREADS,
+      GST_STRIPE_POOL_PARAM_SPEC_N_THREADS (DEFAULT_PROP_N_THREADS));
+  g_object_class_install_property (gobject_class, PROP_AUTO_MODE,
+      g_param_spec_enum ("auto-mode", "Auto mode",
+          "How auto adjustment is scheduled: immediate reads each adjusted "
+          "frame twice and applies its own levels, lagged builds the "
+          "histogram while applying the current levels and applies the new "
+          "levels starting with the next frame, async analyzes the frame on "
+          "a worker thread and applies the new levels once they are ready "
+          "(disables in place processing)",
+          GST_TYPE_VIDEOLEVELS_AUTO_MODE, DEFAULT_PROP_AUTO_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_HISTOGRAM_SUBSAMPLE_X,
+      g_param_spec_uint ("histogram-subsample-x", "Histogram subsample x",
+          "Only sample every Nth column of the ROI when auto is enabled",
+          1, G_MAXINT, DEFAULT_PROP_HISTOGRAM_SUBSAMPLE_X,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_HISTOGRAM_SUBSAMPLE_Y,
+      g_param_spec_uint ("histogram-subsample-y", "Histogram subsample y",
+          "Only sample every Nth row of the ROI when auto is enabled",
+          1, G_MAXINT, DEFAULT_PROP_HISTOGRAM_SUBSAMPLE_Y,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MODE,
+      g_param_spec_enum ("mode", "Mode",
+          "How input levels are mapped: linear stretches the input levels "
+          "over the whole frame, clahe equalizes each region of the frame by "
+          "its local histogram (ignores input levels and auto)",
+          GST_TYPE_VIDEOLEVELS_MODE, DEFAULT_PROP_MODE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CLAHE_TILES_X,
+      g_param_spec_int ("clahe-tiles-x", "CLAHE tiles x",
+          "Number of tile columns in clahe mode", 1, G_MAXINT,
+          DEFAULT_PROP_CLAHE_TILES_X,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CLAHE_TILES_Y,
+      g_param_spec_int ("clahe-tiles-y", "CLAHE tiles y",
+          "Number of tile rows in clahe mode", 1, G_MAXINT,
+          DEFAULT_PROP_CLAHE_TILES_Y,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CLAHE_CLIP_LIMIT,
+      g_param_spec_double ("clahe-clip-limit", "CLAHE clip limit",
+          "Maximum height of a tile histogram bin as a multiple of the mean "
+          "bin height, limiting contrast gain in clahe mode (0 disables)",
+          0, G_MAXDOUBLE, DEFAULT_PROP_CLAHE_CLIP_LIMIT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CLAHE_SMOOTHING,
+      g_param_spec_double ("clahe-smoothing", "CLAHE smoothing",
+          "Weight of previous frames when updating tile histograms in clahe "
+          "mode (0 equalizes each frame on its own)",
+          0, 0.99, DEFAULT_PROP_CLAHE_SMOOTHING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_AUTO_SMOOTHING,
+      g_param_spec_double ("auto-smoothing", "Auto smoothing",
+          "Weight of the previous levels when auto is continuous, averaging "
+          "the levels over time to reduce flicker (0 disables)",
+          0, 0.99, DEFAULT_PROP_AUTO_SMOOTHING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_AUTO_THRESHOLD,
+      g_param_spec_int ("auto-threshold", "Auto threshold",
+          "Only change levels when auto is continuous and they move by more "
+          "than this many input values",
+          0, DEFAULT_PROP_HIGHIN, DEFAULT_PROP_AUTO_THRESHOLD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class,
+      PROP_HISTOGRAM_MESSAGE_INTERVAL,
+      g_param_spec_uint ("histogram-message-interval",
+          "Histogram message interval",
+          "Post every Nth histogram computed by auto adjustment as a "
+          "\"videolevels-histogram\" element message (0 disables)",
+          0, G_MAXUINT, DEFAULT_PROP_HISTOGRAM_MESSAGE_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&gst_videolevels_sink_template));
@@ -277,8 +487,15 @@ gst_videolevels_class_init (GstVideoLevelsClass * klass)
 
   gstbasetransform_class->set_caps =
       GST_DEBUG_FUNCPTR (gst_videolevels_set_caps);
+  gstbasetransform_class->get_unit_size =
+      GST_DEBUG_FUNCPTR (gst_videolevels_get_unit_size);
   gstbasetransform_class->transform =
       GST_DEBUG_FUNCPTR (gst_videolevels_transform);
+  gstbasetransform_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_videolevels_transform_ip);
+  gstbasetransform_class->transform_ip_on_passthrough = FALSE;
+  gstbasetransform_class->sink_event =
+      GST_DEBUG_FUNCPTR (gst_videolevels_sink_event);
 }
 
 /**
@@ -295,7 +512,17 @@ gst_videolevels_init (GstVideoLevels * videolevels)
 
   videolevels->passthrough = FALSE;
 
-  videolevels->lookup_table = g_new (guint8, G_MAXUINT16 + 1);
+  /* a single thread, so requests are built and published in order */
+  videolevels->lut_worker =
+      g_thread_pool_new (gst_videolevels_lut_worker, videolevels, 1, FALSE,
+      NULL);
+
+  g_mutex_init (&videolevels->agc_lock);
+  g_cond_init (&videolevels->agc_cond);
+  videolevels->agc_busy = FALSE;
+  videolevels->agc_worker =
+      g_thread_pool_new (gst_videolevels_agc_worker, videolevels, 1, FALSE,
+      NULL);
 
   gst_videolevels_reset (videolevels);
 }
@@ -318,23 +545,34 @@ gst_videolevels_set_property (GObject * object, guint prop_id,
 
   switch (prop_id) {
     case PROP_LOWIN:
+      g_mutex_lock (&videolevels->agc_lock);
       videolevels->lower_input = g_value_get_int (value);
-      gst_videolevels_calculate_lut (videolevels);
+      g_mutex_unlock (&videolevels->agc_lock);
+      gst_videolevels_request_lut (videolevels);
       break;
     case PROP_HIGHIN:
+      g_mutex_lock (&videolevels->agc_lock);
       videolevels->upper_input = g_value_get_int (value);
-      gst_videolevels_calculate_lut (videolevels);
+      g_mutex_unlock (&videolevels->agc_lock);
+      gst_videolevels_request_lut (videolevels);
       break;
     case PROP_LOWOUT:
+      g_mutex_lock (&videolevels->agc_lock);
       videolevels->lower_output = g_value_get_int (value);
-      gst_videolevels_calculate_lut (videolevels);
+      g_mutex_unlock (&videolevels->agc_lock);
+      gst_videolevels_request_lut (videolevels);
       break;
     case PROP_HIGHOUT:
+      g_mutex_lock (&videolevels->agc_lock);
       videolevels->upper_output = g_value_get_int (value);
-      gst_videolevels_calculate_lut (videolevels);
+      g_mutex_unlock (&videolevels->agc_lock);
+      gst_videolevels_request_lut (videolevels);
       break;
     case PROP_AUTO:{
+      g_mutex_lock (&videolevels->agc_lock);
       videolevels->auto_adjust = g_value_get_enum (value);
+      g_mutex_unlock (&videolevels->agc_lock);
+      gst_videolevels_reset_setpoints (videolevels);
       break;
     }
     case PROP_INTERVAL:
@@ -342,12 +580,14 @@ gst_videolevels_set_property (GObject * object, guint prop_id,
       videolevels->last_auto_timestamp = GST_CLOCK_TIME_NONE;
       break;
     case PROP_LOWER_SATURATION:
+      g_mutex_lock (&videolevels->agc_lock);
       videolevels->lower_pix_sat = g_value_get_double (value);
-      gst_videolevels_calculate_lut (videolevels);
+      g_mutex_unlock (&videolevels->agc_lock);
       break;
     case PROP_UPPER_SATURATION:
+      g_mutex_lock (&videolevels->agc_lock);
       videolevels->upper_pix_sat = g_value_get_double (value);
-      gst_videolevels_calculate_lut (videolevels);
+      g_mutex_unlock (&videolevels->agc_lock);
       break;
     case PROP_ROI_X:
       videolevels->roi_x = g_value_get_int (value);
@@ -365,6 +605,54 @@ gst_videolevels_set_property (GObject * object, guint prop_id,
       videolevels->roi_height = g_value_get_int (value);
       videolevels->check_roi = TRUE;
       break;
+    case PROP_N_THREADS:
+      videolevels->n_threads = g_value_get_uint (value);
+      break;
+    case PROP_AUTO_MODE:
+      videolevels->auto_mode = g_value_get_enum (value);
+      gst_videolevels_update_in_place (videolevels);
+      break;
+    case PROP_HISTOGRAM_SUBSAMPLE_X:
+      videolevels->histogram_subsample_x = g_value_get_uint (value);
+      break;
+    case PROP_HISTOGRAM_SUBSAMPLE_Y:
+      videolevels->histogram_subsample_y = g_value_get_uint (value);
+      break;
+    case PROP_MODE:
+      videolevels->mode = g_value_get_enum (value);
+      videolevels->clahe_reconfigure = TRUE;
+      gst_videolevels_check_passthrough (videolevels);
+      break;
+    case PROP_CLAHE_TILES_X:
+      videolevels->clahe_tiles_x = g_value_get_int (value);
+      videolevels->clahe_reconfigure = TRUE;
+      break;
+    case PROP_CLAHE_TILES_Y:
+      videolevels->clahe_tiles_y = g_value_get_int (value);
+      videolevels->clahe_reconfigure = TRUE;
+      break;
+    case PROP_CLAHE_CLIP_LIMIT:
+      videolevels->clahe_clip_limit = g_value_get_double (value);
+      break;
+    case PROP_CLAHE_SMOOTHING:
+      videolevels->clahe_smoothing = g_value_get_double (value);
+      break;
+    case PROP_AUTO_SMOOTHING:
+      g_mutex_lock (&videolevels->agc_lock);
+      videolevels->auto_smoothing = g_value_get_double (value);
+      g_mutex_unlock (&videolevels->agc_lock);
+      break;
+    case PROP_AUTO_THRESHOLD:
+      g_mutex_lock (&videolevels->agc_lock);
+      videolevels->auto_threshold = g_value_get_int (value);
+      g_mutex_unlock (&videolevels->agc_lock);
+      break;
+    case PROP_HISTOGRAM_MESSAGE_INTERVAL:
+      g_mutex_lock (&videolevels->agc_lock);
+      videolevels->histogram_message_interval = g_value_get_uint (value);
+      videolevels->histogram_count = 0;
+      g_mutex_unlock (&videolevels->agc_lock);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -424,6 +712,42 @@ gst_videolevels_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_ROI_HEIGHT:
       g_value_set_int (value, videolevels->roi_height);
       break;
+    case PROP_N_THREADS:
+      g_value_set_uint (value, videolevels->n_threads);
+      break;
+    case PROP_AUTO_MODE:
+      g_value_set_enum (value, videolevels->auto_mode);
+      break;
+    case PROP_HISTOGRAM_SUBSAMPLE_X:
+      g_value_set_uint (value, videolevels->histogram_subsample_x);
+      break;
+    case PROP_HISTOGRAM_SUBSAMPLE_Y:
+      g_value_set_uint (value, videolevels->histogram_subsample_y);
+      break;
+    case PROP_MODE:
+      g_value_set_enum (value, videolevels->mode);
+      break;
+    case PROP_CLAHE_TILES_X:
+      g_value_set_int (value, videolevels->clahe_tiles_x);
+      break;
+    case PROP_CLAHE_TILES_Y:
+      g_value_set_int (value, videolevels->clahe_tiles_y);
+      break;
+    case PROP_CLAHE_CLIP_LIMIT:
+      g_value_set_double (value, videolevels->clahe_clip_limit);
+      break;
+    case PROP_CLAHE_SMOOTHING:
+      g_value_set_double (value, videolevels->clahe_smoothing);
+      break;
+    case PROP_AUTO_SMOOTHING:
+      g_value_set_double (value, videolevels->auto_smoothing);
+      break;
+    case PROP_AUTO_THRESHOLD:
+      g_value_set_int (value, videolevels->auto_threshold);
+      break;
+    case PROP_HISTOGRAM_MESSAGE_INTERVAL:
+      g_value_set_uint (value, videolevels->histogram_message_interval);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -554,7 +878,10 @@ gst_videolevels_transform_caps (GstBaseTransform * trans,
       }
     } else {
       if (g_strcmp0 (name, "video/x-raw") == 0) {
-        newst = gst_structure_from_string ("video/x-raw,format=GRAY8", NULL);
+        /* prefer 8-bit output */
+        newst =
+            gst_structure_from_string
+            ("video/x-raw,format={GRAY8,GRAY16_LE,GRAY16_BE}", NULL);
         copy_width_height_framerate (st, newst);
         gst_caps_append_structure (other_caps, newst);
       } else if (g_strcmp0 (name, "video/x-bayer") == 0) {
@@ -593,6 +920,48 @@ gst_videolevels_transform_caps (GstBaseTransform * trans,
   return other_caps;
 }
 
+/**
+ * gst_videolevels_get_unit_size:
+ * @base: #GstBaseTransform
+ * @caps: #GstCaps
+ * @size: size of a frame
+ *
+ * Input and output frames may differ in size, since 8-bit and 16-bit
+ * formats can be converted either way.
+ *
+ * Returns: TRUE on success
+ */
+static gboolean
+gst_videolevels_get_unit_size (GstBaseTransform * trans, GstCaps * caps,
+    gsize * size)
+{
+  GstStructure *st = gst_caps_get_structure (caps, 0);
+
+  /* GstVideoInfo treats Bayer as encoded, so compute it like set_caps */
+  if (gst_structure_has_name (st, "video/x-bayer")) {
+    const gchar *format = gst_structure_get_string (st, "format");
+    gint width, height;
+
+    if (!format || !gst_structure_get_int (st, "width", &width) ||
+        !gst_structure_get_int (st, "height", &height))
+      return FALSE;
+
+    if (g_str_has_suffix (format, "16"))
+      *size = GST_ROUND_UP_4 (width * 2) * height;
+    else
+      *size = GST_ROUND_UP_4 (width) * height;
+  } else {
+    GstVideoInfo info;
+
+    if (!gst_video_info_from_caps (&info, caps))
+      return FALSE;
+
+    *size = GST_VIDEO_INFO_SIZE (&info);
+  }
+
+  return TRUE;
+}
+
 static gboolean
 gst_videolevels_set_caps (GstBaseTransform * trans, GstCaps * incaps,
     GstCaps * outcaps)
@@ -605,9 +974,6 @@ gst_videolevels_set_caps (GstBaseTransform * trans, GstCaps * incaps,
   GST_DEBUG_OBJECT (levels,
       "set_caps: in %" GST_PTR_FORMAT " out %" GST_PTR_FORMAT, incaps, outcaps);
 
-  /* always assume 8-bit output */
-  levels->bpp_out = 8;
-
   /* GstVideoInfo treats Bayer as encoded, but it's still useful */
   gst_video_info_from_caps (&invinfo, incaps);
   gst_video_info_from_caps (&outvinfo, outcaps);
@@ -619,6 +985,17 @@ gst_videolevels_set_caps (GstBaseTransform * trans, GstCaps * incaps,
   levels->stride_in = GST_VIDEO_INFO_COMP_STRIDE (&invinfo, 0);
   levels->stride_out = GST_VIDEO_INFO_COMP_STRIDE (&outvinfo, 0);
   levels->bpp_in = invinfo.finfo->bits;
+  levels->bpp_out = 8;
+  levels->endianness_in = 0;
+  levels->endianness_out = 0;
+
+  if (outvinfo.finfo->format == GST_VIDEO_FORMAT_GRAY16_BE) {
+    levels->bpp_out = 16;
+    levels->endianness_out = G_BIG_ENDIAN;
+  } else if (outvinfo.finfo->format == GST_VIDEO_FORMAT_GRAY16_LE) {
+    levels->bpp_out = 16;
+    levels->endianness_out = G_LITTLE_ENDIAN;
+  }
 
   st = gst_caps_get_structure (incaps, 0);
 
@@ -647,9 +1024,34 @@ gst_videolevels_set_caps (GstBaseTransform * trans, GstCaps * incaps,
 
   g_assert (levels->bpp_in >= 1 && levels->bpp_in <= 16);
 
+  /* the worker reads the format and histogram, let it finish first */
+  gst_videolevels_wait_agc (levels);
+
+  levels->same_layout = (levels->bpp_in > 8) == (levels->bpp_out > 8) &&
+      (levels->bpp_out == 8 ||
+      gst_videolevels_input_is_swapped (levels) ==
+      gst_videolevels_output_is_swapped (levels));
+  gst_videolevels_update_in_place (levels);
+
   levels->nbins = MIN (4096, 1 << levels->bpp_in);
+  levels->bin_shift = MAX (0, levels->bpp_in - 12);
+
+  /* number of bins may have changed */
+  g_free (levels->histogram);
+  levels->histogram = NULL;
+  g_free (levels->agc_histogram);
+  levels->agc_histogram = NULL;
 
   levels->check_roi = TRUE;
+  levels->clahe_reconfigure = TRUE;
+  gst_videolevels_reset_setpoints (levels);
+
+  if (gst_stripe_pool_ensure (&levels->stripe_pool, levels->n_threads))
+    GST_DEBUG_OBJECT (levels, "Processing with %d threads",
+        levels->stripe_pool->n_threads);
+  g_free (levels->stripe_histograms);
+  levels->stripe_histograms =
+      g_new (gint, levels->stripe_pool->n_threads * levels->nbins);
 
   res = gst_videolevels_calculate_lut (levels);
 
@@ -657,62 +1059,60 @@ gst_videolevels_set_caps (GstBaseTransform * trans, GstCaps * incaps,
 }
 
 /**
- * gst_videolevels_transform:
- * @base: #GstBaseTransform
- * @inbuf: #GstBuffer
- * @outbuf: #GstBuffer
- *
- * Transforms input buffer to output buffer.
+ * gst_videolevels_transform_rows:
+ * @videolevels: #GstVideoLevels
+ * @in_data: input frame data
+ * @out_data: output frame data
+ * @row_start: first row to process
+ * @row_end: row after the last row to process
  *
- * Returns: GST_FLOW_OK on success
+ * Applies the levels mapping to a range of rows.
  */
-static GstFlowReturn
-gst_videolevels_transform (GstBaseTransform * trans, GstBuffer * inbuf,
-    GstBuffer * outbuf)
+static void
+gst_videolevels_transform_rows (GstVideoLevels * videolevels,
+    guint8 * in_data, guint8 * out_data, gint row_start, gint row_end)
 {
-  GstVideoLevels *videolevels = GST_VIDEOLEVELS (trans);
-  GstClockTimeDiff elapsed;
-  GstClockTime start =
-      gst_clock_get_time (gst_element_get_clock (GST_ELEMENT (videolevels)));
   gint r, c;
-  guint8 *in_data, *out_data;
-  guint8 *lut;
-  GstMapInfo inminfo, outminfo;
+  GstVideoLevelsLut *levels_lut = videolevels->lut;
+  guint8 *lut = levels_lut->table;
+  guint16 *lut16 = levels_lut->table;
 
-  GST_LOG_OBJECT (videolevels, "Performing non-inplace transform");
+  in_data += row_start * videolevels->stride_in;
+  out_data += row_start * videolevels->stride_out;
 
-  gst_buffer_map (inbuf, &inminfo, GST_MAP_READ);
-  gst_buffer_map (outbuf, &outminfo, GST_MAP_WRITE);
+  /* in place is fine, each pixel is read before it is written */
+  if (videolevels->bpp_out > 8 && videolevels->bpp_in > 8) {
+    for (r = row_start; r < row_end; r++) {
+      guint16 *src = (guint16 *) in_data;
+      guint16 *dst = (guint16 *) out_data;
 
-  if (!inminfo.data || !outminfo.data) {
-    GST_ELEMENT_ERROR (videolevels, STREAM, FAILED, ("Failed to map buffer"),
-        (NULL));
-    return GST_FLOW_ERROR;
-  }
-  in_data = inminfo.data;
-  out_data = outminfo.data;
+      for (c = 0; c < videolevels->width; c++)
+        *dst++ = lut16[*src++];
 
-  if (videolevels->auto_adjust == 1) {
-    GST_DEBUG_OBJECT (videolevels, "Auto adjusting levels (once)");
-    gst_videolevels_auto_adjust (videolevels, (guint16 *) in_data);
-    videolevels->auto_adjust = 0;
-    g_object_notify (G_OBJECT (videolevels), "auto");
-  } else if (videolevels->auto_adjust == 2) {
-    elapsed =
-        GST_CLOCK_DIFF (videolevels->last_auto_timestamp,
-        GST_BUFFER_TIMESTAMP (inbuf));
-    if (videolevels->last_auto_timestamp == GST_CLOCK_TIME_NONE
-        || elapsed >= (GstClockTimeDiff) videolevels->interval || elapsed < 0) {
-      GST_LOG_OBJECT (videolevels, "Auto adjusting levels (%d ns since last)",
-          elapsed);
-      gst_videolevels_auto_adjust (videolevels, (guint16 *) in_data);
-      videolevels->last_auto_timestamp = GST_BUFFER_TIMESTAMP (inbuf);
+      in_data += videolevels->stride_in;
+      out_data += videolevels->stride_out;
     }
-  }
+  } else if (videolevels->bpp_out > 8) {
+    for (r = row_start; r < row_end; r++) {
+      guint8 *src = (guint8 *) in_data;
+      guint16 *dst = (guint16 *) out_data;
+
+      for (c = 0; c < videolevels->width; c++)
+        *dst++ = lut16[*src++];
+
+      in_data += videolevels->stride_in;
+      out_data += videolevels->stride_out;
+    }
+  } else if (videolevels->bpp_in > 8 && levels_lut->linear_func) {
+    for (r = row_start; r < row_end; r++) {
+      levels_lut->linear_func (out_data, (guint16 *) in_data,
+          videolevels->width, &levels_lut->linear);
 
-  lut = videolevels->lookup_table;
-  if (videolevels->bpp_in > 8) {
-    for (r = 0; r < videolevels->height; r++) {
+      in_data += videolevels->stride_in;
+      out_data += videolevels->stride_out;
+    }
+  } else if (videolevels->bpp_in > 8) {
+    for (r = row_start; r < row_end; r++) {
       guint16 *src = (guint16 *) in_data;
       guint8 *dst = out_data;
 
@@ -725,7 +1125,7 @@ gst_videolevels_transform (GstBaseTransform * trans, GstBuffer * inbuf,
       out_data += videolevels->stride_out;
     }
   } else {
-    for (r = 0; r < videolevels->height; r++) {
+    for (r = row_start; r < row_end; r++) {
       guint8 *src = (guint8 *) in_data;
       guint8 *dst = out_data;
 
@@ -738,6 +1138,230 @@ gst_videolevels_transform (GstBaseTransform * trans, GstBuffer * inbuf,
       out_data += videolevels->stride_out;
     }
   }
+}
+
+static void
+gst_videolevels_transform_stripe (gpointer user_data, guint stripe,
+    guint n_stripes)
+{
+  GstVideoLevelsStripeJob *job = (GstVideoLevelsStripeJob *) user_data;
+  GstVideoLevels *videolevels = job->levels;
+  gint row_start, row_end;
+  gint roi_start, roi_end;
+  gint *hist;
+  gint r;
+
+  gst_stripe_get_rows (stripe, n_stripes, videolevels->height, &row_start,
+      &row_end);
+
+  if (!job->histogram) {
+    gst_videolevels_transform_rows (videolevels, job->in_data, job->out_data,
+        row_start, row_end);
+    return;
+  }
+
+  /* fused pass: histogram each ROI row right before mapping it, while it is
+   * still in cache, instead of reading the frame a second time. The
+   * histogram comes first since mapping may overwrite the input in place. */
+  hist = videolevels->stripe_histograms + stripe * videolevels->nbins;
+  memset (hist, 0, sizeof (gint) * videolevels->nbins);
+
+  roi_start = MAX (row_start, videolevels->roi_y);
+  roi_end = MIN (row_end, videolevels->roi_y + videolevels->roi_height);
+
+  for (r = row_start; r < row_end; r++) {
+    if (r >= roi_start && r < roi_end)
+      gst_videolevels_calculate_histogram_rows (videolevels,
+          (guint16 *) job->in_data, hist, r, r + 1);
+    gst_videolevels_transform_rows (videolevels, job->in_data, job->out_data,
+        r, r + 1);
+  }
+}
+
+/**
+ * gst_videolevels_sink_event:
+ * @trans: #GstBaseTransform
+ * @event: #GstEvent
+ *
+ * Drops the CLAHE tile history on flush, so frames after a seek aren't
+ * blended with frames from before it.
+ *
+ * Returns: TRUE if the event was handled
+ */
+static gboolean
+gst_videolevels_sink_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstVideoLevels *videolevels = GST_VIDEOLEVELS (trans);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP && videolevels->clahe)
+    gst_videolevels_clahe_reset (videolevels->clahe);
+
+  return GST_BASE_TRANSFORM_CLASS (gst_videolevels_parent_class)->sink_event
+      (trans, event);
+}
+
+/**
+ * gst_videolevels_transform_clahe:
+ * @videolevels: #GstVideoLevels
+ * @in_data: input frame data
+ * @out_data: output frame data
+ *
+ * Applies local contrast equalization, updating the tile histograms.
+ */
+static void
+gst_videolevels_transform_clahe (GstVideoLevels * videolevels,
+    guint8 * in_data, guint8 * out_data)
+{
+  GstVideoLevelsClahe *clahe;
+
+  if (!videolevels->clahe || videolevels->clahe_reconfigure) {
+    gst_videolevels_clahe_free (videolevels->clahe);
+    videolevels->clahe = gst_videolevels_clahe_new (videolevels->width,
+        videolevels->height, videolevels->bpp_in,
+        gst_videolevels_input_is_swapped (videolevels), videolevels->bpp_out,
+        gst_videolevels_output_is_swapped (videolevels),
+        videolevels->clahe_tiles_x, videolevels->clahe_tiles_y);
+    videolevels->clahe_reconfigure = FALSE;
+    GST_DEBUG_OBJECT (videolevels, "Equalizing %dx%d tiles",
+        videolevels->clahe->tiles_x, videolevels->clahe->tiles_y);
+  }
+
+  clahe = videolevels->clahe;
+  clahe->clip_limit = videolevels->clahe_clip_limit;
+  clahe->smoothing = videolevels->clahe_smoothing;
+  clahe->subsample_x = videolevels->histogram_subsample_x;
+  clahe->subsample_y = videolevels->histogram_subsample_y;
+  gst_videolevels_get_output_range (videolevels, &clahe->lower_output,
+      &clahe->upper_output);
+
+  gst_videolevels_clahe_process (clahe, videolevels->stripe_pool, in_data,
+      videolevels->stride_in, out_data, videolevels->stride_out);
+}
+
+/**
+ * gst_videolevels_process:
+ * @videolevels: #GstVideoLevels
+ * @buf: input #GstBuffer
+ * @in_data: input frame data
+ * @out_data: output frame data, may be the same as @in_data
+ *
+ * Auto adjusts levels if needed and maps the frame.
+ */
+static void
+gst_videolevels_process (GstVideoLevels * videolevels, GstBuffer * buf,
+    guint8 * in_data, guint8 * out_data)
+{
+  GstClockTimeDiff elapsed;
+  GstVideoLevelsStripeJob job;
+  gboolean adjust = FALSE;
+
+  /* pick up a table published by the worker since the last frame, the table
+   * then stays fixed until the next frame boundary */
+  gst_videolevels_update_lut (videolevels);
+
+  if (videolevels->mode == GST_VIDEOLEVELS_MODE_CLAHE) {
+    gst_videolevels_transform_clahe (videolevels, in_data, out_data);
+    return;
+  }
+
+  if (videolevels->auto_adjust == 1) {
+    GST_DEBUG_OBJECT (videolevels, "Auto adjusting levels (once)");
+    adjust = TRUE;
+    videolevels->auto_adjust = 0;
+    g_object_notify (G_OBJECT (videolevels), "auto");
+  } else if (videolevels->auto_adjust == 2) {
+    elapsed =
+        GST_CLOCK_DIFF (videolevels->last_auto_timestamp,
+        GST_BUFFER_TIMESTAMP (buf));
+    if (videolevels->last_auto_timestamp == GST_CLOCK_TIME_NONE
+        || elapsed >= (GstClockTimeDiff) videolevels->interval || elapsed < 0) {
+      GST_LOG_OBJECT (videolevels, "Auto adjusting levels (%d ns since last)",
+          elapsed);
+      adjust = TRUE;
+      videolevels->last_auto_timestamp = GST_BUFFER_TIMESTAMP (buf);
+    }
+  }
+
+  /* an async analysis may still be running after a mode change */
+  if (adjust && videolevels->auto_mode != GST_VIDEOLEVELS_AUTO_MODE_ASYNC)
+    gst_videolevels_wait_agc (videolevels);
+
+  if (adjust && videolevels->auto_mode == GST_VIDEOLEVELS_AUTO_MODE_ASYNC) {
+    g_mutex_lock (&videolevels->agc_lock);
+    if (videolevels->agc_busy) {
+      GST_LOG_OBJECT (videolevels, "Skipping adjustment, previous one busy");
+    } else {
+      /* the worker reads the ROI, only change it while it's idle */
+      if (videolevels->check_roi) {
+        gst_videolevels_check_roi (videolevels);
+        videolevels->check_roi = FALSE;
+      }
+      if (videolevels->agc_histogram == NULL)
+        videolevels->agc_histogram = g_new (gint, videolevels->nbins);
+      gst_videolevels_agc_snapshot (videolevels, &videolevels->agc_state);
+      videolevels->agc_busy = TRUE;
+      g_thread_pool_push (videolevels->agc_worker, gst_buffer_ref (buf), NULL);
+    }
+    g_mutex_unlock (&videolevels->agc_lock);
+    adjust = FALSE;
+  } else if (adjust
+      && videolevels->auto_mode == GST_VIDEOLEVELS_AUTO_MODE_IMMEDIATE) {
+    gst_videolevels_auto_adjust (videolevels, (guint16 *) in_data);
+    gst_videolevels_post_histogram (videolevels, buf, videolevels->histogram,
+        videolevels->lower_input, videolevels->upper_input);
+    adjust = FALSE;
+  } else if (adjust && videolevels->check_roi) {
+    gst_videolevels_check_roi (videolevels);
+    videolevels->check_roi = FALSE;
+  }
+
+  job.levels = videolevels;
+  job.in_data = in_data;
+  job.out_data = out_data;
+  job.histogram = adjust;
+  gst_stripe_pool_run (videolevels->stripe_pool,
+      gst_videolevels_transform_stripe, &job);
+
+  /* lagged mode, levels from this frame apply from the next frame on */
+  if (adjust) {
+    gst_videolevels_merge_histograms (videolevels);
+    gst_videolevels_adjust_from_histogram (videolevels);
+    gst_videolevels_post_histogram (videolevels, buf, videolevels->histogram,
+        videolevels->lower_input, videolevels->upper_input);
+  }
+}
+
+/**
+ * gst_videolevels_transform:
+ * @base: #GstBaseTransform
+ * @inbuf: #GstBuffer
+ * @outbuf: #GstBuffer
+ *
+ * Transforms input buffer to output buffer.
+ *
+ * Returns: GST_FLOW_OK on success
+ */
+static GstFlowReturn
+gst_videolevels_transform (GstBaseTransform * trans, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstVideoLevels *videolevels = GST_VIDEOLEVELS (trans);
+  GstClockTime start =
+      gst_clock_get_time (gst_element_get_clock (GST_ELEMENT (videolevels)));
+  GstMapInfo inminfo, outminfo;
+
+  GST_LOG_OBJECT (videolevels, "Performing non-inplace transform");
+
+  gst_buffer_map (inbuf, &inminfo, GST_MAP_READ);
+  gst_buffer_map (outbuf, &outminfo, GST_MAP_WRITE);
+
+  if (!inminfo.data || !outminfo.data) {
+    GST_ELEMENT_ERROR (videolevels, STREAM, FAILED, ("Failed to map buffer"),
+        (NULL));
+    return GST_FLOW_ERROR;
+  }
+
+  gst_videolevels_process (videolevels, inbuf, inminfo.data, outminfo.data);
 
   gst_buffer_unmap (inbuf, &inminfo);
   gst_buffer_unmap (outbuf, &outminfo);
@@ -750,6 +1374,45 @@ gst_videolevels_transform (GstBaseTransform * trans, GstBuffer * inbuf,
   return GST_FLOW_OK;
 }
 
+/**
+ * gst_videolevels_transform_ip:
+ * @base: #GstBaseTransform
+ * @buf: #GstBuffer
+ *
+ * Transforms buffer in place, used when input and output formats match.
+ *
+ * Returns: GST_FLOW_OK on success
+ */
+static GstFlowReturn
+gst_videolevels_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstVideoLevels *videolevels = GST_VIDEOLEVELS (trans);
+  GstClockTime start =
+      gst_clock_get_time (gst_element_get_clock (GST_ELEMENT (videolevels)));
+  GstMapInfo minfo;
+
+  GST_LOG_OBJECT (videolevels, "Performing inplace transform");
+
+  gst_buffer_map (buf, &minfo, GST_MAP_READWRITE);
+
+  if (!minfo.data) {
+    GST_ELEMENT_ERROR (videolevels, STREAM, FAILED, ("Failed to map buffer"),
+        (NULL));
+    return GST_FLOW_ERROR;
+  }
+
+  gst_videolevels_process (videolevels, buf, minfo.data, minfo.data);
+
+  gst_buffer_unmap (buf, &minfo);
+
+  GST_LOG_OBJECT (videolevels, "Processing took %" G_GINT64_FORMAT "ms",
+      GST_TIME_AS_MSECONDS (GST_CLOCK_DIFF (start,
+              gst_clock_get_time (gst_element_get_clock (GST_ELEMENT
+                      (videolevels))))));
+
+  return GST_FLOW_OK;
+}
+
 /************************************************************************/
 /* GstVideoLevels method implementations                                */
 /************************************************************************/
@@ -775,8 +1438,25 @@ gst_videolevels_reset (GstVideoLevels * videolevels)
   videolevels->roi_y = DEFAULT_PROP_ROI_Y;
   videolevels->roi_width = DEFAULT_PROP_ROI_WIDTH;
   videolevels->roi_height = DEFAULT_PROP_ROI_HEIGHT;
+  videolevels->n_threads = DEFAULT_PROP_N_THREADS;
+  videolevels->histogram_subsample_x = DEFAULT_PROP_HISTOGRAM_SUBSAMPLE_X;
+  videolevels->histogram_subsample_y = DEFAULT_PROP_HISTOGRAM_SUBSAMPLE_Y;
+  videolevels->mode = DEFAULT_PROP_MODE;
+  videolevels->clahe_tiles_x = DEFAULT_PROP_CLAHE_TILES_X;
+  videolevels->clahe_tiles_y = DEFAULT_PROP_CLAHE_TILES_Y;
+  videolevels->clahe_clip_limit = DEFAULT_PROP_CLAHE_CLIP_LIMIT;
+  videolevels->clahe_smoothing = DEFAULT_PROP_CLAHE_SMOOTHING;
+  videolevels->clahe_reconfigure = TRUE;
+  videolevels->auto_smoothing = DEFAULT_PROP_AUTO_SMOOTHING;
+  videolevels->auto_threshold = DEFAULT_PROP_AUTO_THRESHOLD;
+  videolevels->have_auto_setpoints = FALSE;
+  videolevels->auto_serial = 0;
+  videolevels->histogram_message_interval =
+      DEFAULT_PROP_HISTOGRAM_MESSAGE_INTERVAL;
+  videolevels->histogram_count = 0;
 
   videolevels->auto_adjust = DEFAULT_PROP_AUTO;
+  videolevels->auto_mode = DEFAULT_PROP_AUTO_MODE;
   videolevels->interval = DEFAULT_PROP_INTERVAL;
 
   videolevels->check_roi = TRUE;
@@ -784,97 +1464,333 @@ gst_videolevels_reset (GstVideoLevels * videolevels)
 
   /* if GRAY8, this will be set in set_info */
   videolevels->nbins = 4096;
+  videolevels->bin_shift = 4;
 
   g_free (videolevels->histogram);
   videolevels->histogram = NULL;
+  g_free (videolevels->agc_histogram);
+  videolevels->agc_histogram = NULL;
+  g_free (videolevels->stripe_histograms);
+  videolevels->stripe_histograms = NULL;
 }
 
 #define GINT_CLAMP(x, low, high) ((gint)(CLAMP((x),(low),(high))))
-#define GUINT8_CLAMP(x, low, high) ((guint8)(CLAMP((x),(low),(high))))
 
+/* whether 16-bit input words are in foreign byte order */
 static gboolean
-gst_videolevels_calculate_lut (GstVideoLevels * videolevels)
+gst_videolevels_input_is_swapped (GstVideoLevels * videolevels)
 {
-  gint i;
-  gdouble m;
-  gdouble b;
-  guint8 *lut = (guint8 *) videolevels->lookup_table;
-  const guint16 max_in = (1 << videolevels->bpp_in) - 1;
-  guint16 low_in;
-  guint16 high_in;
-  const guint8 max_out = (1 << videolevels->bpp_out) - 1;
-  const guint8 low_out = videolevels->lower_output;
-  const guint8 high_out = videolevels->upper_output;
+  return (videolevels->endianness_in == G_LITTLE_ENDIAN ||
+      videolevels->endianness_in == G_BIG_ENDIAN) &&
+      videolevels->endianness_in != G_BYTE_ORDER;
+}
+
+/* whether 16-bit output words are in foreign byte order */
+static gboolean
+gst_videolevels_output_is_swapped (GstVideoLevels * videolevels)
+{
+  return videolevels->bpp_out > 8 &&
+      videolevels->endianness_out != G_BYTE_ORDER;
+}
+
+/* atomically replace the pointer at atomic, returning the old value */
+static gpointer
+gst_videolevels_exchange_lut (gpointer * atomic, gpointer newval)
+{
+  gpointer oldval;
+
+  do {
+    oldval = g_atomic_pointer_get (atomic);
+  } while (!g_atomic_pointer_compare_and_exchange (atomic, oldval, newval));
+
+  return oldval;
+}
+
+/**
+ * gst_videolevels_lut_snapshot:
+ * @videolevels: #GstVideoLevels
+ * @lower_input: lower input level, already validated
+ * @upper_input: upper input level, already validated
+ * @lower_output: lower output level, limited to the output depth
+ * @upper_output: upper output level, limited to the output depth
+ *
+ * Take a snapshot of the format for a lookup table mapping the given levels,
+ * without touching the element, so it is safe to call from the workers.
+ *
+ * Returns: a new unbuilt #GstVideoLevelsLut
+ */
+static GstVideoLevelsLut *
+gst_videolevels_lut_snapshot (GstVideoLevels * videolevels, gint lower_input,
+    gint upper_input, gint lower_output, gint upper_output)
+{
+  GstVideoLevelsLut *lut = g_new0 (GstVideoLevelsLut, 1);
+
+  lut->generation = g_atomic_int_add (&videolevels->lut_generation, 1) + 1;
+  lut->bpp_in = videolevels->bpp_in;
+  lut->swap = gst_videolevels_input_is_swapped (videolevels);
+  lut->bpp_out = videolevels->bpp_out;
+  lut->swap_out = gst_videolevels_output_is_swapped (videolevels);
+  lut->lower_input = lower_input;
+  lut->upper_input = upper_input;
+  lut->lower_output = lower_output;
+  lut->upper_output = upper_output;
+
+  return lut;
+}
+
+/**
+ * gst_videolevels_lut_new:
+ * @videolevels: #GstVideoLevels
+ *
+ * Validate the current levels and take a snapshot of everything needed to
+ * build a lookup table, so the table can be built on any thread. Notifies
+ * and updates passthrough, so must not be called from the workers.
+ *
+ * Returns: a new unbuilt #GstVideoLevelsLut, or NULL if caps aren't set
+ */
+static GstVideoLevelsLut *
+gst_videolevels_lut_new (GstVideoLevels * videolevels)
+{
+  const gint max_in = (1 << videolevels->bpp_in) - 1;
+  gboolean lower_changed = FALSE, upper_changed = FALSE;
+  gint lower_output, upper_output;
 
   if (videolevels->bpp_in == 0) {
-    return FALSE;
+    return NULL;
   }
 
-  GST_LOG_OBJECT (videolevels, "Calculating lookup table");
-
+  g_mutex_lock (&videolevels->agc_lock);
   if (videolevels->lower_input < 0 || videolevels->lower_input > max_in) {
     videolevels->lower_input = 0;
-    g_object_notify_by_pspec (G_OBJECT (videolevels), properties[PROP_LOWIN]);
+    lower_changed = TRUE;
   }
   if (videolevels->upper_input < 0 || videolevels->upper_input > max_in) {
     videolevels->upper_input = max_in;
-    g_object_notify_by_pspec (G_OBJECT (videolevels), properties[PROP_HIGHIN]);
+    upper_changed = TRUE;
   }
+  g_mutex_unlock (&videolevels->agc_lock);
 
+  if (lower_changed)
+    g_object_notify_by_pspec (G_OBJECT (videolevels), properties[PROP_LOWIN]);
+  if (upper_changed)
+    g_object_notify_by_pspec (G_OBJECT (videolevels), properties[PROP_HIGHIN]);
   gst_videolevels_check_passthrough (videolevels);
 
-  if (!videolevels->passthrough) {
-    low_in = videolevels->lower_input;
-    high_in = videolevels->upper_input;
-
-    GST_LOG_OBJECT (videolevels, "Make linear LUT mapping (%d, %d) -> (%d, %d)",
-        low_in, high_in, low_out, high_out);
+  gst_videolevels_get_output_range (videolevels, &lower_output, &upper_output);
 
-    if (low_in == high_in)
-      m = 0.0;
-    else
-      m = (high_out - low_out) / (gdouble) (high_in - low_in);
+  return gst_videolevels_lut_snapshot (videolevels, videolevels->lower_input,
+      videolevels->upper_input, lower_output, upper_output);
+}
 
-    b = low_out - m * low_in;
+/**
+ * gst_videolevels_calculate_lut:
+ * @videolevels: #GstVideoLevels
+ *
+ * Build a lookup table from the current levels and use it right away. Must
+ * only be called from the streaming thread.
+ *
+ * Returns: TRUE on success
+ */
+static gboolean
+gst_videolevels_calculate_lut (GstVideoLevels * videolevels)
+{
+  GstVideoLevelsLut *lut = gst_videolevels_lut_new (videolevels);
 
-    if (videolevels->endianness_in == G_LITTLE_ENDIAN)
-      for (i = 0; i < G_MAXUINT16; i++)
-        lut[i] = GUINT8_CLAMP (m * GUINT16_FROM_LE (i) + b, low_out, high_out);
-    else if (videolevels->endianness_in == G_BIG_ENDIAN)
-      for (i = 0; i < G_MAXUINT16; i++)
-        lut[i] = GUINT8_CLAMP (m * GUINT16_FROM_BE (i) + b, low_out, high_out);
-    else
-      for (i = 0; i < G_MAXUINT16; i++)
-        lut[i] = GUINT8_CLAMP (m * i + b, low_out, high_out);
+  if (!lut) {
+    return FALSE;
   }
 
+  GST_LOG_OBJECT (videolevels, "Make linear LUT mapping (%d, %d) -> (%d, %d)",
+      lut->lower_input, lut->upper_input, lut->lower_output,
+      lut->upper_output);
+
+  gst_videolevels_lut_build (lut, gst_simd_get_level ());
+
+  GST_LOG_OBJECT (videolevels, "Using %s kernel",
+      lut->linear_func ? gst_simd_get_name (gst_simd_get_level ()) : "LUT");
+
+  /* any table still pending is older than this one */
+  gst_videolevels_lut_free (videolevels->lut);
+  videolevels->lut = lut;
+
   return TRUE;
 }
 
+/**
+ * gst_videolevels_request_lut:
+ * @videolevels: #GstVideoLevels
+ *
+ * Build a lookup table from the current levels on the worker thread. The
+ * streaming thread switches to it at the next frame boundary.
+ */
+static void
+gst_videolevels_request_lut (GstVideoLevels * videolevels)
+{
+  GstVideoLevelsLut *lut = gst_videolevels_lut_new (videolevels);
+
+  if (!lut) {
+    return;
+  }
+
+  GST_LOG_OBJECT (videolevels, "Requesting LUT %d mapping (%d, %d) -> (%d, %d)",
+      lut->generation, lut->lower_input, lut->upper_input, lut->lower_output,
+      lut->upper_output);
+
+  g_thread_pool_push (videolevels->lut_worker, lut, NULL);
+}
+
+static void
+gst_videolevels_lut_worker (gpointer data, gpointer user_data)
+{
+  GstVideoLevelsLut *lut = (GstVideoLevelsLut *) data;
+  GstVideoLevels *videolevels = GST_VIDEOLEVELS (user_data);
+
+  /* skip tables that a newer request has already superseded */
+  if (lut->generation != g_atomic_int_get (&videolevels->lut_generation)) {
+    gst_videolevels_lut_free (lut);
+    return;
+  }
+
+  gst_videolevels_lut_build (lut, gst_simd_get_level ());
+
+  gst_videolevels_lut_free (gst_videolevels_exchange_lut
+      (&videolevels->pending_lut, lut));
+}
+
+/**
+ * gst_videolevels_update_lut:
+ * @videolevels: #GstVideoLevels
+ *
+ * Switch to the most recently published lookup table, if any. Called by the
+ * streaming thread at frame boundaries.
+ */
+static void
+gst_videolevels_update_lut (GstVideoLevels * videolevels)
+{
+  GstVideoLevelsLut *lut =
+      gst_videolevels_exchange_lut (&videolevels->pending_lut, NULL);
+
+  if (!lut) {
+    return;
+  }
+
+  if (videolevels->lut && lut->generation < videolevels->lut->generation) {
+    /* built from levels that were replaced before it got published */
+    gst_videolevels_lut_free (lut);
+    return;
+  }
+
+  GST_LOG_OBJECT (videolevels, "Switching to LUT %d", lut->generation);
+
+  gst_videolevels_lut_free (videolevels->lut);
+  videolevels->lut = lut;
+
+  /* levels from the async analysis only take effect with their table */
+  if (lut->auto_levels) {
+    g_mutex_lock (&videolevels->agc_lock);
+    videolevels->lower_input = lut->lower_input;
+    videolevels->upper_input = lut->upper_input;
+    g_mutex_unlock (&videolevels->agc_lock);
+    gst_videolevels_check_passthrough (videolevels);
+    g_object_notify_by_pspec (G_OBJECT (videolevels), properties[PROP_LOWIN]);
+    g_object_notify_by_pspec (G_OBJECT (videolevels), properties[PROP_HIGHIN]);
+  }
+}
+
+
+/**
+* gst_videolevels_calculate_histogram_rows
+* @videolevels: #GstVideoLevels
+* @data: input frame data
+* @hist: histogram to accumulate into
+* @row_start: first ROI row to process
+* @row_end: row after the last ROI row to process
+*
+* Accumulate histogram of the ROI columns within a range of rows
+*/
+static void
+gst_videolevels_calculate_histogram_rows (GstVideoLevels * videolevels,
+    guint16 * data, gint * hist, gint row_start, gint row_end)
+{
+  GstVideoLevelsHistParams params;
+
+  params.stride = videolevels->stride_in;
+  params.sixteen = videolevels->bpp_in > 8;
+  params.swap = gst_videolevels_input_is_swapped (videolevels);
+  params.shift = videolevels->bin_shift;
+  params.nbins = videolevels->nbins;
+  params.x = videolevels->roi_x;
+  params.width = videolevels->roi_width;
+  params.y = videolevels->roi_y;
+  params.step_x = videolevels->histogram_subsample_x;
+  params.step_y = videolevels->histogram_subsample_y;
+
+  gst_videolevels_histogram_rows (&params, (const guint8 *) data, hist,
+      row_start, row_end);
+}
+
+static void
+gst_videolevels_histogram_stripe (gpointer user_data, guint stripe,
+    guint n_stripes)
+{
+  GstVideoLevelsStripeJob *job = (GstVideoLevelsStripeJob *) user_data;
+  GstVideoLevels *videolevels = job->levels;
+  gint *hist = videolevels->stripe_histograms + stripe * videolevels->nbins;
+  gint row_start, row_end;
+
+  gst_stripe_get_rows (stripe, n_stripes, videolevels->roi_height, &row_start,
+      &row_end);
+
+  memset (hist, 0, sizeof (gint) * videolevels->nbins);
+  gst_videolevels_calculate_histogram_rows (videolevels,
+      (guint16 *) job->in_data, hist, videolevels->roi_y + row_start,
+      videolevels->roi_y + row_end);
+}
 
 /**
 * gst_videolevels_calculate_histogram
 * @videolevels: #GstVideoLevels
 * @data: input frame data
 *
-* Calculate histogram of input frame
+* Calculate histogram of input frame, merging the partial histograms of all
+* stripes
 *
 * Returns: TRUE on success
 */
 gboolean
 gst_videolevels_calculate_histogram (GstVideoLevels * videolevels,
     guint16 * data)
+{
+  GstVideoLevelsStripeJob job;
+
+  GST_LOG_OBJECT (videolevels, "Calculating histogram");
+
+  job.levels = videolevels;
+  job.in_data = (guint8 *) data;
+  job.out_data = NULL;
+  job.histogram = TRUE;
+  gst_stripe_pool_run (videolevels->stripe_pool,
+      gst_videolevels_histogram_stripe, &job);
+
+  gst_videolevels_merge_histograms (videolevels);
+
+  return TRUE;
+}
+
+/**
+* gst_videolevels_merge_histograms
+* @videolevels: #GstVideoLevels
+*
+* Sum the partial histograms of all stripes into the frame histogram
+*/
+static void
+gst_videolevels_merge_histograms (GstVideoLevels * videolevels)
 {
   gint *hist;
   gint nbins = videolevels->nbins;
-  gint r;
-  gint c;
-  gfloat factor;
-  gint stride = videolevels->stride_in;
-  gint endianness = videolevels->endianness_in;
-  gint maxVal = (1 << videolevels->bpp_in) - 1;
-
-  factor = (gfloat) ((nbins - 1.0) / maxVal);
+  guint n_stripes = videolevels->stripe_pool->n_threads;
+  guint i;
+  gint j;
 
   if (videolevels->histogram == NULL) {
     GST_DEBUG_OBJECT (videolevels,
@@ -884,45 +1800,16 @@ gst_videolevels_calculate_histogram (GstVideoLevels * videolevels,
 
   hist = videolevels->histogram;
 
-  /* reset histogram */
-  memset (hist, 0, sizeof (gint) * nbins);
-
-  GST_LOG_OBJECT (videolevels, "Calculating histogram");
-  if (videolevels->bpp_in > 8) {
-    if (endianness == G_BYTE_ORDER) {
-      for (r = videolevels->roi_y;
-          r < videolevels->roi_y + videolevels->roi_height; r++) {
-        for (c = videolevels->roi_x;
-            c < videolevels->roi_x + videolevels->roi_width; c++) {
-          hist[GINT_CLAMP (data[c + r * stride / 2] * factor, 0, nbins - 1)]++;
-        }
-      }
-    } else {
-      for (r = videolevels->roi_y;
-          r < videolevels->roi_y + videolevels->roi_height; r++) {
-        for (c = videolevels->roi_x;
-            c < videolevels->roi_x + videolevels->roi_width; c++) {
-          hist[GINT_CLAMP (GUINT16_FROM_BE (data[c + r * stride / 2]) * factor,
-                  0, nbins - 1)]++;
-        }
-      }
-    }
-  } else {
-    guint8 *data8 = (guint8 *) data;
-    for (r = videolevels->roi_y;
-        r < videolevels->roi_y + videolevels->roi_height; r++) {
-      for (c = videolevels->roi_x;
-          c < videolevels->roi_x + videolevels->roi_width; c++) {
-        hist[GINT_CLAMP (data8[c + r * stride / 2] * factor, 0, nbins - 1)]++;
-      }
-    }
+  memcpy (hist, videolevels->stripe_histograms, sizeof (gint) * nbins);
+  for (i = 1; i < n_stripes; i++) {
+    const gint *partial = videolevels->stripe_histograms + i * nbins;
+    for (j = 0; j < nbins; j++)
+      hist[j] += partial[j];
   }
-
-  return TRUE;
 }
 
 
-void
+static void
 gst_videolevels_check_roi (GstVideoLevels * filt)
 {
   GST_DEBUG_OBJECT (filt, "ROI before check is (%d, %d, %d, %d)", filt->roi_x,
@@ -964,6 +1851,162 @@ gst_videolevels_check_roi (GstVideoLevels * filt)
 */
 gboolean
 gst_videolevels_auto_adjust (GstVideoLevels * filt, guint16 * data)
+{
+  if (filt->check_roi) {
+    gst_videolevels_check_roi (filt);
+    filt->check_roi = FALSE;
+  }
+
+  gst_videolevels_calculate_histogram (filt, data);
+
+  gst_videolevels_adjust_from_histogram (filt);
+
+  return TRUE;
+}
+
+/**
+* gst_videolevels_agc_worker
+* @data: #GstBuffer to analyze, owned by the worker
+* @user_data: #GstVideoLevels
+*
+* Compute the histogram and levels of a frame on the worker thread, and
+* request a lookup table for them, so the streaming thread only ever maps
+* frames. Works from agc_state and agc_histogram, never from the fields the
+* streaming thread and properties update.
+*/
+static void
+gst_videolevels_agc_worker (gpointer data, gpointer user_data)
+{
+  GstBuffer *buf = GST_BUFFER (data);
+  GstVideoLevels *videolevels = GST_VIDEOLEVELS (user_data);
+  GstVideoLevelsAgcState *state = &videolevels->agc_state;
+  gint *hist = videolevels->agc_histogram;
+  GstMapInfo minfo;
+  gint lower, upper;
+
+  if (gst_buffer_map (buf, &minfo, GST_MAP_READ)) {
+    memset (hist, 0, sizeof (gint) * videolevels->nbins);
+    gst_videolevels_calculate_histogram_rows (videolevels,
+        (guint16 *) minfo.data, hist, videolevels->roi_y,
+        videolevels->roi_y + videolevels->roi_height);
+    gst_buffer_unmap (buf, &minfo);
+
+    if (gst_videolevels_levels_from_histogram (videolevels, hist, state,
+            &lower, &upper)) {
+      /* only publish a table, the streaming thread adopts its levels */
+      GstVideoLevelsLut *lut = gst_videolevels_lut_snapshot (videolevels,
+          lower, upper, state->lower_output, state->upper_output);
+
+      lut->auto_levels = TRUE;
+      GST_LOG_OBJECT (videolevels, "Requesting LUT %d for (%d, %d)",
+          lut->generation, lower, upper);
+      g_thread_pool_push (videolevels->lut_worker, lut, NULL);
+    }
+    gst_videolevels_agc_store (videolevels, state);
+
+    /* the levels chosen from this frame, not the ones still in use */
+    gst_videolevels_post_histogram (videolevels, buf, hist, lower, upper);
+  } else {
+    GST_WARNING_OBJECT (videolevels, "Failed to map buffer for analysis");
+  }
+
+  gst_buffer_unref (buf);
+
+  g_mutex_lock (&videolevels->agc_lock);
+  videolevels->agc_busy = FALSE;
+  g_cond_broadcast (&videolevels->agc_cond);
+  g_mutex_unlock (&videolevels->agc_lock);
+}
+
+/* block until no frame is being analyzed asynchronously */
+static void
+gst_videolevels_wait_agc (GstVideoLevels * videolevels)
+{
+  g_mutex_lock (&videolevels->agc_lock);
+  while (videolevels->agc_busy)
+    g_cond_wait (&videolevels->agc_cond, &videolevels->agc_lock);
+  g_mutex_unlock (&videolevels->agc_lock);
+}
+
+/* run in place when the layout allows, except when the input is needed
+ * after the frame is mapped */
+static void
+gst_videolevels_update_in_place (GstVideoLevels * videolevels)
+{
+  gst_base_transform_set_in_place (GST_BASE_TRANSFORM (videolevels),
+      videolevels->same_layout &&
+      videolevels->auto_mode != GST_VIDEOLEVELS_AUTO_MODE_ASYNC);
+}
+
+/**
+* gst_videolevels_agc_snapshot
+* @videolevels: #GstVideoLevels
+* @state: (out): #GstVideoLevelsAgcState
+*
+* Copy the level state auto adjustment works from. Must be called with
+* agc_lock held.
+*/
+static void
+gst_videolevels_agc_snapshot (GstVideoLevels * videolevels,
+    GstVideoLevelsAgcState * state)
+{
+  state->serial = videolevels->auto_serial;
+  state->auto_adjust = videolevels->auto_adjust;
+  state->lower_pix_sat = videolevels->lower_pix_sat;
+  state->upper_pix_sat = videolevels->upper_pix_sat;
+  state->auto_smoothing = videolevels->auto_smoothing;
+  state->auto_threshold = videolevels->auto_threshold;
+  state->lower_input = videolevels->lower_input;
+  state->upper_input = videolevels->upper_input;
+  gst_videolevels_get_output_range (videolevels, &state->lower_output,
+      &state->upper_output);
+  state->auto_lower = videolevels->auto_lower;
+  state->auto_upper = videolevels->auto_upper;
+  state->have_auto_setpoints = videolevels->have_auto_setpoints;
+}
+
+/* store the setpoints updated from a snapshot, unless they were reset since
+ * the snapshot was taken */
+static void
+gst_videolevels_agc_store (GstVideoLevels * videolevels,
+    const GstVideoLevelsAgcState * state)
+{
+  g_mutex_lock (&videolevels->agc_lock);
+  if (state->serial == videolevels->auto_serial) {
+    videolevels->auto_lower = state->auto_lower;
+    videolevels->auto_upper = state->auto_upper;
+    videolevels->have_auto_setpoints = state->have_auto_setpoints;
+  }
+  g_mutex_unlock (&videolevels->agc_lock);
+}
+
+/* start continuous auto over from the next histogram */
+static void
+gst_videolevels_reset_setpoints (GstVideoLevels * videolevels)
+{
+  g_mutex_lock (&videolevels->agc_lock);
+  videolevels->have_auto_setpoints = FALSE;
+  videolevels->auto_serial++;
+  g_mutex_unlock (&videolevels->agc_lock);
+}
+
+/**
+* gst_videolevels_levels_from_histogram
+* @filt: #GstVideoLevels
+* @histogram: histogram of the ROI
+* @state: level state, whose setpoints are updated in continuous auto
+* @lower: (out): lower input level
+* @upper: (out): upper input level
+*
+* Calculate lower and upper levels from a histogram. Only the format is read
+* from the element, so it is safe to call from the async worker.
+*
+* Returns: FALSE if the levels stay the current ones of @state
+*/
+static gboolean
+gst_videolevels_levels_from_histogram (GstVideoLevels * filt,
+    const gint * histogram, GstVideoLevelsAgcState * state, gint * lower,
+    gint * upper)
 {
   guint npixsat;
   guint sum;
@@ -971,58 +2014,184 @@ gst_videolevels_auto_adjust (GstVideoLevels * filt, guint16 * data)
   gint pixel_count;
   gint minVal = 0;
   gint maxVal = (1 << filt->bpp_in) - 1;
-  float factor = maxVal / (filt->nbins - 1.0f);
+  gint shift = filt->bin_shift;
 
-  if (filt->check_roi) {
-    gst_videolevels_check_roi (filt);
-    filt->check_roi = FALSE;
-  }
-
-  gst_videolevels_calculate_histogram (filt, data);
+  *lower = state->lower_input;
+  *upper = state->upper_input;
 
-  pixel_count = filt->roi_width * filt->roi_height;
+  /* count samples rather than ROI pixels, since the ROI may be subsampled */
+  pixel_count = 0;
+  for (i = 0; i < filt->nbins; i++)
+    pixel_count += histogram[i];
 
   /* pixels to saturate on low end */
-  npixsat = (guint) (filt->lower_pix_sat * pixel_count);
+  npixsat = (guint) (state->lower_pix_sat * pixel_count);
   sum = 0;
   for (i = 0; i < filt->nbins; i++) {
-    sum += filt->histogram[i];
+    sum += histogram[i];
     if (sum > npixsat) {
-      filt->lower_input = (gint) CLAMP (i * factor, minVal, maxVal);
+      *lower = CLAMP (i << shift, minVal, maxVal);
       break;
     }
   }
 
   /* pixels to saturate on high end */
-  npixsat = (guint) (filt->upper_pix_sat * pixel_count);
+  npixsat = (guint) (state->upper_pix_sat * pixel_count);
   sum = 0;
   for (i = filt->nbins - 1; i >= 0; i--) {
-    sum += filt->histogram[i];
+    sum += histogram[i];
     if (sum > npixsat) {
-      filt->upper_input = (gint) CLAMP (i * factor, minVal, maxVal);
+      *upper = CLAMP (((i + 1) << shift) - 1, minVal, maxVal);
       break;
     }
   }
 
-  gst_videolevels_calculate_lut (filt);
+  if (state->auto_adjust == GST_VIDEOLEVELS_AUTO_CONTINUOUS) {
+    /* follow the histogram with an exponential moving average */
+    if (state->have_auto_setpoints) {
+      const gdouble a = state->auto_smoothing;
+      state->auto_lower = a * state->auto_lower + (1.0 - a) * *lower;
+      state->auto_upper = a * state->auto_upper + (1.0 - a) * *upper;
+    } else {
+      state->auto_lower = *lower;
+      state->auto_upper = *upper;
+      state->have_auto_setpoints = TRUE;
+    }
+    *lower = (gint) (state->auto_lower + 0.5);
+    *upper = (gint) (state->auto_upper + 0.5);
+
+    /* dead band, small moves aren't worth a new table and notifications */
+    if (ABS (*lower - state->lower_input) <= state->auto_threshold &&
+        ABS (*upper - state->upper_input) <= state->auto_threshold) {
+      GST_LOG_OBJECT (filt, "Keeping levels (%d, %d), setpoints (%d, %d)",
+          state->lower_input, state->upper_input, *lower, *upper);
+      *lower = state->lower_input;
+      *upper = state->upper_input;
+      return FALSE;
+    }
+  }
 
   GST_LOG_OBJECT (filt, "Contrast stretch with npixsat=%d, (%d, %d)",
-      npixsat, filt->lower_input, filt->upper_input);
+      npixsat, *lower, *upper);
+
+  return TRUE;
+}
+
+/**
+* gst_videolevels_adjust_from_histogram
+* @filt: #GstVideoLevels
+*
+* Calculate levels from the frame histogram and switch to them at once,
+* on the streaming thread
+*/
+static void
+gst_videolevels_adjust_from_histogram (GstVideoLevels * filt)
+{
+  GstVideoLevelsAgcState state;
+  gint lower, upper;
+  gboolean changed;
+
+  g_mutex_lock (&filt->agc_lock);
+  gst_videolevels_agc_snapshot (filt, &state);
+  g_mutex_unlock (&filt->agc_lock);
+
+  changed = gst_videolevels_levels_from_histogram (filt, filt->histogram,
+      &state, &lower, &upper);
+  gst_videolevels_agc_store (filt, &state);
+  if (!changed)
+    return;
+
+  g_mutex_lock (&filt->agc_lock);
+  filt->lower_input = lower;
+  filt->upper_input = upper;
+  g_mutex_unlock (&filt->agc_lock);
+
+  gst_videolevels_calculate_lut (filt);
 
   g_object_notify_by_pspec (G_OBJECT (filt), properties[PROP_LOWIN]);
   g_object_notify_by_pspec (G_OBJECT (filt), properties[PROP_HIGHIN]);
+}
 
-  return TRUE;
+/**
+ * gst_videolevels_post_histogram:
+ * @videolevels: #GstVideoLevels
+ * @buf: #GstBuffer the histogram was computed from
+ * @histogram: histogram of the ROI of @buf
+ * @lower_input: lower input level chosen from @histogram
+ * @upper_input: upper input level chosen from @histogram
+ *
+ * Post a histogram and the levels chosen from it as an element message, if
+ * enabled, so applications can reuse it instead of scanning the frame
+ * again. The "histogram" field holds one gint count per bin, and each bin
+ * covers 2^bin-shift input values.
+ */
+static void
+gst_videolevels_post_histogram (GstVideoLevels * videolevels, GstBuffer * buf,
+    const gint * histogram, gint lower_input, gint upper_input)
+{
+  GstStructure *st;
+  GBytes *bytes;
+  gboolean post;
+
+  g_mutex_lock (&videolevels->agc_lock);
+  post = videolevels->histogram_message_interval > 0 &&
+      ++videolevels->histogram_count >=
+      videolevels->histogram_message_interval;
+  if (post)
+    videolevels->histogram_count = 0;
+  g_mutex_unlock (&videolevels->agc_lock);
+
+  if (!post)
+    return;
+
+  bytes = g_bytes_new (histogram, videolevels->nbins * sizeof (gint));
+
+  st = gst_structure_new ("videolevels-histogram",
+      "timestamp", GST_TYPE_CLOCK_TIME, GST_BUFFER_TIMESTAMP (buf),
+      "roi-x", G_TYPE_INT, videolevels->roi_x,
+      "roi-y", G_TYPE_INT, videolevels->roi_y,
+      "roi-width", G_TYPE_INT, videolevels->roi_width,
+      "roi-height", G_TYPE_INT, videolevels->roi_height,
+      "subsample-x", G_TYPE_UINT, videolevels->histogram_subsample_x,
+      "subsample-y", G_TYPE_UINT, videolevels->histogram_subsample_y,
+      "lower-input-level", G_TYPE_INT, lower_input,
+      "upper-input-level", G_TYPE_INT, upper_input,
+      "num-bins", G_TYPE_INT, videolevels->nbins,
+      "bin-shift", G_TYPE_INT, videolevels->bin_shift,
+      "histogram", G_TYPE_BYTES, bytes, NULL);
+  g_bytes_unref (bytes);
+
+  gst_element_post_message (GST_ELEMENT (videolevels),
+      gst_message_new_element (GST_OBJECT (videolevels), st));
+}
+
+/* output levels limited to the negotiated depth, leaving the properties as
+ * set so they still apply if caps change to a deeper format */
+static void
+gst_videolevels_get_output_range (GstVideoLevels * levels, gint * lower,
+    gint * upper)
+{
+  /* before caps are set there's nothing to clamp to */
+  const gint max_out = levels->bpp_out ? (1 << levels->bpp_out) - 1 :
+      G_MAXUINT16;
+
+  *lower = levels->lower_output > max_out ? 0 : levels->lower_output;
+  *upper = MIN (levels->upper_output, max_out);
 }
 
 static void
 gst_videolevels_check_passthrough (GstVideoLevels * levels)
 {
   gboolean passthrough;
-  if (levels->bpp_in == 8 &&
+  gint lower_output, upper_output;
+
+  gst_videolevels_get_output_range (levels, &lower_output, &upper_output);
+  if (levels->bpp_in == levels->bpp_out &&
+      gst_base_transform_is_in_place (GST_BASE_TRANSFORM (levels)) &&
+      levels->mode == GST_VIDEOLEVELS_MODE_LINEAR &&
       levels->auto_adjust == GST_VIDEOLEVELS_AUTO_OFF &&
-      levels->lower_input == levels->lower_output &&
-      levels->upper_input == levels->upper_output) {
+      levels->lower_input == lower_output &&
+      levels->upper_input == upper_output) {
     passthrough = TRUE;
   } else {
     passthrough = FALSE;
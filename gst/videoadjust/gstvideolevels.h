@@ -28,6 +28,11 @@
 #include <gst/base/gstbasetransform.h>
 #include <gst/video/video.h>
 
+#include "gstvideolevelshist.h"
+#include "gstvideolevelslut.h"
+#include "gstvideolevelsclahe.h"
+#include "stripepool.h"
+
 G_BEGIN_DECLS
 
 #define GST_TYPE_VIDEOLEVELS \
@@ -58,6 +63,77 @@ typedef enum {
   GST_VIDEOLEVELS_AUTO_CONTINUOUS
 } GstVideoLevelsAuto;
 
+/**
+* GstVideoLevelsAutoMode:
+* @GST_VIDEOLEVELS_AUTO_MODE_IMMEDIATE: compute levels from a frame and apply
+*   them to that same frame, reading the frame twice
+* @GST_VIDEOLEVELS_AUTO_MODE_LAGGED: build the histogram of a frame in the
+*   same pass that applies the current levels, new levels take effect on the
+*   next frame
+* @GST_VIDEOLEVELS_AUTO_MODE_ASYNC: build the histogram and choose levels on
+*   a worker thread holding a reference to the frame, new levels take effect
+*   on the first frame after they are ready
+*
+* How auto adjustment is scheduled relative to the frames it is applied to.
+*/
+typedef enum {
+  GST_VIDEOLEVELS_AUTO_MODE_IMMEDIATE,
+  GST_VIDEOLEVELS_AUTO_MODE_LAGGED,
+  GST_VIDEOLEVELS_AUTO_MODE_ASYNC
+} GstVideoLevelsAutoMode;
+
+/**
+* GstVideoLevelsMode:
+* @GST_VIDEOLEVELS_MODE_LINEAR: map the input levels linearly to the output
+*   levels over the whole frame
+* @GST_VIDEOLEVELS_MODE_CLAHE: contrast limited adaptive histogram
+*   equalization, mapping each region of the frame by its own histogram
+*
+* How input values are mapped to output values.
+*/
+typedef enum {
+  GST_VIDEOLEVELS_MODE_LINEAR,
+  GST_VIDEOLEVELS_MODE_CLAHE
+} GstVideoLevelsMode;
+
+/**
+* GstVideoLevelsAgcState:
+* @serial: value of auto_serial when the state was copied
+* @auto_adjust: auto adjustment mode
+* @lower_pix_sat: fraction of pixels to saturate at the low end
+* @upper_pix_sat: fraction of pixels to saturate at the high end
+* @auto_smoothing: weight of the previous setpoints in continuous auto
+* @auto_threshold: dead band around the current levels in continuous auto
+* @lower_input: current lower input level, the center of the dead band
+* @upper_input: current upper input level
+* @lower_output: lower output level, limited to the output depth
+* @upper_output: upper output level, limited to the output depth
+* @auto_lower: smoothed lower setpoint
+* @auto_upper: smoothed upper setpoint
+* @have_auto_setpoints: whether the setpoints have been initialized
+*
+* The level state auto adjustment works from, copied under agc_lock so that
+* the async worker never reads fields the streaming thread or the
+* application may be writing.
+*/
+typedef struct {
+  guint serial;
+  GstVideoLevelsAuto auto_adjust;
+  gfloat lower_pix_sat;
+  gfloat upper_pix_sat;
+  gdouble auto_smoothing;
+  gint auto_threshold;
+
+  gint lower_input;
+  gint upper_input;
+  gint lower_output;
+  gint upper_output;
+
+  gdouble auto_lower;
+  gdouble auto_upper;
+  gboolean have_auto_setpoints;
+} GstVideoLevelsAgcState;
+
 /**
 * GstVideoLevels:
 * @element: the parent element.
@@ -75,6 +151,7 @@ struct _GstVideoLevels
   gint bpp_in;
   gint bpp_out;
   gint endianness_in;
+  gint endianness_out;
   gint stride_in;
   gint stride_out;
 
@@ -89,19 +166,67 @@ struct _GstVideoLevels
   gint roi_y;
   gint roi_width;
   gint roi_height;
+  guint n_threads;
+  guint histogram_subsample_x;
+  guint histogram_subsample_y;
 
-  /* tables */
-  gpointer lookup_table;
+  /* tables, lut is only touched by the streaming thread, pending_lut is
+   * exchanged atomically with lut_worker which builds requested tables */
+  GstVideoLevelsLut *lut;
+  gpointer pending_lut;
+  gint lut_generation;
+  GThreadPool *lut_worker;
 
   GstVideoLevelsAuto auto_adjust;
+  GstVideoLevelsAutoMode auto_mode;
   guint64 interval;
   gboolean check_roi;
   gint nbins;
+  gint bin_shift;
   gint * histogram;
 
   guint64 last_auto_timestamp;
 
+  /* continuous auto, levels only follow the smoothed setpoints once they
+   * leave the dead band. Setpoints are protected by agc_lock, and
+   * auto_serial counts resets so stale ones aren't stored back. */
+  gdouble auto_smoothing;
+  gint auto_threshold;
+  gdouble auto_lower;
+  gdouble auto_upper;
+  gboolean have_auto_setpoints;
+  guint auto_serial;
+
+  /* async auto adjustment, a single frame at a time is analyzed by agc_worker
+   * while agc_busy is set, during which it owns agc_state, copied when the
+   * frame was queued, and agc_histogram */
+  GThreadPool *agc_worker;
+  GMutex agc_lock;
+  GCond agc_cond;
+  gboolean agc_busy;
+  GstVideoLevelsAgcState agc_state;
+  gint *agc_histogram;
+
+  /* post every Nth histogram as an element message, 0 to disable,
+   * histogram_count is protected by agc_lock */
+  guint histogram_message_interval;
+  guint histogram_count;
+
+  /* workers processing horizontal stripes, one partial histogram each */
+  GstStripePool *stripe_pool;
+  gint *stripe_histograms;
+
+  /* local contrast, recreated when tiles or caps change */
+  GstVideoLevelsMode mode;
+  gint clahe_tiles_x;
+  gint clahe_tiles_y;
+  gdouble clahe_clip_limit;
+  gdouble clahe_smoothing;
+  GstVideoLevelsClahe *clahe;
+  gboolean clahe_reconfigure;
+
   gboolean passthrough;
+  gboolean same_layout;
 };
 
 struct _GstVideoLevelsClass
@@ -0,0 +1,339 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Contrast limited adaptive histogram equalization for videolevels.
+ *
+ * Each frame is processed in two parallel passes. The first splits the tile
+ * rows between threads, each of which histograms its tiles, blends them into
+ * the running histograms and builds the tile tables, so no merging is
+ * needed. The second splits the pixel rows between threads and blends the
+ * four nearest tile tables with 8-bit fixed point weights.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "gstvideolevelsclahe.h"
+
+/* find the two tiles whose centers surround each pixel along one axis */
+static void
+clahe_setup_axis (gint length, gint n_tiles, gint * bounds, gint * tile0,
+    gint * tile1, gint * weight)
+{
+  gint i, x;
+
+  for (i = 0; i <= n_tiles; i++)
+    bounds[i] = (gint) ((gint64) length * i / n_tiles);
+
+#define TILE_CENTER(i) ((bounds[(i)] + bounds[(i) + 1] - 1) / 2.0)
+
+  i = 0;
+  for (x = 0; x < length; x++) {
+    while (i < n_tiles - 1 && x >= TILE_CENTER (i + 1))
+      i++;
+
+    if (x <= TILE_CENTER (0) || i == n_tiles - 1) {
+      /* borders only use the nearest tile */
+      tile0[x] = tile1[x] = i;
+      weight[x] = 0;
+    } else {
+      gdouble c0 = TILE_CENTER (i);
+      gdouble c1 = TILE_CENTER (i + 1);
+      tile0[x] = i;
+      tile1[x] = i + 1;
+      weight[x] = (gint) ((x - c0) / (c1 - c0) * 256 + 0.5);
+    }
+  }
+
+#undef TILE_CENTER
+}
+
+/**
+ * gst_videolevels_clahe_new:
+ * @width: frame width
+ * @height: frame height
+ * @bpp_in: significant bits of input pixels
+ * @swap: whether 16-bit input words are byte swapped
+ * @bpp_out: bits of output pixels, 8 or 16
+ * @swap_out: whether 16-bit output words are byte swapped
+ * @tiles_x: number of tile columns
+ * @tiles_y: number of tile rows
+ *
+ * Allocate everything needed to process frames of the given size, so
+ * nothing is allocated per frame. Tiles are limited to one per pixel.
+ *
+ * Returns: a new #GstVideoLevelsClahe
+ */
+GstVideoLevelsClahe *
+gst_videolevels_clahe_new (gint width, gint height, gint bpp_in,
+    gboolean swap, gint bpp_out, gboolean swap_out, gint tiles_x,
+    gint tiles_y)
+{
+  GstVideoLevelsClahe *clahe;
+  gint n_tiles, x;
+
+  g_return_val_if_fail (width > 0 && height > 0, NULL);
+
+  clahe = g_new0 (GstVideoLevelsClahe, 1);
+
+  clahe->width = width;
+  clahe->height = height;
+  clahe->bpp_in = bpp_in;
+  clahe->swap = swap;
+  clahe->bpp_out = bpp_out;
+  clahe->swap_out = swap_out;
+  clahe->tiles_x = CLAMP (tiles_x, 1, width);
+  clahe->tiles_y = CLAMP (tiles_y, 1, height);
+  clahe->nbins = MIN (4096, 1 << bpp_in);
+  clahe->bin_shift = MAX (0, bpp_in - 12);
+
+  clahe->clip_limit = 0;
+  clahe->smoothing = 0;
+  clahe->subsample_x = 1;
+  clahe->subsample_y = 1;
+  clahe->lower_output = 0;
+  clahe->upper_output = (1 << bpp_out) - 1;
+
+  clahe->tile_x = g_new (gint, clahe->tiles_x + 1);
+  clahe->tile_y = g_new (gint, clahe->tiles_y + 1);
+  clahe->col_offset0 = g_new (gint, width);
+  clahe->col_offset1 = g_new (gint, width);
+  clahe->col_weight = g_new (gint, width);
+  clahe->row_tile0 = g_new (gint, height);
+  clahe->row_tile1 = g_new (gint, height);
+  clahe->row_weight = g_new (gint, height);
+
+  clahe_setup_axis (width, clahe->tiles_x, clahe->tile_x, clahe->col_offset0,
+      clahe->col_offset1, clahe->col_weight);
+  clahe_setup_axis (height, clahe->tiles_y, clahe->tile_y, clahe->row_tile0,
+      clahe->row_tile1, clahe->row_weight);
+
+  /* columns index into a row of tile tables */
+  for (x = 0; x < width; x++) {
+    clahe->col_offset0[x] *= clahe->nbins;
+    clahe->col_offset1[x] *= clahe->nbins;
+  }
+
+  n_tiles = clahe->tiles_x * clahe->tiles_y;
+  clahe->histograms = g_new (gint, n_tiles * clahe->nbins);
+  clahe->smoothed = g_new0 (gfloat, n_tiles * clahe->nbins);
+  clahe->luts = g_new (guint16, n_tiles * clahe->nbins);
+  clahe->have_history = FALSE;
+
+  return clahe;
+}
+
+void
+gst_videolevels_clahe_free (GstVideoLevelsClahe * clahe)
+{
+  if (!clahe)
+    return;
+
+  g_free (clahe->tile_x);
+  g_free (clahe->tile_y);
+  g_free (clahe->col_offset0);
+  g_free (clahe->col_offset1);
+  g_free (clahe->col_weight);
+  g_free (clahe->row_tile0);
+  g_free (clahe->row_tile1);
+  g_free (clahe->row_weight);
+  g_free (clahe->histograms);
+  g_free (clahe->smoothed);
+  g_free (clahe->luts);
+  g_free (clahe);
+}
+
+/* forget previous frames, so the next frame is equalized on its own */
+void
+gst_videolevels_clahe_reset (GstVideoLevelsClahe * clahe)
+{
+  clahe->have_history = FALSE;
+}
+
+static inline gint
+clahe_bin (const GstVideoLevelsClahe * clahe, const guint8 * row, gint c)
+{
+  guint16 v;
+
+  if (clahe->bpp_in <= 8)
+    return row[c];
+
+  v = ((const guint16 *) row)[c];
+  if (clahe->swap)
+    v = GUINT16_SWAP_LE_BE (v);
+
+  return MIN (v >> clahe->bin_shift, clahe->nbins - 1);
+}
+
+/* blend the new histogram into the running one and equalize it */
+static void
+clahe_build_lut (GstVideoLevelsClahe * clahe, gint tile)
+{
+  const gint nbins = clahe->nbins;
+  const gint *hist = clahe->histograms + tile * nbins;
+  gfloat *smoothed = clahe->smoothed + tile * nbins;
+  guint16 *lut = clahe->luts + tile * nbins;
+  const gfloat s = (gfloat) clahe->smoothing;
+  const gint low = clahe->lower_output;
+  const gint high = clahe->upper_output;
+  gfloat total = 0, limit = G_MAXFLOAT, redist = 0, sum = 0, scale;
+  gint b;
+
+  for (b = 0; b < nbins; b++) {
+    /* don't blend in whatever a reset left behind */
+    if (clahe->have_history)
+      smoothed[b] = s * smoothed[b] + (1.0f - s) * hist[b];
+    else
+      smoothed[b] = (gfloat) hist[b];
+    total += smoothed[b];
+  }
+
+  if (total <= 0) {
+    for (b = 0; b < nbins; b++)
+      lut[b] = (guint16) (low + (high - low) * b / MAX (nbins - 1, 1));
+    return;
+  }
+
+  /* clip tall bins and spread the excess evenly, limiting how much any one
+   * intensity can stretch the contrast */
+  if (clahe->clip_limit > 0) {
+    gfloat excess = 0;
+
+    limit = (gfloat) clahe->clip_limit * total / nbins;
+    for (b = 0; b < nbins; b++) {
+      if (smoothed[b] > limit)
+        excess += smoothed[b] - limit;
+    }
+    redist = excess / nbins;
+  }
+
+  scale = (high - low) / total;
+  for (b = 0; b < nbins; b++) {
+    sum += MIN (smoothed[b], limit) + redist;
+    lut[b] = (guint16) CLAMP (low + sum * scale + 0.5f, MIN (low, high),
+        MAX (low, high));
+  }
+}
+
+/* histogram and build the tables of a range of tile rows */
+static void
+clahe_tiles_stripe (gpointer user_data, guint stripe, guint n_stripes)
+{
+  GstVideoLevelsClahe *clahe = (GstVideoLevelsClahe *) user_data;
+  const gint nbins = clahe->nbins;
+  const gint step_x = clahe->subsample_x;
+  const gint step_y = clahe->subsample_y;
+  gint ty_start, ty_end, ty, tx, r, c;
+
+  gst_stripe_get_rows (stripe, n_stripes, clahe->tiles_y, &ty_start, &ty_end);
+  if (ty_start == ty_end)
+    return;
+
+  memset (clahe->histograms + ty_start * clahe->tiles_x * nbins, 0,
+      sizeof (gint) * (ty_end - ty_start) * clahe->tiles_x * nbins);
+
+  for (ty = ty_start; ty < ty_end; ty++) {
+    gint *hist_row = clahe->histograms + ty * clahe->tiles_x * nbins;
+
+    /* walk each pixel row across all tiles, keeping reads sequential */
+    for (r = clahe->tile_y[ty]; r < clahe->tile_y[ty + 1]; r += step_y) {
+      const guint8 *row = clahe->in_data + r * clahe->stride_in;
+      for (tx = 0; tx < clahe->tiles_x; tx++) {
+        gint *hist = hist_row + tx * nbins;
+        for (c = clahe->tile_x[tx]; c < clahe->tile_x[tx + 1]; c += step_x)
+          hist[clahe_bin (clahe, row, c)]++;
+      }
+    }
+
+    for (tx = 0; tx < clahe->tiles_x; tx++)
+      clahe_build_lut (clahe, ty * clahe->tiles_x + tx);
+  }
+}
+
+/* map a range of pixel rows through the blended tile tables */
+static void
+clahe_map_stripe (gpointer user_data, guint stripe, guint n_stripes)
+{
+  GstVideoLevelsClahe *clahe = (GstVideoLevelsClahe *) user_data;
+  const gint tile_row_size = clahe->tiles_x * clahe->nbins;
+  gint row_start, row_end, r, c;
+
+  gst_stripe_get_rows (stripe, n_stripes, clahe->height, &row_start,
+      &row_end);
+
+  for (r = row_start; r < row_end; r++) {
+    const guint8 *src = clahe->in_data + r * clahe->stride_in;
+    guint8 *dst = clahe->out_data + r * clahe->stride_out;
+    const guint16 *lut0 = clahe->luts + clahe->row_tile0[r] * tile_row_size;
+    const guint16 *lut1 = clahe->luts + clahe->row_tile1[r] * tile_row_size;
+    const guint32 wy = clahe->row_weight[r];
+
+    /* in place is fine, each pixel is read before it is written */
+    for (c = 0; c < clahe->width; c++) {
+      const gint bin = clahe_bin (clahe, src, c);
+      const gint o0 = clahe->col_offset0[c] + bin;
+      const gint o1 = clahe->col_offset1[c] + bin;
+      const guint32 wx = clahe->col_weight[c];
+      const guint32 top = lut0[o0] * (256 - wx) + lut0[o1] * wx;
+      const guint32 bottom = lut1[o0] * (256 - wx) + lut1[o1] * wx;
+      const guint32 v = (top * (256 - wy) + bottom * wy + 32768) >> 16;
+
+      if (clahe->bpp_out <= 8)
+        dst[c] = (guint8) v;
+      else if (clahe->swap_out)
+        ((guint16 *) dst)[c] = GUINT16_SWAP_LE_BE ((guint16) v);
+      else
+        ((guint16 *) dst)[c] = (guint16) v;
+    }
+  }
+}
+
+/**
+ * gst_videolevels_clahe_process:
+ * @clahe: #GstVideoLevelsClahe
+ * @pool: workers to split each pass between
+ * @in_data: input frame
+ * @stride_in: input row stride in bytes
+ * @out_data: output frame, may be the same as @in_data
+ * @stride_out: output row stride in bytes
+ *
+ * Update the tile histograms from a frame and equalize it.
+ */
+void
+gst_videolevels_clahe_process (GstVideoLevelsClahe * clahe,
+    GstStripePool * pool, const guint8 * in_data, gint stride_in,
+    guint8 * out_data, gint stride_out)
+{
+  clahe->in_data = in_data;
+  clahe->stride_in = stride_in;
+  clahe->out_data = out_data;
+  clahe->stride_out = stride_out;
+
+  gst_stripe_pool_run (pool, clahe_tiles_stripe, clahe);
+  clahe->have_history = TRUE;
+
+  gst_stripe_pool_run (pool, clahe_map_stripe, clahe);
+
+  clahe->in_data = NULL;
+  clahe->out_data = NULL;
+}
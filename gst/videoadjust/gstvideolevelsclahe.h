@@ -0,0 +1,110 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_VIDEO_LEVELS_CLAHE_H__
+#define __GST_VIDEO_LEVELS_CLAHE_H__
+
+#include <glib.h>
+
+#include "stripepool.h"
+
+G_BEGIN_DECLS
+
+/**
+* GstVideoLevelsClahe:
+* @width: frame width
+* @height: frame height
+* @bpp_in: significant bits of input pixels
+* @swap: whether 16-bit input words are byte swapped
+* @bpp_out: bits of output pixels, 8 or 16
+* @swap_out: whether 16-bit output words are byte swapped
+* @tiles_x: number of tile columns
+* @tiles_y: number of tile rows
+* @nbins: histogram bins per tile
+* @bin_shift: input values per bin, as a power of two
+* @clip_limit: maximum bin height as a multiple of the mean, 0 to disable
+* @smoothing: weight of the previous histograms when adding a new frame
+* @subsample_x: only sample every Nth column of each tile
+* @subsample_y: only sample every Nth row of each tile
+* @lower_output: output value of the darkest bin
+* @upper_output: output value of the brightest bin
+*
+* State of contrast limited adaptive histogram equalization. The frame is
+* divided into tiles, each with its own equalizing table, and every output
+* pixel is a bilinear blend of the tables of the four nearest tile centers.
+* Tile histograms persist between frames and are blended over time so the
+* mapping doesn't flicker.
+*/
+typedef struct {
+  gint width;
+  gint height;
+  gint bpp_in;
+  gboolean swap;
+  gint bpp_out;
+  gboolean swap_out;
+  gint tiles_x;
+  gint tiles_y;
+  gint nbins;
+  gint bin_shift;
+
+  gdouble clip_limit;
+  gdouble smoothing;
+  gint subsample_x;
+  gint subsample_y;
+  gint lower_output;
+  gint upper_output;
+
+  /*< private >*/
+  gint *tile_x;
+  gint *tile_y;
+
+  /* per column/row: offsets of the two nearest tiles and the 8-bit weight
+   * of the second */
+  gint *col_offset0;
+  gint *col_offset1;
+  gint *col_weight;
+  gint *row_tile0;
+  gint *row_tile1;
+  gint *row_weight;
+
+  gint *histograms;
+  gfloat *smoothed;
+  gboolean have_history;
+  guint16 *luts;
+
+  /* frame being processed */
+  const guint8 *in_data;
+  gint stride_in;
+  guint8 *out_data;
+  gint stride_out;
+} GstVideoLevelsClahe;
+
+GstVideoLevelsClahe *gst_videolevels_clahe_new (gint width, gint height,
+    gint bpp_in, gboolean swap, gint bpp_out, gboolean swap_out,
+    gint tiles_x, gint tiles_y);
+void gst_videolevels_clahe_free (GstVideoLevelsClahe * clahe);
+void gst_videolevels_clahe_reset (GstVideoLevelsClahe * clahe);
+void gst_videolevels_clahe_process (GstVideoLevelsClahe * clahe,
+    GstStripePool * pool, const guint8 * in_data, gint stride_in,
+    guint8 * out_data, gint stride_out);
+
+G_END_DECLS
+
+#endif /* __GST_VIDEO_LEVELS_CLAHE_H__ */
@@ -0,0 +1,87 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Histogram accumulation for videolevels, free of GStreamer types so that
+ * videolevelstest can check it against a reference.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstvideolevelshist.h"
+
+/**
+* gst_videolevels_histogram_rows:
+* @params: #GstVideoLevelsHistParams
+* @data: input frame data
+* @hist: histogram to accumulate into
+* @row_start: first row to process, rows above the ROI are skipped
+* @row_end: row after the last ROI row to process
+*
+* Accumulate histogram of the ROI columns within a range of rows, visiting
+* only the subsampling grid anchored at the ROI origin
+*/
+void
+gst_videolevels_histogram_rows (const GstVideoLevelsHistParams * params,
+    const guint8 * data, gint * hist, gint row_start, gint row_end)
+{
+  const gint max_bin = params->nbins - 1;
+  const gint shift = params->shift;
+  const gint step_x = params->step_x;
+  const gint step_y = params->step_y;
+  const gint stride = params->stride;
+  const gint c_start = params->x;
+  const gint c_end = params->x + params->width;
+  gint r, c, offset;
+
+  /* stripes may start above the ROI, keep the difference non-negative so
+   * the grid phase is right */
+  if (row_start < params->y)
+    row_start = params->y;
+  offset = (row_start - params->y) % step_y;
+  if (offset > 0)
+    row_start += step_y - offset;
+
+  if (params->sixteen) {
+    if (params->swap) {
+      for (r = row_start; r < row_end; r += step_y) {
+        const guint16 *row = (const guint16 *) (data + r * stride);
+        for (c = c_start; c < c_end; c += step_x) {
+          hist[MIN (GUINT16_SWAP_LE_BE (row[c]) >> shift, max_bin)]++;
+        }
+      }
+    } else {
+      for (r = row_start; r < row_end; r += step_y) {
+        const guint16 *row = (const guint16 *) (data + r * stride);
+        for (c = c_start; c < c_end; c += step_x) {
+          hist[MIN (row[c] >> shift, max_bin)]++;
+        }
+      }
+    }
+  } else {
+    for (r = row_start; r < row_end; r += step_y) {
+      const guint8 *row = data + r * stride;
+      for (c = c_start; c < c_end; c += step_x) {
+        hist[MIN (row[c] >> shift, max_bin)]++;
+      }
+    }
+  }
+}
@@ -0,0 +1,61 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_VIDEO_LEVELS_HIST_H__
+#define __GST_VIDEO_LEVELS_HIST_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+* GstVideoLevelsHistParams:
+* @stride: bytes between input rows
+* @sixteen: whether pixels are 16-bit words rather than bytes
+* @swap: whether 16-bit pixels are in the opposite of native byte order
+* @shift: right shift from a pixel to its bin
+* @nbins: number of bins, larger pixels going in the last one
+* @x: first ROI column
+* @width: number of ROI columns
+* @y: first ROI row, which the row subsampling grid is anchored at
+* @step_x: distance between sampled columns
+* @step_y: distance between sampled rows
+*
+* Which pixels of a frame are counted and how they are binned.
+*/
+typedef struct {
+  gint stride;
+  gboolean sixteen;
+  gboolean swap;
+  gint shift;
+  gint nbins;
+  gint x;
+  gint width;
+  gint y;
+  gint step_x;
+  gint step_y;
+} GstVideoLevelsHistParams;
+
+void gst_videolevels_histogram_rows (const GstVideoLevelsHistParams * params,
+    const guint8 * data, gint * hist, gint row_start, gint row_end);
+
+G_END_DECLS
+
+#endif /* __GST_VIDEO_LEVELS_HIST_H__ */
@@ -0,0 +1,117 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Lookup table construction for videolevels, free of GStreamer types so
+ * that videolevelssimdtest can check the linear kernels against the table.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+
+#include "gstvideolevelslut.h"
+
+#define GUINT8_CLAMP(x, low, high) ((guint8)(CLAMP((x),(low),(high))))
+#define GUINT16_CLAMP(x, low, high) ((guint16)(CLAMP((x),(low),(high))))
+
+void
+gst_videolevels_lut_free (GstVideoLevelsLut * lut)
+{
+  if (!lut)
+    return;
+
+  g_free (lut->table);
+  g_free (lut);
+}
+
+/**
+ * gst_videolevels_lut_build:
+ * @lut: #GstVideoLevelsLut
+ * @level: instruction set to pick the linear kernel for
+ *
+ * Fill in the lookup table. Only the 2^bpp_in valid input values are
+ * computed, anything above saturates like the maximum input value.
+ */
+void
+gst_videolevels_lut_build (GstVideoLevelsLut * lut, GstSimdLevel level)
+{
+  gint i;
+  gdouble m;
+  gdouble b;
+  const gint max_in = (1 << lut->bpp_in) - 1;
+  const guint16 low_in = lut->lower_input;
+  const guint16 high_in = lut->upper_input;
+  const guint16 low_out = lut->lower_output;
+  const guint16 high_out = lut->upper_output;
+
+  if (low_in == high_in)
+    m = 0.0;
+  else
+    m = (high_out - low_out) / (gdouble) (high_in - low_in);
+
+  b = low_out - m * low_in;
+
+  if (lut->bpp_out > 8) {
+    guint16 *table = lut->table = g_new (guint16, G_MAXUINT16 + 1);
+    guint16 max_val = GUINT16_CLAMP (m * max_in + b, low_out, high_out);
+
+    /* store values in output byte order, so swapping output is free */
+    if (lut->swap_out)
+      max_val = GUINT16_SWAP_LE_BE (max_val);
+
+    for (i = 0; i <= G_MAXUINT16; i++)
+      table[i] = max_val;
+    for (i = 0; i <= max_in; i++) {
+      guint16 val = GUINT16_CLAMP (m * i + b, low_out, high_out);
+      if (lut->swap_out)
+        val = GUINT16_SWAP_LE_BE (val);
+      table[lut->swap ? GUINT16_SWAP_LE_BE (i) : i] = val;
+    }
+  } else {
+    guint8 *table = lut->table = g_new (guint8, G_MAXUINT16 + 1);
+    guint8 max_val = GUINT8_CLAMP (m * max_in + b, low_out, high_out);
+
+    if (lut->swap) {
+      /* valid values are scattered over the table */
+      memset (table, max_val, G_MAXUINT16 + 1);
+      for (i = 0; i <= max_in; i++)
+        table[GUINT16_SWAP_LE_BE (i)] = GUINT8_CLAMP (m * i + b, low_out,
+            high_out);
+    } else {
+      for (i = 0; i <= max_in; i++)
+        table[i] = GUINT8_CLAMP (m * i + b, low_out, high_out);
+      memset (table + max_in + 1, max_val, G_MAXUINT16 - max_in);
+    }
+  }
+
+  /* the table is linear, so for 16-bit input compute it on the fly in SIMD
+   * lanes rather than thrashing the cache with a 64K-entry table */
+  lut->linear.m = m;
+  lut->linear.b = b;
+  lut->linear.low = low_out;
+  lut->linear.high = high_out;
+
+
+  lut->linear_func = NULL;
+  if (lut->bpp_in > 8 && lut->bpp_out == 8)
+    lut->linear_func = gst_videolevels_simd_get_linear_func (level, lut->swap);
+}
@@ -0,0 +1,71 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_VIDEO_LEVELS_LUT_H__
+#define __GST_VIDEO_LEVELS_LUT_H__
+
+#include <glib.h>
+
+#include "gstvideolevelssimd.h"
+
+G_BEGIN_DECLS
+
+/**
+* GstVideoLevelsLut:
+* @generation: order in which tables were requested, newer replaces older
+* @bpp_in: input bit depth the table was built for
+* @swap: whether input words are byte swapped
+* @bpp_out: output bit depth, 8 or 16
+* @swap_out: whether output words are byte swapped
+* @table: lookup table indexed by raw input words, with guint8 entries for
+*   8-bit output and guint16 entries already in output byte order otherwise
+* @linear: arithmetic equivalent of @table
+* @linear_func: kernel applying @linear, NULL if @table must be used
+* @auto_levels: the input levels came from async analysis, and become the
+*   element's levels when the streaming thread switches to this table
+*
+* A lookup table and its parameters. Tables are immutable once built, so the
+* streaming thread can swap to a new one between frames without locking.
+*/
+typedef struct {
+  gint generation;
+  gint bpp_in;
+  gboolean swap;
+  gint bpp_out;
+  gboolean swap_out;
+
+  gint lower_input;
+  gint upper_input;
+  gint lower_output;
+  gint upper_output;
+
+  gpointer table;
+  GstVideoLevelsLinear linear;
+  GstVideoLevelsLinearFunc linear_func;
+
+  gboolean auto_levels;
+} GstVideoLevelsLut;
+
+void gst_videolevels_lut_build (GstVideoLevelsLut * lut, GstSimdLevel level);
+void gst_videolevels_lut_free (GstVideoLevelsLut * lut);
+
+G_END_DECLS
+
+#endif /* __GST_VIDEO_LEVELS_LUT_H__ */
@@ -0,0 +1,186 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Vectorized kernels for videolevels.
+ *
+ * The lookup table holds CLAMP (m * x + b, low, high) truncated to an
+ * integer, computed in double precision. To stay bit-exact the kernels below
+ * evaluate the same expression in double precision lanes, with a separate
+ * multiply and add (no FMA) and the same clamp ordering as the CLAMP macro,
+ * so that inverted output levels (low > high) behave identically.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gstvideolevelssimd.h"
+
+static inline guint8
+linear_scalar (guint16 x, const GstVideoLevelsLinear * lin)
+{
+  return (guint8) CLAMP (lin->m * x + lin->b, lin->low, lin->high);
+}
+
+#ifdef HAVE_X86_SIMD
+
+/* SSE4.1: 8 pixels per iteration, 2 double lanes per register */
+
+static inline TARGET_SSE41 __m128i
+linear_sse41_2 (__m128i x, __m128d m, __m128d b, __m128d low, __m128d high)
+{
+  __m128d v = _mm_add_pd (_mm_mul_pd (_mm_cvtepi32_pd (x), m), b);
+  __m128d r = _mm_max_pd (v, low);
+  r = _mm_blendv_pd (r, high, _mm_cmpgt_pd (v, high));
+  return _mm_cvttpd_epi32 (r);
+}
+
+static inline TARGET_SSE41 void
+linear_sse41 (guint8 * dst, const guint16 * src, gint n,
+    const GstVideoLevelsLinear * lin, gboolean swap)
+{
+  const __m128d m = _mm_set1_pd (lin->m);
+  const __m128d b = _mm_set1_pd (lin->b);
+  const __m128d low = _mm_set1_pd (lin->low);
+  const __m128d high = _mm_set1_pd (lin->high);
+  gint i;
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i x = _mm_loadu_si128 ((const __m128i *) (src + i));
+    __m128i x0, x1, r0, r1, r2, r3;
+
+    if (swap)
+      x = _mm_or_si128 (_mm_slli_epi16 (x, 8), _mm_srli_epi16 (x, 8));
+
+    x0 = _mm_cvtepu16_epi32 (x);
+    x1 = _mm_cvtepu16_epi32 (_mm_srli_si128 (x, 8));
+
+    r0 = linear_sse41_2 (x0, m, b, low, high);
+    r1 = linear_sse41_2 (_mm_srli_si128 (x0, 8), m, b, low, high);
+    r2 = linear_sse41_2 (x1, m, b, low, high);
+    r3 = linear_sse41_2 (_mm_srli_si128 (x1, 8), m, b, low, high);
+
+    r0 = _mm_packs_epi32 (_mm_unpacklo_epi64 (r0, r1),
+        _mm_unpacklo_epi64 (r2, r3));
+    _mm_storel_epi64 ((__m128i *) (dst + i), _mm_packus_epi16 (r0, r0));
+  }
+
+  for (; i < n; i++)
+    dst[i] = linear_scalar (swap ? GUINT16_SWAP_LE_BE (src[i]) : src[i], lin);
+}
+
+static TARGET_SSE41 void
+linear_sse41_native (guint8 * dst, const guint16 * src, gint n,
+    const GstVideoLevelsLinear * lin)
+{
+  linear_sse41 (dst, src, n, lin, FALSE);
+}
+
+static TARGET_SSE41 void
+linear_sse41_swap (guint8 * dst, const guint16 * src, gint n,
+    const GstVideoLevelsLinear * lin)
+{
+  linear_sse41 (dst, src, n, lin, TRUE);
+}
+
+/* AVX2: 16 pixels per iteration, 4 double lanes per register */
+
+static inline TARGET_AVX2 __m128i
+linear_avx2_4 (__m128i x, __m256d m, __m256d b, __m256d low, __m256d high)
+{
+  __m256d v = _mm256_add_pd (_mm256_mul_pd (_mm256_cvtepi32_pd (x), m), b);
+  __m256d r = _mm256_max_pd (v, low);
+  r = _mm256_blendv_pd (r, high, _mm256_cmp_pd (v, high, _CMP_GT_OQ));
+  return _mm256_cvttpd_epi32 (r);
+}
+
+static inline TARGET_AVX2 void
+linear_avx2 (guint8 * dst, const guint16 * src, gint n,
+    const GstVideoLevelsLinear * lin, gboolean swap)
+{
+  const __m256d m = _mm256_set1_pd (lin->m);
+  const __m256d b = _mm256_set1_pd (lin->b);
+  const __m256d low = _mm256_set1_pd (lin->low);
+  const __m256d high = _mm256_set1_pd (lin->high);
+  gint i;
+
+  for (i = 0; i + 16 <= n; i += 16) {
+    __m256i x = _mm256_loadu_si256 ((const __m256i *) (src + i));
+    __m128i lo, hi, r0, r1, r2, r3;
+
+    if (swap)
+      x = _mm256_or_si256 (_mm256_slli_epi16 (x, 8), _mm256_srli_epi16 (x, 8));
+
+    lo = _mm256_castsi256_si128 (x);
+    hi = _mm256_extracti128_si256 (x, 1);
+
+    r0 = linear_avx2_4 (_mm_cvtepu16_epi32 (lo), m, b, low, high);
+    r1 = linear_avx2_4 (_mm_cvtepu16_epi32 (_mm_srli_si128 (lo, 8)), m, b,
+        low, high);
+    r2 = linear_avx2_4 (_mm_cvtepu16_epi32 (hi), m, b, low, high);
+    r3 = linear_avx2_4 (_mm_cvtepu16_epi32 (_mm_srli_si128 (hi, 8)), m, b,
+        low, high);
+
+    _mm_storeu_si128 ((__m128i *) (dst + i),
+        _mm_packus_epi16 (_mm_packs_epi32 (r0, r1), _mm_packs_epi32 (r2, r3)));
+  }
+
+  for (; i < n; i++)
+    dst[i] = linear_scalar (swap ? GUINT16_SWAP_LE_BE (src[i]) : src[i], lin);
+}
+
+static TARGET_AVX2 void
+linear_avx2_native (guint8 * dst, const guint16 * src, gint n,
+    const GstVideoLevelsLinear * lin)
+{
+  linear_avx2 (dst, src, n, lin, FALSE);
+}
+
+static TARGET_AVX2 void
+linear_avx2_swap (guint8 * dst, const guint16 * src, gint n,
+    const GstVideoLevelsLinear * lin)
+{
+  linear_avx2 (dst, src, n, lin, TRUE);
+}
+
+#endif /* HAVE_X86_SIMD */
+
+/**
+ * gst_videolevels_simd_get_linear_func:
+ * @level: instruction set, at most gst_simd_get_level()
+ * @swap: whether input words need to be byte swapped
+ *
+ * Returns: the linear 16-bit to 8-bit kernel for @level, or %NULL if there is
+ * none and the lookup table should be used instead
+ */
+GstVideoLevelsLinearFunc
+gst_videolevels_simd_get_linear_func (GstSimdLevel level, gboolean swap)
+{
+  switch (level) {
+#ifdef HAVE_X86_SIMD
+    case GST_SIMD_AVX2:
+      return swap ? linear_avx2_swap : linear_avx2_native;
+    case GST_SIMD_SSE41:
+      return swap ? linear_sse41_swap : linear_sse41_native;
+#endif
+    default:
+      return NULL;
+  }
+}
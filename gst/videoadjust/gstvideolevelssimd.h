@@ -0,0 +1,65 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef __GST_VIDEO_LEVELS_SIMD_H__
+#define __GST_VIDEO_LEVELS_SIMD_H__
+
+#include <glib.h>
+
+#include "simdlevel.h"
+
+G_BEGIN_DECLS
+
+/**
+* GstVideoLevelsLinear:
+* @m: slope of the mapping
+* @b: intercept of the mapping
+* @low: lower output clamp
+* @high: upper output clamp
+*
+* Parameters of the linear mapping CLAMP (m * x + b, low, high), which is
+* exactly what gst_videolevels_calculate_lut stores in the lookup table.
+*/
+typedef struct {
+  gdouble m;
+  gdouble b;
+  gdouble low;
+  gdouble high;
+} GstVideoLevelsLinear;
+
+/**
+* GstVideoLevelsLinearFunc:
+* @dst: output row
+* @src: input row of native 16-bit words
+* @n: number of pixels
+* @lin: mapping parameters
+*
+* Apply a linear mapping to a row of 16-bit pixels, writing 8-bit pixels.
+* The output is bit-exact with the equivalent lookup table.
+*/
+typedef void (*GstVideoLevelsLinearFunc) (guint8 * dst, const guint16 * src,
+    gint n, const GstVideoLevelsLinear * lin);
+
+GstVideoLevelsLinearFunc gst_videolevels_simd_get_linear_func (
+    GstSimdLevel level, gboolean swap);
+
+G_END_DECLS
+
+#endif /* __GST_VIDEO_LEVELS_SIMD_H__ */
@@ -0,0 +1,177 @@
+/* GStreamer
+ * Copyright (C) 2026 United States Government, Joshua M. Doe <oss@nvl.army.mil>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Bit-exactness test for the videolevels linear kernels.
+ *
+ * Builds lookup tables for every input depth and byte order over a range of
+ * levels, including inverted and collapsed ones, and runs the linear kernel
+ * of every instruction set the CPU supports on random rows of many widths,
+ * aligned and unaligned. The output must match the table lookup the element
+ * falls back to, for out of range inputs too, and the bytes past the end of
+ * the row must be left untouched. Returns nonzero on any mismatch.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "gstvideolevelslut.h"
+
+/* widths around every vector size, so each tail length is covered */
+static const gint widths[] = {
+  0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 131
+};
+
+static const gint depths[] = { 9, 10, 12, 14, 16 };
+
+#define MAX_WIDTH 131
+/* pixels past the widest row, left untouched by every kernel */
+#define GUARD 16
+#define GUARD_BYTE 0xa5
+/* random levels per depth, on top of the fixed ones */
+#define N_RANDOM_LEVELS 8
+
+typedef struct
+{
+  GstSimdLevel level;
+  gint failures;
+} Check;
+
+static void
+test_lut (Check * check, GstVideoLevelsLut * lut, const guint16 * src)
+{
+  const guint8 *table;
+  guint8 expected[MAX_WIDTH + GUARD], actual[MAX_WIDTH + GUARD];
+  guint i;
+  gint j;
+
+  gst_videolevels_lut_build (lut, check->level);
+  table = lut->table;
+
+  for (i = 0; i < G_N_ELEMENTS (widths); i++) {
+    gint misalign;
+
+    for (misalign = 0; misalign < 2; misalign++) {
+      const guint16 *row = src + misalign;
+
+      memset (expected, GUARD_BYTE, sizeof (expected));
+      memset (actual, GUARD_BYTE, sizeof (actual));
+      for (j = 0; j < widths[i]; j++)
+        expected[j] = table[row[j]];
+      lut->linear_func (actual, row, widths[i], &lut->linear);
+
+      if (memcmp (expected, actual, sizeof (expected)) != 0) {
+        fprintf (stderr, "%s: mismatch for %d-bit%s input, levels "
+            "%d-%d to %d-%d, at width %d, misaligned by %d\n",
+            gst_simd_get_name (check->level), lut->bpp_in,
+            lut->swap ? " swapped" : "", lut->lower_input, lut->upper_input,
+            lut->lower_output, lut->upper_output, widths[i], misalign);
+        check->failures++;
+      }
+    }
+  }
+
+  g_free (lut->table);
+  lut->table = NULL;
+}
+
+static void
+test_levels (Check * check, GRand * rand, gint bpp_in, gboolean swap)
+{
+  const gint max_in = (1 << bpp_in) - 1;
+  /* lower/upper input and output: full range, a narrow window, inverted
+   * input and output, and collapsed input and output */
+  const gint fixed[][4] = {
+    {0, max_in, 0, 255},
+    {max_in / 4, max_in - max_in / 4, 16, 235},
+    {max_in, 0, 0, 255},
+    {0, max_in, 255, 0},
+    {max_in / 2, max_in / 2, 0, 255},
+    {0, max_in, 128, 128},
+  };
+  GstVideoLevelsLut lut;
+  guint16 src[MAX_WIDTH + 1];
+  guint i;
+
+  /* one spare pixel to misalign by; mostly valid inputs in the input byte
+   * order, with the largest words at the start and some random words that
+   * are out of range for all but 16-bit input */
+  for (i = 0; i < G_N_ELEMENTS (src); i++) {
+    if (i < 2)
+      src[i] = G_MAXUINT16 - i;
+    else if (g_rand_int_range (rand, 0, 4) == 0)
+      src[i] = g_rand_int (rand);
+    else
+      src[i] = g_rand_int_range (rand, 0, max_in + 1);
+    if (swap && i >= 2)
+      src[i] = GUINT16_SWAP_LE_BE (src[i]);
+  }
+
+  memset (&lut, 0, sizeof (lut));
+  lut.bpp_in = bpp_in;
+  lut.swap = swap;
+  lut.bpp_out = 8;
+
+  for (i = 0; i < G_N_ELEMENTS (fixed) + N_RANDOM_LEVELS; i++) {
+    if (i < G_N_ELEMENTS (fixed)) {
+      lut.lower_input = fixed[i][0];
+      lut.upper_input = fixed[i][1];
+      lut.lower_output = fixed[i][2];
+      lut.upper_output = fixed[i][3];
+    } else {
+      lut.lower_input = g_rand_int_range (rand, 0, max_in + 1);
+      lut.upper_input = g_rand_int_range (rand, 0, max_in + 1);
+      lut.lower_output = g_rand_int_range (rand, 0, 256);
+      lut.upper_output = g_rand_int_range (rand, 0, 256);
+    }
+    test_lut (check, &lut, src);
+  }
+}
+
+int
+main (int argc, char **argv)
+{
+  GstSimdLevel detected;
+  Check check;
+  GRand *rand;
+  gint failures = 0;
+  guint i;
+
+  rand = g_rand_new_with_seed (0);
+  detected = gst_simd_get_level ();
+  for (check.level = GST_SIMD_SSSE3; check.level <= detected; check.level++) {
+    gint swap;
+
+    /* levels without a kernel use the table itself */
+    if (!gst_videolevels_simd_get_linear_func (check.level, FALSE))
+      continue;
+
+    check.failures = 0;
+    for (i = 0; i < G_N_ELEMENTS (depths); i++)
+      for (swap = 0; swap < 2; swap++)
+        test_levels (&check, rand, depths[i], swap);
+    printf ("%-6s %d mismatches\n", gst_simd_get_name (check.level),
+        check.failures);
+    failures += check.failures;
+  }
+
+  g_rand_free (rand);
+
+  return failures > 0;
+}